@@ -10,6 +10,11 @@
 //   methods (a typo error which causes the lower bound to print "infinite"
 //   when the upper bound is).
 
+// Oct 2026: off_t of 64 bits for ftello, fseeko (see FTELL64)
+#ifndef _WIN32
+#define _FILE_OFFSET_BITS	64
+#define _POSIX_C_SOURCE	200809L
+#endif
 #include <time.h>
 
 #include <stdio.h>
@@ -17,6 +22,35 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <math.h>
+#include <sys/stat.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+// Oct 2026: server mode listens on a Unix socket (see RunSocket)
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <signal.h>
+#endif
+#include "ne2.h"
+// Oct 2026: positions in files that may pass 2 GB (store of locus pair
+// statistics), where long has 32 bits, as on Windows
+#ifdef _WIN32
+#define FTELL64(f)			_ftelli64 (f)
+#define FSEEK64(f, pos, w)	_fseeki64 (f, pos, w)
+#else
+#define FTELL64(f)			ftello (f)
+#define FSEEK64(f, pos, w)	fseeko (f, pos, w)
+#endif
+// Oct 2026: time of modification of a file (struct stat st) in nanoseconds,
+// to 1 second on Windows, see DataOpen
+#ifdef _WIN32
+#define MTIMENS(st)	((long long) (st).st_mtime * 1000000000LL)
+#else
+#define MTIMENS(st)	((long long) (st).st_mtim.tv_sec * 1000000000LL \
+					+ (st).st_mtim.tv_nsec)
+#endif
 
 //#define INFINITE	(float) 9999999
 //#define EPSILON		(float) 0.0000001	// used to compare a number with zero
@@ -60,6 +94,9 @@
 // especially the latter one, so we limit them:
 #define MAXLOCPOP	50	// maximum populations to output in Locus Data file
 #define MAXBURRPOP	50	// maximum populations to output in Burrows coef. file
+// Oct 2026: buffer size of those files; they are flushed once for each
+// population (see PopPrint), not at each line.
+#define OUTBUF		1048576
 
 // These are for reading strings
 #define WHITESPACE  " \t\f\r\v\n"	// when skipping chars using WHITESPACE
@@ -108,6 +145,24 @@
 
 #define USETMP		1	// set = 1 to use temporary files when possible (At LD)
 						// set = 0 then use arrays instead
+#define LDWINPAIR	1000000	// LD on chromosomes, with more than one thread:
+							// max locus pairs held before adding to totals
+#define LDWINJACK	8000000	// same, times number of samples, for jackknife
+#define LDTASKDIV	8		// tasks per thread for each LDWINPAIR pairs
+#define LDDUPJACK	8000000	// LD on identical loci: max groups times samples
+#define LDTILEMEM	262144	// LD on all pairs: bytes of genotypes in a tile
+#define LDTILEMIN	4		// fewest rows of a band of tiles
+							// of results kept for jackknife, see LocusDup
+#define LDPROGPAIR	65536	// locus pairs between checks for progress
+#define LDSAMPZ		1.96	// LD on a sample of locus pairs: for 95% CI
+#define LDANYPAIR	10000	// LD in anytime mode: pairs between estimates
+#define LDCOSTPAIR	256		// dry run: locus pairs timed at each crit. value
+#define R2BLOCKPAIR	4096	// locus pairs in a block of the r^2 store
+#define R2NCOL		10		// columns in a block of the r^2 store
+#define R2MAGIC		"NE2XR2v1"	// 8 chars at both ends of the r^2 store
+#define LENJOB		2000	// server mode: max chars in a line of job
+#define MAXJOBARG	8		// server mode: max arguments in a job
+#define DATACACHEMB	512		// server mode: max MB of parsed inputs kept
 
 
 // for Nomura's method:
@@ -145,8 +200,21 @@ struct chromosome
 	char name [LEN_LOCUS];	// name of the chromosome
 	int nloci;		// number of loci in the chromosome
 	int *locus;		// loci in the chromosome: for i = 0, ..., (nloci-1),
-};					// with p = locus[i], then the chromosome contains the
+					// with p = locus[i], then the chromosome contains the
 					// (p+1)th locus read in the input file
+// Oct 2026: positions (base pairs) of the loci, NULL if not all given; loci
+// are then in the order of positions. With a distance window (argument
+// "w:"), locus i is paired (within the chromosome) only with loci
+// pairLo[i], ..., (pairHi[i]-1), see ChromoWindow; NULL if no window.
+	long *pos;
+	int *pairLo, *pairHi;
+};
+// Oct 2026: a locus and its position, for sorting loci by positions
+struct locpos
+{
+	long pos;
+	int locus;
+};
 // -------------------------------------------------------------------------
 
 
@@ -194,13 +262,464 @@ struct molecoef
 };
 
 // This is for temporal method
+// Oct 2026: one node per locus instead of one per allele, frequencies
+// of all alleles at the locus are in one dense array, allele by allele,
+// so the frequencies of an allele in all generations are contiguous.
+// This is only part of a dense loci x alleles x generations array swept
+// once for all pairs of generations: pairs are still evaluated one by one
+// (TemporalNeEst, concurrently in TempCompute). A single sweep would hold
+// the per-locus arrays of every pair at once, as the jackknife over loci
+// needs them whole, i.e. nloci floats of each kind for each pair.
 typedef struct timefreq *FREQPTR;
 struct timefreq
 {
-    int mValue;				// Allele mobility value
+    int nAlle;				// number of alleles, across generations
+    int maxAlle;			// number of alleles the arrays can hold
+    int nGen;				// number of generations
+    int *mValue;			// Allele mobility values, in ascending order
     int *samples;			// number of samples, in different generations
-    float *freqs;			// freq. of alleles, in different generations
-    FREQPTR next;
+    float *freqs;			// freqs[i*nGen + g] = freq. of allele mValue[i]
+							// in generation g
+};
+
+// Oct 2026: per-locus work arrays of TemporalNeEst, one set per worker,
+// so that they are allocated once instead of at every pair of generations
+typedef struct tempscr *TEMPSCR;
+struct tempscr
+{
+	float *hLoc, *indAlle, *nAlle, *invhmonic, *invcount2;
+	float *fk, *fkprime, *nkLoc;
+	float *fc, *fcprime, *ncLoc;
+	float *fs, *fsprime, *topFs, *bottomFs, *nsLoc;
+	float *nkMean, *ncMean, *nsMean;	// these 3 have nCrit entries
+};
+
+// Oct 2026: results of temporal method for one pair of generations,
+// for all critical values, so that pairs can be estimated concurrently,
+// then printed in order.
+typedef struct tempres *TEMPRES;
+struct tempres
+{
+	int g1, g2;				// the pair of generations
+	FILE *outTmp;			// locus data of the pair, to go to outLoc
+	long *nTotAlle, *nIndAlle;
+	float *Hkmean, *Hcmean, *Hsmean;
+	float *fkmean, *fcmean, *fsmean;
+	float *fkprimeMean, *fcprimeMean, *fsprimeAll;
+	float *NeTempk, *NeTempc, *NeTemps;
+	float *loNek, *hiNek, *loNec, *hiNec, *loNes, *hiNes;
+	float *jloNek, *jhiNek, *jloNec, *jhiNec, *jloNes, *jhiNes;
+};
+
+// Oct 2026: for scheduling LD method on chromosomes. A task is a block of
+// rows (first locus k1) of chromosome m, paired with later loci in m
+// (n = m), or with loci in chromosome n. It is weighted by its locus pairs.
+typedef struct ldtask *LDTASK;
+struct ldtask
+{
+	int m, n;				// chromosomes, n = m for pairs within m
+	int k1Lo, k1Hi;			// rows k1Lo, ..., (k1Hi-1) of chromosome m
+	unsigned long long nPair;	// number of locus pairs in the task
+	unsigned long long first;	// serial order of its first locus pair
+};
+
+// Oct 2026: outputs of Burrows_Calcul at a locus pair, kept until pairs
+// are added to the totals in serial order
+struct ldpair
+{
+	int p1, p2;
+	int m, n;		// chromosomes of p1, p2 in chromoList
+	int nInd1, nInd2, nMpairs;
+	float nSamp, rB, expR2;
+};
+
+// Oct 2026: a stratum of locus pairs to be sampled (see LDSampPairs):
+// pairs of loci in loc1 (n2 = 0, pairs within), or a locus in loc1 and
+// one in loc2, of chromosomes m, n in chromoList (-1 if no chromosomes).
+// Sums of weights w and of r^2-drift d at pairs drawn are for the
+// sampling error.
+struct ldstra
+{
+	int m, n;
+	int *loc1, *loc2;
+	int n1, n2;
+	unsigned long long total, nDraw;	// pairs in stratum, pairs drawn
+	unsigned long long first;			// pairs in strata before it
+	double sw, swd, sww, swwd, swwdd;	// sums of w, wd, w^2, w^2d, w^2d^2
+	// pairs within, in a distance window: row a from pair rowFirst[a], with
+	// loc1[rowLo[a]], ...; NULL if all pairs (a, b), a < b, are taken
+	unsigned long long *rowFirst;
+	int *rowLo;
+};
+
+// Oct 2026: work arrays of Burrows_Calcul, one set per worker
+typedef struct ldscr *LDSCR;
+struct ldscr
+{
+	int **p1Gen, **p2Gen;
+	int *noDatFish, *mValp1, *mValp2;
+	char *countm1, *countm2;
+	float *freqp1, *homop1, *freqp2, *homop2;
+	float *r2AtPairX, *JweighPair;
+	unsigned long long *r2Count;	// to be added to the caller's r2Count
+};
+
+// Oct 2026: progress of LD method on locus pairs of one population at one
+// critical value, written as lines in JSON format to the progress file
+// (argument "p:" on the command line), see LDProgress; out is NULL if there
+// is none. Console text of the loops goes to con.
+typedef struct ldprog *LDPROG;
+struct ldprog
+{
+	FILE *out;
+	FILE *con;					// stdout, or see PopWindow
+	int icount, popRead;
+	float cutoff;
+	unsigned long long total;	// locus pairs to go over
+	time_t start, last;			// when started, last written
+};
+
+// Oct 2026: genotypes of an input file as parsed by GetSample, and names
+// of populations as read by DatPopID or GenPopID, kept by the server so
+// that later jobs on the unchanged file take them from memory (see
+// DataOpen). Genotypes of loci not used are not parsed, so the loci used
+// are a part of the key, as are the number of loci, digits, format and the
+// position of the first population (after the locus names).
+typedef struct dataset *DATASET;
+struct dataset
+{
+	char *name;				// input file, without folder
+	long long dev, ino;		// identify the file (ino = 0 on Windows)
+	long long mtime, size;	// time of modification (see MTIMENS), bytes
+	long start;				// position of the first population
+	int nloci, lenM;
+	char format;
+	char *locUse;			// nloci
+	int nNext, maxNext;		// calls of DatPopID or GenPopID
+	signed char *next;		// returned by each call
+	int nPop, maxPop;
+	char **popID;			// names of populations, for next = 1
+	int nSamp, maxSamp;
+	int *geno;				// 2*nloci for each sample, as in sampData
+	int *err;				// for each sample, returned by GetSample,
+							// currErr and firstErr
+	char *genErr;			// GENLEN for each sample
+	size_t bytes;			// memory taken
+	unsigned long long used;	// job that last read it
+	char stale;				// 1 if the file changed, freed by DataTrim
+	DATASET link;
+};
+
+// Oct 2026: parsed input files kept by the server (see RunServer)
+typedef struct datacache *DATACACHE;
+struct datacache
+{
+	DATASET head;
+	size_t bytes;			// memory taken by all of them
+	unsigned long long job;	// current job
+	int nKept, nRead;		// input files of the job taken from memory,
+							// or read from file
+};
+
+// Oct 2026: reading of an input file by RunPop0, from the genotypes kept
+// (replay = 1), or from the file while they are recorded (replay = 0);
+// set is NULL when they are not kept (see DataSample).
+typedef struct dataread *DATAREAD;
+struct dataread
+{
+	DATACACHE cache;
+	DATASET set;
+	char replay;
+	int atNext, atPop, atSamp;	// next to be read from set
+};
+
+// Oct 2026: options of LD method for all inputs, given on the command line
+// (arguments "l:", "a:", see LDSampPairs; "w:", see ChromoWindow; "h:",
+// see LDShardWrite; "e:", see PopCost; "k:", see LDCacheWrite; "v:", "x:",
+// see PairStatBegin).
+typedef struct ldopt *LDOPT;
+struct ldopt
+{
+	unsigned long long nSample;	// locus pairs to sample, 0 for all pairs
+	unsigned long long seed;	// for random sampling of locus pairs
+	char anytime;				// 1 for running estimates, pairs in random order
+	float tol;					// anytime: stop when precise, 0 to go over all
+	unsigned long long every;	// anytime: locus pairs between estimates
+	long minDist, maxDist;		// distance window of pairs within chromosomes
+	int shard, nShard;			// shard of nShard (0 to merge), nShard = 0
+								// if not run in shards
+	char *shardName;			// partial-result files shardName.1, ...
+	char *cacheName;			// result cache of LD method, NULL if none
+	char dryRun;				// 1 to predict the cost only, nothing run
+	char *statName;				// store of locus pair statistics, or NULL
+	char statEval;				// 1 to evaluate from them, 0 to keep them
+	int nPopRun;				// populations of an input estimated at a
+								// time, 0 for as many as threads ("b:")
+	DATACACHE data;				// parsed inputs kept by the server, or NULL
+};
+
+// Oct 2026: sums of LD method over the locus pairs of a shard, written to
+// its partial-result file, or added up over all shards to be merged; or
+// over all locus pairs, kept in the result cache.
+// Reweighting for missing data (see NeAdjustedBin) needs sums by the
+// number s of samples having data at pairs, s = 0, ..., nfish: of the
+// products w of ind. alleles, of w*r^2 and of w*(r^2-drift).
+typedef struct ldpart *LDPART;
+struct ldpart
+{
+	int nfish;
+	char given;		// 1 if sums are given (shards merged, or from the cache)
+	unsigned long long nLocPairs, npairTot, nPairPtr;
+	long npairSkip;
+	double totInd, wMeanSamp, rWeight, bigExpR2, bigRprime, bigR;
+	unsigned long long *r2Count;		// jackknife on samples, nfish each
+	double *r2WRemSmp, *JweightTot;
+	double *binW, *binR2, *binDrift;	// nfish+1 each
+};
+
+// Oct 2026: store of statistics at locus pairs (argument "v:" on the
+// command line), from which LD method is evaluated at other critical
+// values without the genotypes (argument "x:"), see PairStatSave.
+// The block of a population begins with this head.
+struct pairhead
+{
+	char tag[8];				// "pairs"
+	unsigned long long key;		// of genotypes at the loci, see LDCacheKey
+	int icount, popRead, nfish, nloci;
+	unsigned long long nPair;	// locus pairs in the block
+	long long size;				// bytes of those pairs
+};
+
+// a block opened to evaluate LD method, with the locus pair read last
+typedef struct pairstat *PAIRSTAT;
+struct pairstat
+{
+	FILE *inp;
+	long long start;			// where the pairs of the block begin
+	unsigned long long nPair, nRead;
+	int nloci;
+	int p1, p2, nSamp, nA1, nA2;	// see PairStatSave
+	int *count, maxCount;			// copies, homozygotes, joint counts
+};
+
+// Oct 2026: results of Burrows_Calcul at locus pairs (p1, p2), one for
+// each group g of identical loci p2 (see LocusDup), to be reused at the
+// other loci of the group paired with the same p1, see LDRunPairs
+typedef struct pairres *PAIRRES;
+struct pairres
+{
+	int nGroup, nfish;
+	int *p1;					// locus p1 of the pair kept, -1 if none
+	float *nSamp, *rB, *expR2;
+	int *nInd1, *nInd2, *nMpairs;
+	float *r2AtPairX, *JweighPair;	// jackknife on samples, nfish for each
+	int *noDatFish;					// group, NULL if no jackknife
+	char *r2Inc;					// 1 if r2Count was increased
+	unsigned long long *r2Count0;	// r2Count before the pair, nfish
+};
+
+// Oct 2026: a variant of Burrows_Calcul (see burcalc.h, BurCalcPick)
+typedef void (*BURCALC) (float cutoff, ALLEPTR allep1, ALLEPTR allep2,
+				FISHPTR popLoc1, FISHPTR popLoc2, int p1, int p2,
+				int nMp1, int nMp2, int nfish, float *nSamp,
+				int *nInd1, int *nInd2, int *nMpairs, float *rB,
+				int currPop, int *missptr, FILE *outBurr,
+				char *outBurrName, char moreBurr, char BurrPause,
+				float *expR2, char weighsmp,
+				char sepBurOut, char moreCol, char BurAlePair,
+				char jack, int **p1Gen, int **p2Gen, int *noDatFish,
+				char *countm1, char *countm2,
+				int *mValp1, float *freqp1, float *homop1,
+				int *mValp2, float *freqp2, float *homop2,
+				float *r2AtPairX, float *JweighPair,
+				unsigned long long *r2Count, float epsilon);
+
+// Oct 2026: binary store of r^2-values at locus pairs (argument "r:" on
+// the command line), see R2Open. Populations write their blocks as they
+// are done, so blocks are located by the index written at the end.
+struct r2index
+{
+	long long offset;		// of the block in the file
+	int icount, popRead;	// input, population
+	float cutoff;			// critical value
+	int count;				// locus pairs in the block
+	int p1First, p2First, p1Last, p2Last;	// first and last locus pairs
+};
+
+typedef struct r2store *R2STORE;
+struct r2store
+{
+	FILE *out;
+	long nBlock, maxBlock;
+	struct r2index *index;	// of blocks written
+};
+
+// locus pairs of one population at one critical value, kept in columns
+// until a block is full, see R2Add
+typedef struct r2sect *R2SECT;
+struct r2sect
+{
+	R2STORE store;
+	FILE *con;			// console text, see PopWindow
+	int icount, popRead;
+	float cutoff;
+	int count;
+	int *p1, *p2, *chr1, *chr2, *nInd1, *nInd2;
+	float *nSamp, *r2, *r2drift, *weight;
+};
+
+// Oct 2026: file of results as records (argument "d:" on the command
+// line), lines in JSON format, or in CSV format if its name ends by
+// ".csv", see RecOpen, PrtRecord.
+typedef struct recout *RECOUT;
+struct recout
+{
+	FILE *out;
+	char csv;
+};
+
+// fields of a result (struct result, in ne2.h) in records file
+#define RECHEAD "input,pop,popID,samples,method,crit,estimate,paraLo,paraHi,"\
+				"jackLo,jackHi,hMeanS,indAlleles,r2,expR2,jackDF"
+
+// Oct 2026: phases of estimating a population timed by the profiler
+// (argument "t:" on the command line), see PhaseBegin, PopReport.
+#define PH_READ		0	// reading samples (GetSample)
+#define PH_FREQ		1	// allele lists and frequencies (AddAlleWide, Loc_Freq)
+#define PH_ELIG		2	// eligible loci (Loci_Eligible)
+#define PH_LD		3	// LD method, all of it (LDmethod)
+#define PH_PAIR		4	// LD method, locus pairs (IndAlle2, Burrows_Calcul)
+#define PH_ADJ		5	// LD method, reweighting for missing data (NeAdjustedTmp)
+#define PH_LDCI		6	// LD method, confidence intervals
+#define PH_HET		7	// Het. excess method
+#define PH_COAN		8	// Coancestry method
+#define PH_TEMP		9	// temporal method
+#define PH_PRINT	10	// writing results and locus data
+#define NPHASE		11
+
+typedef struct phase *PHASE;
+struct phase
+{
+	long calls;
+	double wall, cpu;		// seconds in the phase
+	double wall0, cpu0;		// when the phase began
+	unsigned long long pairs;	// locus pairs gone over
+	long long bytes;		// bytes read or written
+};
+
+// Oct 2026: data and results of one population for LD, Het. excess and
+// Coancestry methods. RunPop0 keeps several of these when populations are
+// estimated concurrently: each is read in turn, estimated by PopCompute,
+// then printed by PopPrint in the order of populations. The methods may
+// also run at the same time on one population, so each has its own arrays.
+typedef struct popest *POPEST;
+struct popest
+{
+	int popRead, samp;
+	char *popID;
+	char weighsmp, jSamp, moreDat, moreBurr0;
+	char showTime;			// to print time after this population
+	ALLEPTR *alleList;
+	FISHPTR *fishHead, *fishTail;
+	int *nMobil, *missptr;
+	float *minFreq, *maxFreq;
+	char *okLoc;
+	FILE *locTmp;			// locus data, to go to outLoc, if not NULL
+	FILE *con;				// console text, stdout or a temporary file
+							// copied to stdout in order, see PopWindow
+	// LD method:
+	float *wExpR2, *estNe, *wHarmonic, *rB2WAve, *r2Drift;
+	double *nIndSum;
+	char *jackOK;		// 0 if too many loci, 2 if from pair statistics
+	float *confJacklow, *confJackhi, *confParalow, *confParahi;
+	long *Jdegree;
+	float *sampSE, *confSamplow, *confSamphi;	// SE < 0 if all pairs taken
+	char bigInd;
+	int memOut;
+	// Het. excess method:
+	float hetNeb;
+	float *hSamp, *estHetN, *hetD, *loHetNe, *hiHetNe;
+	long *indAlleH;
+	FILE **hetTmp;
+	// Coancestry method:
+	char *okCoan;
+	float f1, coanNeb, loNbCoan, hiNbCoan, hSamCoan;
+	PHASE prof;				// NPHASE phases timed, NULL if not profiled
+};
+
+// Oct 2026: settings of RunPop0 used by PopCompute, PopPrint, the same for
+// all populations, except outBurr, popBurr2 (Burrows outputs, those
+// populations are not run concurrently), bigInd and the temporal method
+// (populations are generations there, so they are never concurrent).
+typedef struct popset *POPSET;
+struct popset
+{
+	char *inpName, *outFolder, *outFile;
+	struct locusMap *locList;
+	FILE *output, *shOutputLD, *shOutputHet, *shOutputCoan;
+	FILE *outLoc;
+	char *outLocName;
+	FILE **outBurr;
+	char *outBurrName;
+	int *popBurr2;
+	int topBCrit, popStart, nloci, lenM, nCrit;
+	float *critVal;
+	char param, jacknife, mating;
+	char *locUse;
+	float infinite;
+	char mLD, mHet, mNomura;
+	int icount;
+	char sepBurOut, moreCol, BurAlePair;
+	struct chromosome *chromoList;
+	int nChromo, chroGrp;
+	char specP, tabX, common;
+	int topCrit, nLocUsed;
+	char bigInd;	// once set, for all later populations
+	// temporal method, see TempCompute:
+	char mTemporal, tempk, tempc, temps;
+	FREQPTR *freqList;
+	int nGeneration, generation, census;
+	float *timeline;
+	char tpDone;	// 1 if the population ends a set of generations
+	int errfreq;
+	TEMPRES *tempRes;	// results of pairs of generations
+	FILE *progOut;		// progress of LD method, see LDProgress
+	FILE *profOut;		// timing of phases, see PopReport
+	R2STORE r2Out;		// r^2 at locus pairs, see R2Add
+	RECOUT recOut;		// records of results, see PrtRecord
+	LDOPT ldOpt;		// options of LD method, see LDSampPairs
+	double costSec, costRAM, costDisk;	// dry run: cost of all populations
+};
+
+// Oct 2026: an input file listed for RunMultiFiles or RunMultiCommon, to be
+// run by RunBatch together with others. Its outputs go to temporary files,
+// which are then copied to the output files in the order of the list.
+typedef struct batchjob *BATCHJOB;
+struct batchjob
+{
+	int icount;				// input numbering, 0 if the input is not run
+	char inpName[PATHFILE];
+	long inpPos;			// where to start reading populations in input
+	char append;
+	// outputs: main, tabular-format LD, Het, Coan, Temporal in this order,
+	// outName[k] is empty if not opened (names not used if common outputs)
+	char outName[5][PATHFILE];
+	FILE *outTmp[5];
+	int popStart, popEnd, maxSamp, nloci, lenM, maxMobilVal, nCrit;
+	float critVal[MAXCRIT];
+	char format, param, nonparam, mating;
+	char *locUse;
+	char mLD, mHet, mNomura, mTemporal;
+	int nGeneration;
+	float timeline[MAXGENERATION+1];
+	int tempClue, tempxClue;
+	char byRange;
+	int topCrit, nPlan, census;
+	char tabX;
+	int err;				// returned by RunPop
+	int totPop, totPairTmp;	// populations and sample pairs in this input
+	long tpHead[2];			// header in temporal output, see RunPop0
+	BATCHJOB next;
 };
 
 typedef struct age *AGEPTR;
@@ -220,12 +739,39 @@ struct age
 int strcmp0 (char str1[], char str2[]);
 
 int RunDirect (char misFilSuf[]);
-int RunMultiFiles (char *mFileName, char mOpt);
-int RunMultiCommon (char *mFileName);
+int RunMultiFiles (char *mFileName, char mOpt, int nJob, FILE *progOut,
+					FILE *profOut, R2STORE r2Out, RECOUT recOut,
+					LDOPT ldOpt);
+int RunMultiCommon (char *mFileName, int nJob, FILE *progOut, FILE *profOut,
+				R2STORE r2Out, RECOUT recOut,
+				LDOPT ldOpt);
 int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
-				char hasOpt, char rem, char *FileOne, char *FileTwo);
-
-
+				char hasOpt, char rem, char *FileOne, char *FileTwo,
+				FILE *progOut, FILE *profOut, R2STORE r2Out, RECOUT recOut,
+				LDOPT ldOpt);
+int RunCommand (int argc, char *argv[], char misFilSuf[], char LocSuf[],
+				char BurSuf[], RECOUT recJob, DATACACHE cache);
+void PrtProfHead (FILE *profOut);
+R2STORE R2Open (char *name);
+void R2Close (R2STORE store);
+int LDShardOpen (LDOPT ldOpt);
+unsigned long long HashInt (unsigned long long h, long long v);
+unsigned long long LDCacheKey (float cutoff, int nfish, FISHPTR *fishHead,
+				int lastOK, char *okLoc, struct chromosome *chromoList,
+				int nChromo, int chroGrp);
+int LDCacheRead (LDOPT ldOpt, LDPART part, unsigned long long key,
+				char jack);
+void LDCacheWrite (LDOPT ldOpt, LDPART part, unsigned long long key,
+				char jack, int icount, int popRead, float cutoff);
+RECOUT RecOpen (char *name);
+void RecClose (RECOUT rec);
+int RunServer (char *jobName, char misFilSuf[], char LocSuf[],
+				char BurSuf[]);
+void DataTrim (DATACACHE cache, size_t maxBytes);
+void AppendTmp (FILE *output, FILE *tmp);
+
+
+#ifndef NE2LIB
 int main(int argc, char *argv[])
 {
 
@@ -256,25 +802,50 @@ int main(int argc, char *argv[])
 		// added to prefix of output = Locus Data output file name
 	char *BurSuf = "Bur.txt";
 		// added to prefix of output = Burrow Coefs output file name
+	int n;
+//-----------------------------------------------------------------------
+	if (argc < 2) {
+		n = RunDirect (misFilSuf);
+		if (n > 1) printf ("*** Number of runs = %d ***\n", n);
+	}	// end of run from command line without argument.
+// Oct 2026: "s:" for server mode, jobs are read from standard input,
+// "s:jobFile" to read them from file jobFile, or "s:@sockName" from
+// clients on Unix socket sockName (see RunServer)
+	else if (argv[1][0] == 's' && argv[1][1] == ':')
+		RunServer (argv[1]+2, misFilSuf, LocSuf, BurSuf);
+	else RunCommand (argc, argv, misFilSuf, LocSuf, BurSuf, NULL, NULL);
+	return 0;
+
+}
+#endif	// NE2LIB
+
+
+//--------------------------------------------------------------------------
+
+int RunCommand (int argc, char *argv[], char misFilSuf[], char LocSuf[],
+				char BurSuf[], RECOUT recJob, DATACACHE cache)
+// Run from the command line where arguments were given from the user,
+// argv[0] is the name of this program.
+// Oct 2026: moved from main, to be called also by RunServer for each job,
+// with records of results to recJob when there is no "d:", and parsed
+// inputs kept in cache (both NULL from the command line).
+// Return the number of data files run, -1 if arguments are illegal.
+{
 	char *FileOne, *FileTwo;
 	int n, p;
 	char c;
-	char mOpt;
+	char mOpt = 0;
 	char hasOpt;
 	char rem = 0;
+	int nJob = 1;	// number of input files run at a time
+	int k;
+	FILE *progOut = NULL;
+	FILE *profOut = NULL;
+	R2STORE r2Out = NULL;
+	RECOUT recOut = NULL;
+	struct ldopt ldSet;
+	LDOPT ldOpt = NULL;
 
-	FileOne = (char *) malloc(PATHFILE * sizeof(char));
-	*FileOne = '\0';
-	FileTwo = (char *) malloc(PATHFILE * sizeof(char));
-	*FileTwo = '\0';
-//-----------------------------------------------------------------------
-	mOpt = 0;
-	if (argc < 2) {
-		n = RunDirect (misFilSuf);
-		if (n > 1) printf ("*** Number of runs = %d ***\n", n);
-	}	// end of run from command line without argument.
-	else {
-	// run from the command line where arguments were given from the user
 	// Each string (besides the name of this program) should start by
 	// either 'm', 'm+', 'c', 'i', or 'o'. The next char must be a colon ':';
 	// otherwise, the program will stop. The string after those characters
@@ -290,94 +861,399 @@ int main(int argc, char *argv[])
 	//	* 'i': for the file containing input and output file name.
 	// The 'i' file can be followed by a second directive file preceded by
 	//	* 'o': This 'o' file is to supplement optiions for 'i'-file.
-		n = strlen (argv[1]);
+	// Oct 2026: 'm', 'm+', 'c' files can be followed by "j:n" to run
+	// n input files at a time (n = 0 for as many as processors).
+	// Oct 2026: any of those can be followed by "p:progFile" to write
+	// progress of LD method to progFile, appended, as lines in JSON format
+	// (progFile can be a named pipe, or /dev/fd/3 for descriptor 3).
+	// Also "t:timeFile" to append timing of phases for each population
+	// to timeFile, see PopReport, and "r:r2File" to write r^2 at locus
+	// pairs of LD method to binary file r2File, see R2Open. "d:recFile"
+	// appends results as records to recFile, see RecOpen.
+	// Oct 2026: "l:n" to run LD method on a random sample of n locus pairs
+	// when there are more, "l:n,seed" to give the seed (default 1), see
+	// LDSampPairs. "a:tol" or "a:tol,k" for running estimates of LD method
+	// every k locus pairs (default LDANYPAIR), stopping when the CI of
+	// r^2-drift is within tol of it (tol = 0 to go over all pairs).
+	// "w:min" or "w:min,max" to pair loci within a chromosome only when
+	// their distance (base pairs) is at least min and at most max (0 for
+	// no bound), if the chromosome file gives positions, see ChromoWindow.
+	// "h:k,K,name" to run LD method on shard k of K of the locus pairs,
+	// writing partial results to file name.k; "h:0,K,name" to merge the
+	// partial results of the K shards, see LDShardWrite.
+	// "k:cacheFile" to keep sums of LD method over locus pairs in cacheFile,
+	// so that runs on the same data with other mating model, CI or output
+	// options take them from there, see LDCacheWrite.
+	// "v:statFile" to keep statistics of locus pairs in statFile; a later
+	// run with "x:statFile" takes r^2 at locus pairs from them at its own
+	// critical values, in place of the genotypes, see PairStatBegin.
+	// "e:" for a dry run of an 'i' file: inputs and options are read, and
+	// the cost of each population is predicted (time, memory, temporary
+	// disk), see PopCost. Nothing is written to output files.
+	// "b:n" to estimate n populations of an input at a time (n = 0 for as
+	// many as threads), printed in order, see PopWindow.
+	n = strlen (argv[1]);
 // error messages on screen (no file or not preceded by appropriate chars):
-		c = argv[1][0];
-		if ((n <= 2) || (c != 'i' && c != 'm' && c!= 'c')) {
-			printf ("Illegal argument!\n");
-			exit (0);
-		};
-		if (c == 'i' && argv[1][1] != ':') {
-			printf ("Illegal argument!\n");
-			exit (0);
-		};
-		if (c == 'c' && argv[1][1] != ':') {
-			printf ("Illegal argument!\n");
-			exit (0);
-		};
-		if (c == 'm') {
-			if (argv[1][1] == '+') {
-				if (n == 3) {
-					printf ("Illegal argument!\n");
-					exit (0);
-				};
-				if (argv[1][2] != ':') {
-					printf ("Illegal argument!\n");
-					exit (0);
-				};
-				mOpt = 1;	// run multiple files with more parameters
-			} else {
-				if (argv[1][1] != ':') {
-					printf ("Illegal argument!\n");
-					exit (0);
-				};
-			// things are OK: run multiple files, with less parameters
+	c = argv[1][0];
+	if ((n <= 2) || (c != 'i' && c != 'm' && c!= 'c')) {
+		printf ("Illegal argument!\n");
+		return -1;
+	};
+	if (c == 'i' && argv[1][1] != ':') {
+		printf ("Illegal argument!\n");
+		return -1;
+	};
+	if (c == 'c' && argv[1][1] != ':') {
+		printf ("Illegal argument!\n");
+		return -1;
+	};
+	if (c == 'm') {
+		if (argv[1][1] == '+') {
+			if (n == 3) {
+				printf ("Illegal argument!\n");
+				return -1;
 			};
-		};
-	// assign FileOne as the name of the first control file to be used
-		for (p=0; p<n; p++) {
-			if (mOpt == 1) *(FileOne +p) = argv[1][3+p];
-			else *(FileOne +p) = argv[1][2+p];
-		};
-		*(FileOne+n) = '\0';
-		if (argv[1][0] == 'm') {
-			// "rm" stands for remove, to remove this file
-			if (argc > 2) rem = (strcmp0 (argv[2], "rm") == 0) ? 1 : 0;
-			n = RunMultiFiles (FileOne, mOpt);
-
-			printf ("\n*** Number of data files = %d ***\n", n);
-			if (rem == 1) remove (FileOne);
-			exit (0);
-		};
-		if (argv[1][0] == 'c') {
-			// "rm" stands for remove, to remove this file
-			if (argc > 2) rem = (strcmp0 (argv[2], "rm") == 0) ? 1 : 0;
-			n = RunMultiCommon (FileOne);
-
-			printf ("\n*** Number of data files = %d ***\n", n);
-			if (rem == 1) remove (FileOne);
-			exit (0);
-		};
-		if (argv[1][0] == 'i') {
-		// first directive file is info on input and output files.
-			hasOpt = 0;
-			if (argc > 2) {
-				hasOpt = (argv[2][0] == 'o' && argv[2][1] == ':')? 1: 0;
-				// "rm" stands for remove, to remove those "i", "o" files
-				rem = (strcmp (argv[2], "rm") == 0) ? 1 : 0;
-				if ((hasOpt == 1) && argc > 3)
-					rem = (strcmp (argv[3], "rm") == 0)? 1: 0;
+			if (argv[1][2] != ':') {
+				printf ("Illegal argument!\n");
+				return -1;
 			};
-			if (hasOpt == 1) {
-			// FileTwo is assigned to be the name of option file:
-				n = strlen (argv[2]);
-				if (n>2) for (p=0; p<n; p++) *(FileTwo +p) =argv[2][2+p];
-				*(FileTwo+n) = '\0';
+			mOpt = 1;	// run multiple files with more parameters
+		} else {
+			if (argv[1][1] != ':') {
+				printf ("Illegal argument!\n");
+				return -1;
 			};
-			// FileOne is the name of info directive file
-			// FileTwo is the name of option directive file
-			RunOption (misFilSuf, LocSuf, BurSuf, hasOpt, rem,
-						FileOne, FileTwo);
+		// things are OK: run multiple files, with less parameters
+		};
+	};
+	FileOne = (char *) malloc(PATHFILE * sizeof(char));
+	*FileOne = '\0';
+	FileTwo = (char *) malloc(PATHFILE * sizeof(char));
+	*FileTwo = '\0';
+// assign FileOne as the name of the first control file to be used
+	for (p=0; p<n; p++) {
+		if (mOpt == 1) *(FileOne +p) = argv[1][3+p];
+		else *(FileOne +p) = argv[1][2+p];
+	};
+	*(FileOne+n) = '\0';
+	ldSet.nSample = 0;
+	ldSet.seed = 1;
+	ldSet.anytime = 0;
+	ldSet.tol = 0;
+	ldSet.every = LDANYPAIR;
+	ldSet.minDist = ldSet.maxDist = 0;
+	ldSet.shard = ldSet.nShard = 0;
+	ldSet.shardName = NULL;
+	ldSet.cacheName = NULL;
+	ldSet.dryRun = 0;
+	ldSet.statName = NULL;
+	ldSet.statEval = 0;
+	ldSet.nPopRun = 1;
+	ldSet.data = cache;
+	if (cache != NULL) ldOpt = &ldSet;
+	for (p=2; p<argc; p++)
+		if (strcmp0 (argv[p], "e:") == 0) {
+			ldSet.dryRun = 1;
+			ldOpt = &ldSet;
+		}
+	// files of progress, timing, r^2, records are not opened in dry run
+	for (p=2; p<argc; p++)
+		if (argv[p][0] == 'p' && argv[p][1] == ':' && progOut == NULL
+			&& ldSet.dryRun == 0) {
+			if ((progOut = fopen (argv[p]+2, "a")) == NULL)
+				perror (argv[p]+2);
+		} else if (argv[p][0] == 't' && argv[p][1] == ':' && profOut == NULL
+			&& ldSet.dryRun == 0) {
+			if ((profOut = fopen (argv[p]+2, "a")) == NULL)
+				perror (argv[p]+2);
+			else PrtProfHead (profOut);
+		} else if (argv[p][0] == 'r' && argv[p][1] == ':' && r2Out == NULL
+			&& ldSet.dryRun == 0)
+			r2Out = R2Open (argv[p]+2);
+		else if (argv[p][0] == 'd' && argv[p][1] == ':' && recOut == NULL
+			&& ldSet.dryRun == 0)
+			recOut = RecOpen (argv[p]+2);
+		else if (argv[p][0] == 'l' && argv[p][1] == ':') {
+			sscanf (argv[p]+2, "%llu,%llu", &(ldSet.nSample), &(ldSet.seed));
+			if (ldSet.nSample > 0) ldOpt = &ldSet;
+		} else if (argv[p][0] == 'a' && argv[p][1] == ':') {
+			sscanf (argv[p]+2, "%f,%llu", &(ldSet.tol), &(ldSet.every));
+			if (ldSet.every == 0) ldSet.every = LDANYPAIR;
+			ldSet.anytime = 1;
+			ldOpt = &ldSet;
+		} else if (argv[p][0] == 'w' && argv[p][1] == ':') {
+			sscanf (argv[p]+2, "%ld,%ld", &(ldSet.minDist), &(ldSet.maxDist));
+			ldOpt = &ldSet;
+		} else if (argv[p][0] == 'k' && argv[p][1] == ':') {
+			ldSet.cacheName = argv[p]+2;
+			ldOpt = &ldSet;
+		} else if (argv[p][0] == 'b' && argv[p][1] == ':') {
+			ldSet.nPopRun = atoi (argv[p]+2);
+			ldOpt = &ldSet;
+		} else if ((argv[p][0] == 'v' || argv[p][0] == 'x')
+			&& argv[p][1] == ':') {
+			ldSet.statName = argv[p]+2;
+			ldSet.statEval = (argv[p][0] == 'x')? 1: 0;
+			ldOpt = &ldSet;
+		} else if (argv[p][0] == 'h' && argv[p][1] == ':') {
+			k = 0;
+			if (sscanf (argv[p]+2, "%d,%d,%n", &(ldSet.shard),
+						&(ldSet.nShard), &k) < 2 || k == 0
+				|| ldSet.nShard <= 0 || ldSet.shard < 0
+				|| ldSet.shard > ldSet.nShard) {
+				printf ("Illegal argument %s!\n", argv[p]);
+				ldSet.nShard = -1;
+			} else {
+				ldSet.shardName = argv[p]+2+k;
+				ldOpt = &ldSet;
+			}
+		}
+	if (recOut == NULL && ldSet.dryRun == 0) recOut = recJob;
+	if (ldSet.nShard > 0 && ldSet.shard > 0 && ldSet.dryRun == 0
+		&& LDShardOpen (&ldSet) != 0) ldSet.nShard = -1;
+	if (argv[1][0] == 'm' || argv[1][0] == 'c') {
+		// "rm" stands for remove, to remove this file
+		// "j:n" for running n input files at a time
+		for (p=2; p<argc; p++) {
+			if (strcmp0 (argv[p], "rm") == 0) rem = 1;
+			if (argv[p][0] == 'j' && argv[p][1] == ':')
+				nJob = atoi (argv[p]+2);
+		};
+	};
+	if (ldSet.nShard < 0) n = -1;	// shards are not set up
+	else if (ldSet.dryRun == 1 && argv[1][0] != 'i') {
+		printf ("Dry run (e:) is only for an i: file!\n");
+		n = -1;
+	} else if (argv[1][0] == 'm') {
+		n = RunMultiFiles (FileOne, mOpt, nJob, progOut, profOut, r2Out, recOut,
+		ldOpt);
+
+		printf ("\n*** Number of data files = %d ***\n", n);
+		if (rem == 1) remove (FileOne);
+	} else if (argv[1][0] == 'c') {
+		n = RunMultiCommon (FileOne, nJob, progOut, profOut, r2Out, recOut,
+		ldOpt);
+
+		printf ("\n*** Number of data files = %d ***\n", n);
+		if (rem == 1) remove (FileOne);
+	} else {
+	// first directive file is info on input and output files.
+		hasOpt = 0;
+		if (argc > 2) {
+			hasOpt = (argv[2][0] == 'o' && argv[2][1] == ':')? 1: 0;
+			// "rm" stands for remove, to remove those "i", "o" files
+			rem = (strcmp (argv[2], "rm") == 0) ? 1 : 0;
+			if ((hasOpt == 1) && argc > 3)
+				rem = (strcmp (argv[3], "rm") == 0)? 1: 0;
+		};
+		if (hasOpt == 1) {
+		// FileTwo is assigned to be the name of option file:
+			n = strlen (argv[2]);
+			if (n>2) for (p=0; p<n; p++) *(FileTwo +p) =argv[2][2+p];
+			*(FileTwo+n) = '\0';
+		};
+		// FileOne is the name of info directive file
+		// FileTwo is the name of option directive file
+		n = RunOption (misFilSuf, LocSuf, BurSuf, hasOpt, rem,
+					FileOne, FileTwo, progOut, profOut, r2Out, recOut, ldOpt);
+
+	};	// end of "if (argv[1][0] == 'i')"
+	if (progOut != NULL) fclose (progOut);
+	if (profOut != NULL) fclose (profOut);
+	if (r2Out != NULL) R2Close (r2Out);
+	if (recOut != NULL && recOut != recJob) RecClose (recOut);
+	free (FileOne);
+	free (FileTwo);
+	return n;
+}
 
-		};	// end of "if (argv[1][0] == 'i')"
 
-	};	// end of "if (argc < 2) else .. "
-	return 0;
+//--------------------------------------------------------------------------
 
+int ServeJobs (FILE *jobs, int *nJobRun, DATACACHE cache, char misFilSuf[],
+				char LocSuf[], char BurSuf[])
+// Oct 2026: run jobs on the lines of jobs (see RunServer), numbered from
+// *nJobRun + 1, which is updated. Return 1 if a line "quit" stops the
+// server, 0 at end of file.
+{
+	char line[LENJOB];
+	char *argv[MAXJOBARG+1];
+	char *ptr, *word, quote, *illegal;
+	int argc, c, n, nRec;
+	struct recout rec;
+
+	argv[0] = "Ne2x";
+	rec.csv = 0;
+	while (fgets (line, LENJOB, jobs) != NULL) {
+	// a line not ended within LENJOB-1 chars is rejected, its rest skipped
+		illegal = NULL;
+		if (strchr (line, '\n') == NULL && (c = fgetc (jobs)) != EOF
+			&& c != '\n') {
+			for (; c != EOF && c != '\n'; c = fgetc (jobs));
+			illegal = "Job line is too long!";
+		};
+	// split the line into arguments, the line is changed
+		for (argc = 1, ptr = line; illegal == NULL; argc++) {
+			ptr += strspn (ptr, WHITESPACE);
+			if (*ptr == '\0') break;
+			if (argc > MAXJOBARG) {
+				illegal = "Too many arguments in job line!";
+				break;
+			};
+			argv[argc] = word = ptr;
+			for (quote = 0; *ptr != '\0'; ptr++) {
+				if (*ptr == '\r' || *ptr == '\n') break;
+				if (*ptr == '"') quote = 1 - quote;
+				else if (quote == 0 && strchr (WHITESPACE, *ptr) != NULL) break;
+				else *(word++) = *ptr;
+			};
+			if (*ptr != '\0') ptr++;
+			*word = '\0';
+		};
+		if (argc == 1 && illegal == NULL) continue;	// blank line
+		if (illegal == NULL && strcmp0 (argv[1], "quit") == 0) return 1;
+		(*nJobRun)++;
+		DataTrim (cache, (size_t) DATACACHEMB << 20);
+		cache->job = *nJobRun;
+		cache->nKept = cache->nRead = 0;
+		printf ("*** Job %d begin ***\n", *nJobRun);
+		fflush (stdout);
+		rec.out = NULL;
+		if (illegal != NULL) {
+			printf ("%s\n", illegal);
+			n = -1;
+		} else {
+			rec.out = tmpfile ();
+			n = RunCommand (argc, argv, misFilSuf, LocSuf, BurSuf,
+							(rec.out != NULL)? &rec: NULL, cache);
+		};
+		nRec = 0;
+		if (rec.out != NULL) {
+			rewind (rec.out);
+			while ((c = fgetc (rec.out)) != EOF) if (c == '\n') nRec++;
+		};
+		printf ("{\"job\":%d,\"return\":%d,\"records\":%d,\"inputsKept\":%d,"
+				"\"inputsRead\":%d}\n", *nJobRun, n, nRec, cache->nKept,
+				cache->nRead);
+		AppendTmp (stdout, rec.out);
+		printf ("*** Job %d end: %d ***\n", *nJobRun, n);
+		fflush (stdout);
+	};
+	return 0;
 }
 
+//--------------------------------------------------------------------------
+
+int RunSocket (char *sockName, int *nJobRun, DATACACHE cache,
+				char misFilSuf[], char LocSuf[], char BurSuf[])
+// Oct 2026: server on Unix socket sockName (removed when the server
+// stops). Clients connect one after another: jobs are read from the
+// connection, and their console outputs are written to it (in place of
+// standard output), until the client closes it or sends "quit", which
+// stops the server. Return -1 if the socket cannot be set up (or on
+// Windows), else 0.
+{
+#ifdef _WIN32
+	printf ("Server on a Unix socket is not available on Windows!\n");
+	return -1;
+#else
+	struct sockaddr_un addr;
+	int sock, conn, out, quit = 0;
+	FILE *jobs;
+
+	if (strlen (sockName) >= sizeof(addr.sun_path)) {
+		printf ("Socket name %s is too long!\n", sockName);
+		return -1;
+	};
+	memset (&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy (addr.sun_path, sockName);
+	if ((sock = socket (AF_UNIX, SOCK_STREAM, 0)) < 0) {
+		perror (sockName);
+		return -1;
+	};
+	if (bind (sock, (struct sockaddr *) &addr, sizeof(addr)) != 0
+		|| listen (sock, 8) != 0) {
+		perror (sockName);
+		close (sock);
+		return -1;
+	};
+	// a client leaving before reading outputs does not stop the server
+	signal (SIGPIPE, SIG_IGN);
+	printf ("*** Server ready on %s ***\n", sockName);
+	fflush (stdout);
+	while (quit == 0 && (conn = accept (sock, NULL, NULL)) >= 0) {
+		if ((jobs = fdopen (conn, "r")) == NULL) {
+			close (conn);
+			continue;
+		};
+		fflush (stdout);
+		out = dup (STDOUT_FILENO);
+		dup2 (conn, STDOUT_FILENO);
+		printf ("*** Server ready ***\n");
+		fflush (stdout);
+		quit = ServeJobs (jobs, nJobRun, cache, misFilSuf, LocSuf, BurSuf);
+		fflush (stdout);
+		dup2 (out, STDOUT_FILENO);
+		close (out);
+		fclose (jobs);
+	};
+	close (sock);
+	unlink (sockName);
+	return 0;
+#endif
+}
 
+//--------------------------------------------------------------------------
 
+int RunServer (char *jobName, char misFilSuf[], char LocSuf[],
+				char BurSuf[])
+// Oct 2026: server mode. The program stays, running jobs one after another,
+// each on a line of file jobName (standard input if jobName is empty; it
+// can be a named pipe, written by the interface or a workflow manager), or
+// sent by clients on Unix socket sockName if jobName is "@sockName" (see
+// RunSocket). A job is the arguments that would be given on the command
+// line, e.g.,
+//		i:info.txt o:option.txt
+//		c:common.txt j:4
+// a name having blanks is put in double quotes. Console outputs of job k
+// are between lines "*** Job k begin ***" and "*** Job k end: n ***",
+// n as returned by RunCommand, flushed when the job ends. Before the end
+// line, a line in JSON format gives k, n, the number of records of results
+// that follow it (as from "d:", see PrtRecord, unless the job has "d:"),
+// and the numbers of input files taken from memory or read from file.
+// A line longer than LENJOB-1 characters, or having more than MAXJOBARG
+// arguments, is not run (n = -1). A line "quit" or end of file stops the
+// server. Return the number of jobs.
+// Genotypes of input files parsed by a job are kept (up to DATACACHEMB MB
+// in all, the least recently used are freed), and a later job on the same
+// file takes them from memory if the file has not changed (its time of
+// modification and size), for the same loci (see DataOpen).
+{
+	FILE *jobs;
+	struct datacache cache;
+	int nJobRun = 0;
+
+	cache.head = NULL;
+	cache.bytes = 0;
+	cache.job = 0;
+	cache.nKept = cache.nRead = 0;
+	if (*jobName == '@')
+		RunSocket (jobName+1, &nJobRun, &cache, misFilSuf, LocSuf, BurSuf);
+	else {
+		if (*jobName == '\0') jobs = stdin;
+		else if ((jobs = fopen (jobName, "r")) == NULL) {
+			perror (jobName);
+			return 0;
+		};
+		printf ("*** Server ready ***\n");
+		fflush (stdout);
+		ServeJobs (jobs, &nJobRun, &cache, misFilSuf, LocSuf, BurSuf);
+		if (jobs != stdin) fclose (jobs);
+	};
+	DataTrim (&cache, 0);
+	return nJobRun;
+}
 //--------------------------------------------------------------------------
 // Tools
 // -----------------------------
@@ -1335,7 +2211,7 @@ int ValidGeno (char *data, int gene[2], int lenM)
 
 int GetSample (FILE *input, int nloci, int *sampData, int lenM, int *samp,
 				int maxlen, int *nSampErr, int *currErr,
-				char genErr[], int *firstErr, char *locUse)
+				char genErr[], int *firstErr, char *locUse, FILE *con)
 // Get one sample from input file, return an error code err.
 //	* 0: normal,
 //	* between nloci and (2*nloci-1): at least 1 missing data
@@ -1344,12 +2220,13 @@ int GetSample (FILE *input, int nloci, int *sampData, int lenM, int *samp,
 //	* >= 4*nloci: at least 1 genotype has nondigit.
 //	* -1: end of file encountered.
 // Put data from this one sample into array sampData.
+// Oct 2026: messages go to console stream con.
 {
 	char *data;
 	int m = 0, p, c, k, mp;
 	int err = 0;	// for error code
 	if ((data = (char*) malloc(sizeof(char)*maxlen)) == NULL) {
-		printf ("Cannot locate memory for genotypes!\n");
+		fprintf (con, "Cannot locate memory for genotypes!\n");
 		return -2;
 	};
 
@@ -1366,7 +2243,7 @@ int GetSample (FILE *input, int nloci, int *sampData, int lenM, int *samp,
 //	error warnings here, may decide to terminate the program or just return -1
 //  and leave the decision at the calling program, along with some error messages.
 			if (*currErr == 0) (*nSampErr)++;
-			printf ("Data of sample %d end too soon.\n", *samp);
+			fprintf (con, "Data of sample %d end too soon.\n", *samp);
 			free (data);
 			return -1;
 		} else {
@@ -1402,10 +2279,11 @@ int GetSample (FILE *input, int nloci, int *sampData, int lenM, int *samp,
 //				printf ("Too few digits at locus %d, sample %d: [%s]\n", p+1,
 //						*samp, data);
 				if (mp == 3)
-				printf ("Too many digits at locus %d, sample %d: [%s]\n", p+1,
+				fprintf (con,
+					"Too many digits at locus %d, sample %d: [%s]\n", p+1,
 						*samp, data);
 				if (mp == 4)
-				printf ("Nondigit at locus %d, sample %d: [%s]\n", p+1,
+				fprintf (con, "Nondigit at locus %d, sample %d: [%s]\n", p+1,
 						*samp, data);
 			};
 			if (mp > m) m = mp;
@@ -2407,6 +3285,8 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 				char *outFolder, char *outName, int *nPop, int *nloci,
 				int *maxMobilVal, int *lenM, FILE *infofile, char *append,
 				AGEPTR *ageSeq, int *nSeq, int *tempClue, int *nPlan)
+// Oct 2026: infofile is not closed here, also when NULL is returned (it
+// was closed on errors, then again by the caller); input is closed then.
 {
 
 	FILE *input = NULL, *output = NULL;
@@ -2435,7 +3315,6 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 // line 1:
 	if (FindMethod (infofile, infoName, &line, mLD, mHet, mNomura,
 		mTemporal, tempClue) == -1) {
-		fclose (infofile);
 		return NULL;
 	};
 
@@ -2447,7 +3326,6 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	if (len > 0 || c == SPECHR)	// still on the line containing inpFolder.
 		for (; (c=fgetc(infofile)) != EOF && c!='\n';)
 			if (c == EOF) {
-				fclose (infofile);
 				ErrMsg (infoName, "END OF FILE too soon", line);
 				return NULL;
 			};
@@ -2456,7 +3334,6 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	line++;
 	if (GetToken (infofile, inpName, LENFILE, BLANKS, ENDCHRS, &c, &n) <= 0)
 	{
-		fclose (infofile);
 		ErrMsg (infoName, "Fail to obtain input file name", line);
 		return NULL;
 	}
@@ -2464,7 +3341,6 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	if ((input = GetInp(inpFolder, inpName)) == NULL) {
 		printf ("Input file [%s] not found in directory %s\n",
 				inpName, inpFolder);
-		fclose (infofile);
 		return NULL;
 	}
 
@@ -2480,7 +3356,7 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 // both inpFolder and inpFile will cause the program to crash.
 	if ((input = fopen(inpFile, "r")) == NULL) {
 		printf ("Input file [%s] not found\n", inpFile);
-		fclose (infofile);
+		fclose (input);
 		free (inpFolder);
 		free (inpFile);
 		return NULL;
@@ -2491,7 +3367,7 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	// continue reading this infoName file file to obtain info:
 	for (; (c=fgetc(infofile)) != EOF && c!='\n';)
 		if (c == EOF) {
-			fclose (infofile);
+			fclose (input);
 			ErrMsg (infoName, "END OF FILE too soon", line);
 			return NULL;
 		};
@@ -2500,12 +3376,12 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	f = 0;
 // read input format indicator
 	if (GetInt (infofile, &f, 1) <= 0) {
-		fclose (infofile);
+		fclose (input);
 		ErrMsg (infoName, "No format indicator for input file given", line);
 		return NULL;
 	};
 	if (f < MINFORM || f > MAXFORM) {
-		fclose (infofile);
+		fclose (input);
 		ErrMsg (infoName, "Illegal format indicator for input file", line);
 		return NULL;
 	};
@@ -2519,7 +3395,7 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	if (len > 0 || c == SPECHR)
 		for (; (c=fgetc(infofile)) != EOF && c!='\n';)
 			if (c == EOF) {
-				fclose (infofile);
+				fclose (input);
 				ErrMsg (infoName, "END OF FILE too soon", line);
 				return NULL;
 			};
@@ -2529,7 +3405,7 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 // n = # of trailing blanks (in BLANKS)  before reaching char in ENDCHRS
 	if (GetToken (infofile, outName, LENFILE, BLANKS, ENDCHRS, &c, &n) <= 0)
 	{
-		fclose (infofile);
+		fclose (input);
 		ErrMsg (infoName, "No OUTPUT file name", line);
 		return NULL;
 	};
@@ -2550,7 +3426,7 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 		// otherwise, n is at least 1.
 		// The value of "line" now is 8.
 		*nCrit = 0;
-		fclose (infofile);
+		fclose (input);
 		ErrMsg (infoName, "ERROR on Number of Critical Value", line);
 		return NULL;
 	} else *nCrit = n;
@@ -2560,7 +3436,7 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 // mating model: 0 for random, 1 for monogamy
 	m = 0;
 	if (GetInt (infofile, &m, 1) <= 0) {
-		fclose (infofile);
+		fclose (input);
 		ErrMsg (infoName, "ERROR on Entry for Mating Model", line);
 		return NULL;
 	};
@@ -2596,12 +3472,14 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 		if (GetInfoDat (input, nPop, nloci, maxMobilVal, lenM, LEN_BLOCK) == 0)
 		{
 			printf ("Error in (FSTAT format) input file \"%s\"\n", inpName);
+			fclose (input);
 			return NULL;
 		};
 	};
 	if (f==GENPOP) {	// GENEPOP format
 		if ((*nloci = GetnLoci (input, LEN_BLOCK, lenM)) <= 0) {
 			printf ("Error in (GENEPOP format) input file \"%s\"\n", inpName);
+			fclose (input);
 			return NULL;
 		} else {
 			rewind (input);
@@ -2633,10 +3511,9 @@ FILE *InfoDirective (char *mLD, char *mHet, char *mNomura, char *mTemporal,
 	// open but not destroy its content if the file exists, use "a"
 	if ((output=fopen(outFile, "a")) == NULL) {
 		fclose (input);
-		fclose (output);
+		printf ("Cannot open file \"%s\" for output.\n", outFile);
 		free (outFile);
 		free (prefix);
-		printf ("Cannot open file \"%s\" for output.\n", outFile);
 		return NULL;
 	} else fclose (output);	// done, output file is OK to open
 	free (outFile);
@@ -3250,13 +4127,12 @@ int NumLocTake (char *locUse, int nloci)
 // --------------------------------------------------------------------------
 
 void PrtLines (FILE *output, int ndash, char dash)
+// Oct 2026: no flush, this is called for each locus pair in Burrows output
 {
 	int n;
 	if (output == NULL) return;
-	for (n=0; n<ndash; n++) fprintf (output, "%c", dash);
-	fprintf(output, "\n");
-	fflush (output);
-
+	for (n=0; n<ndash; n++) fputc (dash, output);
+	fputc ('\n', output);
 }
 // --------------------------------------------------------------------------
 // called by Loci_Eligible
@@ -3749,7 +4625,7 @@ void PrtLocFreq (ALLEPTR *alleList, int nloci, int nfish, int nMobil[],
 // (GENPOP format allows up to 3 digits for an allele), so we state
 // the maximum as 1000. If allowing unlimited alleles, then should change
 // to pointers (list) for counting.
-	alle = (char*) malloc(sizeof(char)*5);
+	alle = (char*) malloc(sizeof(char)*6);	// 5 digits and '\0' from sprintf
 	for (m=0; m<5; m++) alle[m] = ' ';
 	alleNum = (int*) malloc(sizeof(int)*(1000));
 	for (k=0; k < 1000; *(alleNum + k) = 0, k++);
@@ -3793,7 +4669,6 @@ void PrtLocFreq (ALLEPTR *alleList, int nloci, int nfish, int nMobil[],
 		fprintf (outLoc, "(Up to 10 righmost characters for locus names)\n");
 		fprintf (outLoc, "Locus [#:Name]  \t Size \tAlleles:");
 	} else fprintf (outLoc, "Locus           \t Size \tAlleles:");
-	fflush(outLoc);
 	for (i=1; i <= nAlle; i++) {
 		// alle is string of 5 characters for writing allele up to its length
 		sprintf(alle, "%5d", *(alleDes+i));
@@ -3812,7 +4687,6 @@ void PrtLocFreq (ALLEPTR *alleList, int nloci, int nfish, int nMobil[],
 	fprintf (outLoc, "\n----------------\t------\t--------");
 	for (i=1; i <= nAlle; i++) fprintf (outLoc, "\t--------");
 	fprintf (outLoc, "\n");
-	fflush(outLoc);
 	k = 0;	// index for locList
 	for (p=0; p<nloci; p++) {
 		if (*(locUse+p) == 0) continue;
@@ -3857,7 +4731,7 @@ void Loc_Freq (ALLEPTR *alleList, int nloci, int nfish, float *NeWt,
 				int nMobil[], int *missptr, char *locUse, float *minFreq,
 				float *maxFreq, FILE *outLoc, char *outLocName,
 				char moreDat, int popRead, char mHet, int lenM,
-				struct locusMap *locList)
+				struct locusMap *locList, FILE *con)
 // This routine go through all allele mobilitiy nodes in all "nloci" loci,
 // calculate frequencies of these mobilities, put the values in the field
 // "freq" of each node.
@@ -3910,7 +4784,7 @@ void Loc_Freq (ALLEPTR *alleList, int nloci, int nfish, float *NeWt,
 // ---------------------------------------------------------------------
 
 	if (outLoc != NULL && moreDat == 1) {
-		printf ("   Allele frequencies are being written to file %s.\n",
+		fprintf (con, "   Allele frequencies are being written to file %s.\n",
 				outLocName);
 		fprintf (outLoc, "\n\nPOPULATION %6d\t(Sample Size = %d)\n", popRead, nfish);
 		for (k=0; k<17; k++) fprintf (outLoc, "*");
@@ -4073,7 +4947,6 @@ void Loc_Freq (ALLEPTR *alleList, int nloci, int nfish, float *NeWt,
 //*/
 				};
 // ------------------------------------------------------------------
-				fflush (outLoc);
 			}
 
 			// release memories for those, to reclaim at next locus.
@@ -4098,7 +4971,6 @@ void Loc_Freq (ALLEPTR *alleList, int nloci, int nfish, float *NeWt,
 		if (outLoc != NULL && (moreDat == 1 && locPause == 0)) {
 			fprintf(outLoc, "\nMin and Max Freq at locus %d:%10.5f,%10.5f\n",
 					p+1, rmin, rmax);
-			fflush (outLoc);
 		};
 // added Sept 2011:
 		mLoc++;
@@ -4144,7 +5016,6 @@ void Loc_Freq (ALLEPTR *alleList, int nloci, int nfish, float *NeWt,
 //						Nebp, NbH, NbHW, *NeWt, NbUw, dSum);
 // ------------------------------------------------------------------
 
-		fflush (outLoc);
 	};
 
 // To deal with heterozygote excess method --------------------------
@@ -4538,298 +5409,374 @@ void CI_t_DistHet (long degfree, float dmean, float stdErr,
 
 
 // ------------------------------------------------------------------
-float HetxLow (FISHPTR *fishList, int nLowF, float lastHx, int *smAlle,
-			   float totF, int nfish)
-{
-// nlowF: number of alleles with low freq,
-// lastHx: the last hx read in the calling function before this is called
-// smAllle: list of low freq alleles
-// totF: total frequencies of those alleles
-// nfish: number of samples having data
-// Return value: hx, heterozygote excess, when all those alleles are
-// lumped together, considered as only one allele.
-	int het, homo, i, j;
-	int a0, a1;
-	float hExp, hObs, hx;
+// Oct 2026: HetxLow is replaced by HetLowCount, called once per locus for
+// all critical values (HetxLow went through the genotypes at a locus for
+// each critical value, comparing each allele with the list of low
+// frequency alleles).
+// ------------------------------------------------------------------
+void HetLowCount (FISHPTR *fishList, int nA, int *mVal, int *rank,
+				  int *hetLow)
+{
+// The nA alleles at the locus are given in the order of the allele list,
+// i.e., mVal[0] < mVal[1] < ... < mVal[nA-1], and rank[i] is the position
+// of allele mVal[i] when alleles are ordered by ascending frequencies.
+// For any cutoff, the low frequency alleles (freq < cutoff) are then the
+// alleles having rank 0, ..., (m-1), where m is the number of them.
+// On return, hetLow[m] is the number of heterozygotes when those m alleles
+// are lumped together as one allele, that is, the number of samples having
+// exactly one of their two alleles among those m alleles, m = 0, ..., nA.
+// A sample with alleles of ranks r0 <= r1 is counted for r0 < m <= r1,
+// so hetLow is obtained by accumulating +1 at (r0+1), -1 at (r1+1).
+// An allele not found in mVal (missing data) takes rank nA, never lumped.
+	int i, m, lo, hi, r0, r1;
+	int a[2];
 	FISHPTR curr = *fishList;
-	if (nLowF == 0) return 0;
-	if (nLowF == 1) return lastHx;
-	het = 0;
-	homo  = 0;
+	for (m=0; m<=nA+1; m++) *(hetLow+m) = 0;
 	for ( ; curr != NULL; curr = curr->next) {
-		a0 = curr->gene[0];
-		a1 = curr->gene[1];
-		for (i=0; i<nLowF; i++) {
-			if ((a0 != *(smAlle+i)) && (a1 != *(smAlle+i)))
-				continue;
-			else break;	// smAlle+i is one of the alleles
-		};
-		if (i >= nLowF) continue;	// no match
-// After the for loop and there is a match at i<nLowF, we know one
-// of the two alleles is smAlle[i].
-	// smAlle+i is one of the alleles, check the other one
-		if (a0 == *(smAlle+i)) {
-			for (j=0; j<nLowF; j++) {
-				if (a1 != *(smAlle+j))
-					continue;
-				else break;	// smAlle+j is the other
-			};
-			if (j >= nLowF) het++;
-			else homo++;
-		} else { // (a1 == *(smAlle+i))
-// At 1st loop of (i=0; ..), when (a0 != *(smAlle+i)) && (a1 != *(smAlle+i)))
-// is evaluated, the first condition (a0 != *(smAlle+i)) is evaluated first,
-// then (a1 != *(smAlle+i))) is evaluated. Only when the first is OK, the
-// second will be evaluated.
-// Thus, get out of the loop by "break", we have
-// either
-// * The first fails (then a0 = smAlle[i]) and the second is unkown,
-//   or
-// * The first holds (a0 != smAlle[i]), but the second fails (a1 = smAlle[i])
-//   However, we can not say right away that this is heterozygote.
-//   The reason: index i runs from 0 to (nLowF-1), the second allele a1 may
-//   match smAlle[i] then break, but for some j>i, we may have a0=smAlle[j].
-//   Thus, the next for loop may start from j=i+1, but as precaution, let j=0
-			for (j=0; j<nLowF; j++) {
-				if (a0 != *(smAlle+j))
-					continue;
-				else break;	// smAlle+j is the other
+		for (i=0; i<2; i++) {
+			// binary search, since mVal is in ascending order
+			a[i] = nA;
+			lo = 0;
+			hi = nA-1;
+			while (lo <= hi) {
+				m = (lo+hi)/2;
+				if (*(mVal+m) == curr->gene[i]) {
+					a[i] = *(rank+m);
+					break;
+				}
+				if (*(mVal+m) < curr->gene[i]) lo = m+1;
+				else hi = m-1;
 			};
-			if (j >= nLowF) het++;
-			else homo++;
 		};
+		r0 = (a[0] < a[1])? a[0]: a[1];
+		r1 = (a[0] < a[1])? a[1]: a[0];
+		if (r0 == r1) continue;
+		(*(hetLow+r0+1))++;
+		(*(hetLow+r1+1))--;
 	};
-	hObs = (float) het /((float) nfish);
-	hExp = HetExp (totF, nfish);
-	hx = (hObs - hExp)/(hExp);
-	if (fabs(hx) < EPSILON) hx = 0.0;
-	return hx;
+	for (m=1; m<=nA; m++) *(hetLow+m) += *(hetLow+m-1);
 }
 
 // ------------------------------------------------------------------
-
-
-
+// Oct 2026: HetXcess evaluates all nCrit critical values in one pass over
+// the loci, instead of being called for each critical value.
+// A locus is used for critVal[n] by the same rule as in Loci_Eligible,
+// i.e., max. frequency in [critVal[n], 1-critVal[n]] and less than 1.
+// The special critical value for dropping singletons is not used in this
+// method, so nothing is assigned to entry n of output arrays in that case.
+// Sums over alleles at a locus are taken in the order of the allele list,
+// as before, so the results are the same as running critical values
+// one by one.
+// Since values for all critical values are obtained together, outputs
+// for locus data at critVal[n] (if outLoc is needed) are written to
+// temporary file hetTmp[n], to be appended to outLoc by HetPrtCrit.
+// ------------------------------------------------------------------
 void HetXcess (FISHPTR *fishList, ALLEPTR *alleList, int nloci, int nfish,
-				int nMobil[], int *missptr, char *okLoc, FILE *outLoc,
-				char moreDat, float cutoff, float *hetWSumAve, float *NeWt,
+				int nMobil[], int *missptr, char *locUse, float *maxFreq,
+				FILE *outLoc, char moreDat, FILE **hetTmp, int nCrit,
+				float critVal[], float *hetWSumAve, float *NeWt,
 				long *nIndH, float *hSamp, float *loNe, float *hiNe,
 				char param)
 {
 	float hx, NbHet;	// for each locus
-	float *wt, *hetLoc;
-	float freq;
-	int p, count, k, nA;
+	float wt, hetLoc;
+	float freq, cutoff;
+	int p, count, i, j, k, n, nA;
 // for lumping alleles
-	char quit;
-	int *smAlle;	// to hold alleles with low freq.
-	float totF, hxsm;
+	char quit, lowDone;
+	int *mVal, *rank, *hetLow;	// alleles at a locus, and their ranks
+	float *alleFreq, *alleHx;
+	float totF, hxsm, hObs, hExp;
+	int maxK = 0;
 	ALLEPTR curr;
+	FILE *outTmp;
 
 	float NbUw;			// Nb based on hetSumAve, (NeWt based on hetWSumAve)
-	long mTotal = 0;	// total alleles
-	int polyLoc = 0;	// total number of polymorphic loci
-	float hetSumAll = 0;	// sum of het. ex. of all alleles
-	float hetSumAve = 0;	// unweighted ave. of ave. het ex. across loci
-	float totWeight = 0;
-	float sumHrmonic = 0;	// unweighted harmonic average of Neb per locus,
-	float wsumHrmonic = 0;	// weighted harmonic average of Neb per locus,
+	long *mTotal;		// total alleles
+	int *polyLoc;		// total number of polymorphic loci
+	float *hetSumAll;	// sum of het. ex. of all alleles
+	float *hetSumAve;	// unweighted ave. of ave. het ex. across loci
+	float *totWeight;
+	float *sumHrmonic;	// unweighted harmonic average of Neb per locus,
+	float *wsumHrmonic;	// weighted harmonic average of Neb per locus,
 	int indAlle = 0;
 	int nlowF = 0;
 	float x, t;
 // add Jan 2012:
-	float wDsq, wSumhetSq, stdErr;
-	float totWeigSq = 0;
+	float wDsq, stdErr;
+	float *wSumhetSq, *totWeigSq;
+	char *useCrit;
 	char outCI = 0;	// set 1 for outputting CI in outLoc file for each locus,
 					// 0 otherwise
 
-// temporary add:
-/*
-float totwHetsq = 0;
-float totwHet = 0;
-float q, s, u, r1, r2;
-//*/
-	wSumhetSq = 0;
-//	float hetWSumAve = 0;	// weighted ave. of ave. het ex. across loci
-	*hetWSumAve = 0;		// weighted ave. of ave. het ex. across loci
-	*nIndH = 0;				// total indep. alleles
-	*hSamp = 0;	// harmonic mean of sample size among all poly. loci
-	hetLoc = (float*) malloc (sizeof(float)*nloci);
-	wt = (float*) malloc (sizeof(float)*nloci);
+	for (p=0; p<nloci; p++) if (*(nMobil+p) > maxK) maxK = *(nMobil+p);
+	mVal = (int*) malloc (sizeof(int)*(maxK+1));
+	rank = (int*) malloc (sizeof(int)*(maxK+1));
+	hetLow = (int*) malloc (sizeof(int)*(maxK+2));
+	alleFreq = (float*) malloc (sizeof(float)*(maxK+1));
+	alleHx = (float*) malloc (sizeof(float)*(maxK+1));
+	mTotal = (long*) malloc (sizeof(long)*nCrit);
+	polyLoc = (int*) malloc (sizeof(int)*nCrit);
+	hetSumAll = (float*) malloc (sizeof(float)*nCrit);
+	hetSumAve = (float*) malloc (sizeof(float)*nCrit);
+	totWeight = (float*) malloc (sizeof(float)*nCrit);
+	sumHrmonic = (float*) malloc (sizeof(float)*nCrit);
+	wsumHrmonic = (float*) malloc (sizeof(float)*nCrit);
+	wSumhetSq = (float*) malloc (sizeof(float)*nCrit);
+	totWeigSq = (float*) malloc (sizeof(float)*nCrit);
+	useCrit = (char*) malloc (sizeof(char)*nCrit);
+	for (n=0; n<nCrit; n++) {
+		*(hetTmp+n) = NULL;
+		// Dec 2016: no dropping only singletons in Het method:
+		*(useCrit+n) = (critVal[n] > 0 && critVal[n] <= PCRITX)? 0: 1;
+		if (*(useCrit+n) == 0) continue;
+		if (outLoc != NULL && moreDat == 1) *(hetTmp+n) = tmpfile();
+		*(mTotal+n) = 0;
+		*(polyLoc+n) = 0;
+		*(hetSumAll+n) = 0;
+		*(hetSumAve+n) = 0;
+		*(totWeight+n) = 0;
+		*(sumHrmonic+n) = 0;
+		*(wsumHrmonic+n) = 0;
+		*(wSumhetSq+n) = 0;
+		*(totWeigSq+n) = 0;
+		*(hetWSumAve+n) = 0;	// weighted ave. of ave. het ex. across loci
+		*(nIndH+n) = 0;			// total indep. alleles
+		*(hSamp+n) = 0;	// harmonic mean of sample size among all poly. loci
+	};
 
 	for (p=0; p<nloci; p++) {
-		if (*(okLoc+p) == 0) continue;	// marked by Loci_Eligible to be skipped.
+		if (*(locUse+p) == 0) continue;
 		k = *(nMobil+p);
 		if (k < 2) continue;
-		smAlle = (int*) malloc (sizeof(int)*k);
-
 		// number of samples having data at locus (p+1):
 		count = nfish - (*(missptr+p));
-		nA = 0;
-		*(hetLoc+p) = 0;
-		*(wt+p) = 0;
-		indAlle = 0;
-		nlowF = 0;
-		quit = 1;
-		totF = 0;
-// add Jan 2012:
-		wDsq = 0;
-		for (curr = *(alleList+p); curr != NULL; curr = curr->next)
+		// collect alleles at this locus once, in the order of the list,
+		for (i=0, curr = *(alleList+p); curr != NULL; curr = curr->next, i++)
 		{
-			if (*(nMobil+p) < 2) continue;
-			freq = curr->freq;
-			if (freq == 0 || freq > 1-cutoff) continue;
-			if (freq < cutoff) {
-				*(smAlle+nlowF) = curr->mValue;
-				nlowF++;		// increment # of low freq. alleles
-				totF += freq;	// accumulate their freq.
-				hxsm = curr->hetx;
-				continue;
+			*(mVal+i) = curr->mValue;
+			*(alleFreq+i) = curr->freq;
+			*(alleHx+i) = curr->hetx;
+		};
+		// then rank them by frequencies: rank[i] = number of alleles
+		// having smaller positive frequencies than allele i, ties by list
+		// order. An allele of zero frequency is never lumped, rank k.
+		for (i=0; i<k; i++) {
+			*(rank+i) = k;
+			if (*(alleFreq+i) == 0) continue;
+			*(rank+i) = 0;
+			for (j=0; j<k; j++) {
+				if (*(alleFreq+j) == 0) continue;
+				if (*(alleFreq+j) < *(alleFreq+i) ||
+					(*(alleFreq+j) == *(alleFreq+i) && j < i)) (*(rank+i))++;
 			};
-			nA++;	// increment the # of alleles used in calculating D
-					// this allele has freq >= cutoff and <= 1-cutoff
-			hx = curr->hetx;
-			*(hetLoc+p) += hx;
-		// add Jan 2012:
-			wDsq += (hx*hx);
-			quit = 0;	// this locus has at least 1 accepted allele
-		};	// went through all alleles at locus (p+1)
-		if (quit == 1) {
-			free (smAlle);
-			continue;
 		};
-		if (nlowF > 0) nA++;	// increase total alleles because all
-								// low freq alleles are lumped together
-	// change in Jan 2012, set hx to be the value of HetxLow, *(hetLoc+p)
-	// is incremented by hx, same result as before, and now, increment
-	// wDsq by (hx)^2:
-		if (nlowF > 0) {	// fishList is not allocated if no critical value
-		// other than 0+. In such case, nlowF = 0, and (fishList+p) is not
-		// allocated, so this condition is to avoid referring to (fishList+p)
-			hx = HetxLow ((fishList+p), nlowF, hxsm, smAlle, totF, count);
-			*(hetLoc+p) += hx;
-			wDsq += (hx*hx);
-		};
-		free (smAlle);
+		lowDone = 0;
+		for (n=0; n<nCrit; n++) {
+			if (*(useCrit+n) == 0) continue;
+			cutoff = critVal[n];
+		// same as okLoc assigned by Loci_Eligible at this cutoff
+			if ((*(maxFreq+p) <= 0) || (*(maxFreq+p) < cutoff) ||
+				(*(maxFreq+p) > 1.0F - cutoff) || (*(maxFreq+p) >= 1.0F))
+				continue;
+			nA = 0;
+			hetLoc = 0;
+			wt = 0;
+			indAlle = 0;
+			nlowF = 0;
+			quit = 1;
+			totF = 0;
+// add Jan 2012:
+			wDsq = 0;
+			for (i=0; i<k; i++) {
+				freq = *(alleFreq+i);
+				if (freq == 0 || freq > 1-cutoff) continue;
+				if (freq < cutoff) {
+					nlowF++;		// increment # of low freq. alleles
+					totF += freq;	// accumulate their freq.
+					hxsm = *(alleHx+i);
+					continue;
+				};
+				nA++;	// increment the # of alleles used in calculating D
+						// this allele has freq >= cutoff and <= 1-cutoff
+				hx = *(alleHx+i);
+				hetLoc += hx;
+			// add Jan 2012:
+				wDsq += (hx*hx);
+				quit = 0;	// this locus has at least 1 accepted allele
+			};	// went through all alleles at locus (p+1)
+			if (quit == 1) continue;
+			if (nlowF > 0) nA++;	// increase total alleles because all
+									// low freq alleles are lumped together
+		// change in Jan 2012, set hx to be the value for lumped alleles,
+		// hetLoc is incremented by hx, and wDsq by (hx)^2.
+		// If there is only one low freq. allele, hx is its own het. excess.
+		// fishList is not allocated if no critical value other than 0+.
+		// In such case, nlowF = 0, and (fishList+p) is not referred to.
+			if (nlowF > 0) {
+				if (nlowF == 1) hx = hxsm;
+				else {
+				// the low freq. alleles are the nlowF alleles of lowest
+				// ranks, so their heterozygotes are in hetLow[nlowF]:
+					if (lowDone == 0) {
+						HetLowCount ((fishList+p), k, mVal, rank, hetLow);
+						lowDone = 1;
+					};
+					hObs = (float) (*(hetLow+nlowF)) /((float) count);
+					hExp = HetExp (totF, count);
+					hx = (hObs - hExp)/(hExp);
+					if (fabs(hx) < EPSILON) hx = 0.0;
+				};
+				hetLoc += hx;
+				wDsq += (hx*hx);
+			};
 // Put condition nA > 0 just in case this locus has no allele freq accepted,
 // but it may be redundant because quit should be 0:
-		if (nA > 0) indAlle = nA - 1;
-		else indAlle = 0;
-		*nIndH += indAlle;
-
-// temporary add
-/*
-q = (float) nA;
-s = (float) count;
-u = ((q - 1.0F)/q)*((float)sqrt(s));
-s = u*wDsq;
-t = u*(*(hetLoc+p));
-totwHetsq += s; // will be sum{i}sum{j} of w_{ij} d_{ij}^2 in the paper
-totwHet += t;  // will be sum{i}sum{j} of w_{ij} d_{ij} in the paper
-//*/
-		HetSumUp (&hetSumAll, &hetSumAve, hetWSumAve, (hetLoc+p), (wt+p),
-					&totWeight, &NbHet, &sumHrmonic, &wsumHrmonic,
-					&polyLoc, &mTotal, nA, count, hSamp, &totWeigSq,
-					&wDsq, &wSumhetSq);
-// now, *(hetLoc+p) is mean of hets, *wDsq is mean of het^2, at locus (p+1),
-// *(wt+p) is the weight of locus (p+1).
-		if (outLoc != NULL && (moreDat == 1)) {
-			x = *(wt+p);
+			if (nA > 0) indAlle = nA - 1;
+			else indAlle = 0;
+			*(nIndH+n) += indAlle;
+
+			HetSumUp ((hetSumAll+n), (hetSumAve+n), (hetWSumAve+n), &hetLoc,
+						&wt, (totWeight+n), &NbHet, (sumHrmonic+n),
+						(wsumHrmonic+n), (polyLoc+n), (mTotal+n), nA, count,
+						(hSamp+n), (totWeigSq+n), &wDsq, (wSumhetSq+n));
+// now, hetLoc is mean of hets, wDsq is mean of het^2, at locus (p+1),
+// wt is the weight of locus (p+1).
+			if ((outTmp = *(hetTmp+n)) != NULL) {
+				x = wt;
 // add more outputs in Aug 2012:
-			t = (x*x)/((float)nA);	// equals to sum of (allele-weight)^2
-			// this was calculated in HetSumUp, recall here since we want to
-			// add to output for outLoc (can have as parameter in HetSumUp)
-			if (polyLoc == 1) {
-				PrtLines (outLoc, 79, '=');
-				HetForeword (outLoc);
-				if (outCI == 1)
-					fprintf (outLoc, "\nLocus  #smp. #alle.   Dm     Dm2      Wt     "
-						"  Wt2     N[eb]        95%% CI\n");
+				t = (x*x)/((float)nA);	// equals to sum of (allele-weight)^2
+				// this was calculated in HetSumUp, recall here since we want
+				// to add to output for outLoc (can have as parameter in HetSumUp)
+				if (*(polyLoc+n) == 1) {
+					PrtLines (outTmp, 79, '=');
+					HetForeword (outTmp);
+					if (outCI == 1)
+						fprintf (outTmp, "\nLocus  #smp. #alle.   Dm     Dm2      Wt     "
+							"  Wt2     N[eb]        95%% CI\n");
 // headline includes details but no CI:
-				else fprintf (outLoc, "\nLocus  #smp. #alle.   Dm     Dm2      Wt      "
-					"Dm*Wt   Dm2*Wt      Wt2     N[eb]\n");
-			};
-			if (outCI == 1) {
-			// calculate Standard Error for the average D at this locus
-				stdErr = (wDsq - (*(hetLoc+p))*(*(hetLoc+p)))/((float) indAlle);
-				if (stdErr < 0) stdErr = 0;
-				else stdErr = (float) sqrt(stdErr);
-				CI_t_DistHet (indAlle, *(hetLoc+p), stdErr, loNe, hiNe, 1);
-				fprintf (outLoc, "%5d%6d%5d%9.4f%8.4f%8.2f%10.1f",
-					(p+1), count, nA, *(hetLoc+p), wDsq, x, t);
-				if (NbHet < INFINITE) fprintf (outLoc, "%9.1f", NbHet);
-				else fprintf (outLoc, "%9s", "INF");
-				if ((*loNe > 0) && (*loNe < INFINITE))
-					fprintf (outLoc, "%9.1f", *loNe);
-				else fprintf (outLoc, "%9s", "INF");
-				if ((*hiNe > 0) && (*hiNe < INFINITE))
-					fprintf (outLoc, "%9.1f", *hiNe);
-				else fprintf (outLoc, "%9s", "INF");
-//fprintf (outLoc, "%10.4f", stdErr);
-				fprintf (outLoc, "\n");
-			} else {
+					else fprintf (outTmp, "\nLocus  #smp. #alle.   Dm     Dm2      Wt      "
+						"Dm*Wt   Dm2*Wt      Wt2     N[eb]\n");
+				};
+				if (outCI == 1) {
+				// calculate Standard Error for the average D at this locus
+					stdErr = (wDsq - hetLoc*hetLoc)/((float) indAlle);
+					if (stdErr < 0) stdErr = 0;
+					else stdErr = (float) sqrt(stdErr);
+					CI_t_DistHet (indAlle, hetLoc, stdErr, (loNe+n), (hiNe+n), 1);
+					fprintf (outTmp, "%5d%6d%5d%9.4f%8.4f%8.2f%10.1f",
+						(p+1), count, nA, hetLoc, wDsq, x, t);
+					if (NbHet < INFINITE) fprintf (outTmp, "%9.1f", NbHet);
+					else fprintf (outTmp, "%9s", "INF");
+					if ((*(loNe+n) > 0) && (*(loNe+n) < INFINITE))
+						fprintf (outTmp, "%9.1f", *(loNe+n));
+					else fprintf (outTmp, "%9s", "INF");
+					if ((*(hiNe+n) > 0) && (*(hiNe+n) < INFINITE))
+						fprintf (outTmp, "%9.1f", *(hiNe+n));
+					else fprintf (outTmp, "%9s", "INF");
+					fprintf (outTmp, "\n");
+				} else {
 // output includes details but no CI:
-				fprintf (outLoc,
-					"%5d%6d%5d%9.4f%8.4f%8.2f%10.4f%9.4f%10.1f",
-					(p+1), count, nA, *(hetLoc+p), wDsq, x, (*(hetLoc+p))*x,
-					wDsq*x, t);
-				if (NbHet < INFINITE) fprintf (outLoc, "%9.1f\n", NbHet);
-				else fprintf (outLoc, "%9s\n", "INF");
+					fprintf (outTmp,
+						"%5d%6d%5d%9.4f%8.4f%8.2f%10.4f%9.4f%10.1f",
+						(p+1), count, nA, hetLoc, wDsq, x, hetLoc*x,
+						wDsq*x, t);
+					if (NbHet < INFINITE) fprintf (outTmp, "%9.1f\n", NbHet);
+					else fprintf (outTmp, "%9s\n", "INF");
+				};
 			};
-
-// previous output, no wt2 item:
-//			if (outLoc != NULL && (moreDat == 1)) fprintf (outLoc,
-//			"%5d%8d%12.4f%11.2f%12.1f\n", (p+1), nA, *(hetLoc+p), *(wt+p), NbHet);
-		};
+		};	// end of "for (n=0; n<nCrit; n++)"
 	};
+
+	for (n=0; n<nCrit; n++) {
+		if (*(useCrit+n) == 0) continue;
 // after calling HetAverage, hetWSumAve becomes the overall D-value,
 // NeWt will be the output of Nb in the main output file
-	t = *hetWSumAve;	// hold value for *hetWSumAve since it will be changed
-	HetAverage (polyLoc, mTotal, &hetSumAll, &hetSumAve,
-				hetWSumAve, &NbUw, &sumHrmonic, &wsumHrmonic, totWeight, NeWt,
-				hSamp, *nIndH, totWeigSq, wSumhetSq, &stdErr);
-// Corresponding parameter names listed in HetAverage
-// locPoly = polyLoc, mTotal (same), *dSum = &hetSumAll, *dXSum = &hetSumAve,
-// *dXWSum = hetWSumAve (hetWSumAve is a pointer, parameter), *NbUw = &NbUw,
-// *NbH = &sumHrmonic, *NbHW = &wsumHrmonic, dWtotal = totWeight,
-// *NeWt = NeWt, *hSamp = hSamp, (NeWt, hSamp are pointers, parameters)
-// nInd =  *nIndH (nInd is a pointer, parameter),
-// the rest have same names.
-
+		t = *(hetWSumAve+n);	// hold value for hetWSumAve since it will change
+		HetAverage (*(polyLoc+n), *(mTotal+n), (hetSumAll+n), (hetSumAve+n),
+					(hetWSumAve+n), &NbUw, (sumHrmonic+n), (wsumHrmonic+n),
+					*(totWeight+n), (NeWt+n), (hSamp+n), *(nIndH+n),
+					*(totWeigSq+n), *(wSumhetSq+n), &stdErr);
 // for 95% confidence interval:
-//	mTotal -= polyLoc;	// represent degree of freedom
+		CI_t_DistHet (*(nIndH+n), *(hetWSumAve+n), stdErr, (loNe+n),
+					(hiNe+n), 1);
+		if ((outTmp = *(hetTmp+n)) != NULL) {
+			PrtLines (outTmp, 79, '-');
+			if (outCI == 1)
+				fprintf (outTmp, "SUM:%12lu%25.2f%10.1f\n", *(mTotal+n),
+						*(totWeight+n), *(totWeigSq+n));
+			else fprintf (outTmp, "SUM:%12lu%25.2f%10.4f%9.4f%10.1f\n",
+						*(mTotal+n), *(totWeight+n), t, *(wSumhetSq+n),
+						*(totWeigSq+n));
+			PrtHetSum (outTmp, *(sumHrmonic+n), *(wsumHrmonic+n), *(NeWt+n),
+						NbUw, *(hetSumAll+n), *(hetWSumAve+n), stdErr);
+			PrtLines (outTmp, 79, '=');
+		};
+	};
+	free (mVal);
+	free (rank);
+	free (hetLow);
+	free (alleFreq);
+	free (alleHx);
+	free (mTotal);
+	free (polyLoc);
+	free (hetSumAll);
+	free (hetSumAve);
+	free (totWeight);
+	free (sumHrmonic);
+	free (wsumHrmonic);
+	free (wSumhetSq);
+	free (totWeigSq);
+	free (useCrit);
+}
 
-// temporary add
-/*
-q = (float) (*nIndH);
-r1 = (totwHetsq - (totwHet*totwHet)/totWeight)/(totWeight * q);
-s = totWeight*totWeight;
-r2 = s/(s - totWeigSq);
-x = (float) sqrt(r1*r2);
-//*/
-	CI_t_DistHet (*nIndH, *hetWSumAve, stdErr, loNe, hiNe, 1);
+// ------------------------------------------------------------------
+// Oct 2026: append the content of temporary file tmp to output, then
+// close tmp. Used when outputs are prepared ahead of their turn.
+// ------------------------------------------------------------------
+void AppendTmpCut (FILE *output, FILE *tmp, long from, long to)
+// Oct 2026: same as AppendTmp, but bytes at positions from "from" up to
+// before "to" are left out (nothing is left out if to <= from).
+// Oct 2026: copied in blocks rather than by characters.
+{
+	char block[BUFSIZ];
+	size_t n, i, j;
+	long pos;
+	if (tmp == NULL) return;
+	if (output != NULL) {
+		rewind (tmp);
+		for (pos = 0; (n = fread (block, 1, BUFSIZ, tmp)) > 0; pos += n) {
+			if (to <= from || pos+(long)n <= from || pos >= to) {
+				fwrite (block, 1, n, output);
+				continue;
+			};
+			i = (from > pos)? from-pos: 0;	// block[i] to block[j-1] cut
+			j = (to < pos+(long)n)? to-pos: n;
+			fwrite (block, 1, i, output);
+			fwrite (block+j, 1, n-j, output);
+		};
+	};
+	fclose (tmp);
+}
 
-// print to console (moved to the calling function RunPop#)
-	printf ("     Heterozygote Excess Method\n");
-	printf ("       Estimated Neb: ");
-	if (*NeWt < INFINITE) printf ("%21.1f\n", *NeWt);
-	else printf ("%21s\n", "Infinite");
-	if (outLoc != NULL && (moreDat == 1)) {
-		PrtLines (outLoc, 79, '-');
-		if (outCI == 1)
-			fprintf (outLoc, "SUM:%12lu%25.2f%10.1f\n", mTotal,
-					totWeight, totWeigSq);
-		else fprintf (outLoc, "SUM:%12lu%25.2f%10.4f%9.4f%10.1f\n", mTotal,
-					totWeight, t, wSumhetSq, totWeigSq);
-//		PrtDetailHet (outLoc, *hetWSumAve, *nIndH, totWeight, wSumhetSq, totWeigSq);
-		PrtHetSum (outLoc, sumHrmonic, wsumHrmonic, *NeWt, NbUw, hetSumAll,
-					*hetWSumAve, stdErr);
-		PrtLines (outLoc, 79, '=');
+void AppendTmp (FILE *output, FILE *tmp)
+{
+	AppendTmpCut (output, tmp, 0, 0);
+}
 
-//fprintf (outLoc, "\nStandard Error directly from formula (3) in the paper =%9.6f", x);
-	};
-	free (hetLoc);
-	free (wt);
+// ------------------------------------------------------------------
+// Oct 2026: print to console the estimate by Het. Excess at a critical
+// value, obtained from HetXcess, and move its locus data to outLoc.
+// This is called in the loop of critical values (PopCritLoop), or after it
+// if the methods run at the same time.
+// ------------------------------------------------------------------
+void HetPrtCrit (FILE *outLoc, FILE *hetTmp, float NeWt, FILE *con)
+{
+	fprintf (con, "     Heterozygote Excess Method\n");
+	fprintf (con, "       Estimated Neb: ");
+	if (NeWt < INFINITE) fprintf (con, "%21.1f\n", NeWt);
+	else fprintf (con, "%21s\n", "Infinite");
+	AppendTmp (outLoc, hetTmp);
 }
 
 // --------------------------------------------------------------------------
@@ -4986,7 +5933,8 @@ int LDConfidInt95 (float harmonic, int nfish, float wExpR2, float rB2WAve,
 //char opened,
 				char modify, float *confidL, float *confidH,
 				long *Jdegree, float infinite,
-				char mating, int mode, char moreBurr, FILE *outBurr)
+				char mating, int mode, char moreBurr, FILE *outBurr,
+				FILE *con)
 // mode = 0: parameter, 1: Jackknife.
 {
 	float lowR2, hiR2;
@@ -5001,7 +5949,7 @@ int LDConfidInt95 (float harmonic, int nfish, float wExpR2, float rB2WAve,
 //opened,
 		&lowR2, &hiR2, Jdegree) == 0)
 		{
-			printf("*** Jackknife on samples is not possible.\n");
+			fprintf (con, "*** Jackknife on samples is not possible.\n");
 			return 1;
 		}
 	} else {
@@ -5066,7 +6014,7 @@ int NeAdjustedTmp (FILE *rAveTemp,
 				long nBurrVal, float harmonic, char matingMod,
 				float infinite, float *adjNe, float *r2driftAve,
 				float *totW, float *totR2, float *totRdrift, float *expR2,
-				float *rBurrAve)
+				float *rBurrAve, FILE *con)
 // Calculate Ne based on arrays r-values, number of Ind alleles, sample size,
 // Parameter "adjNe" at input is the tentative Ne, output: new value for Ne
 // If <= 0 or too big: no adjusting.
@@ -5095,7 +6043,7 @@ int NeAdjustedTmp (FILE *rAveTemp,
 	bigR2 = 0;
 	bigRdrift = 0;
 //	rewind (rAveTemp);	// this is done in the calling function
-	printf ("     Initial estimate of Ne: %12.1f\n", *adjNe);
+	fprintf (con, "     Initial estimate of Ne: %12.1f\n", *adjNe);
 	for (ind = 0; ind < nBurrVal; ind++) {
 		// retrieve values: start with the product of ind. alleles,
 		// then sample having data at pair, Rdrift-value.
@@ -5143,7 +6091,7 @@ int NeAdjustedTmp (FILE *rAveTemp,
 	*rBurrAve = (float) bigR2;				// weighted average of r2.
 	*expR2 = (float) r2ExpW;
 	*adjNe = LD_Ne(harmonic, *r2driftAve, matingMod, infinite);
-	printf ("     Final estimate of Ne: %14.1f\n", *adjNe);
+	fprintf (con, "     Final estimate of Ne: %14.1f\n", *adjNe);
 
 // temporarily added for checking: print to file checkR2
 /*
@@ -5168,7 +6116,7 @@ int NeAdjustedArr (float *pairWt, float *rB2, float *rBdrift, float *prodInd,
 				float *sampCount, long nBurrVal, float harmonic, char matingMod,
 				float infinite, float *adjNe, float *r2driftAve,
 				float *totW, float *totR2, float *totRdrift, float *expR2,
-				float *rBurrAve)
+				float *rBurrAve, FILE *con)
 // Calculate Ne based on arrays r-values, number of Ind alleles, sample size,
 // Parameter "adjNe" at input is the tentative Ne, output: new value for Ne
 // If <= 0 or too big: no adjusting.
@@ -5185,7 +6133,7 @@ int NeAdjustedArr (float *pairWt, float *rB2, float *rBdrift, float *prodInd,
 	*totW = 0;
 	r2ExpW = 0;
 
-	printf ("     Initial estimate of Ne: %12.1f\n", *adjNe);
+	fprintf (con, "     Initial estimate of Ne: %12.1f\n", *adjNe);
 	for (ind = 0; ind < nBurrVal; ind++) {
 		// retrieve values: start with the product of ind. alleles,
 		// then sample having data at pair, Rdrift-value.
@@ -5218,7 +6166,51 @@ int NeAdjustedArr (float *pairWt, float *rB2, float *rBdrift, float *prodInd,
 	*rBurrAve = r2;
 //	*rBurrAve = (*expR2) + r2drift;	// weighted average of r^2
 	*adjNe = LD_Ne(harmonic, r2drift, matingMod, infinite);
-	printf ("     Final estimate of Ne: %14.1f\n", *adjNe);
+	fprintf (con, "     Final estimate of Ne: %14.1f\n", *adjNe);
+	return 1;
+}
+
+// --------------------------------------------------------------------------
+
+int NeAdjustedBin (LDPART part, float harmonic, char matingMod,
+				float infinite, float *adjNe, float *r2driftAve,
+				float *totW, float *totR2, float *totRdrift, float *expR2,
+				float *rBurrAve, FILE *con)
+// Oct 2026: as NeAdjustedTmp, on sums of merged shards by the number s of
+// samples having data at locus pairs (see LDShardWrite): the weight at a
+// pair is the product of ind. alleles times s^2/(3*Ne + s)^2.
+// Return 0 if no change, 1 otherwise
+{
+	int s;
+	float weight, a, b;
+	double bigW, bigR2, bigRdrift, r2ExpW;
+	a = (*adjNe)*3;
+	// to avoid overflow, quit if a is 0 or too big
+	if (a >= infinite || a <= 0) return 0;
+	r2ExpW = 0;
+	bigW = 0;
+	bigR2 = 0;
+	bigRdrift = 0;
+	for (s = 1; s <= part->nfish; s++) {
+		if (*(part->binW+s) <= 0) continue;
+		b = a + s;
+		b *= b;
+		weight = ((float) s*s)/b;
+		bigR2 += (*(part->binR2+s) * weight);
+		bigW += (*(part->binW+s) * weight);
+		bigRdrift += (*(part->binDrift+s) * weight);
+		r2ExpW += (ExpR2Samp ((float) s) * (*(part->binW+s)) * weight);
+	}
+	if (bigW <= 0) return 0;
+	fprintf (con, "     Initial estimate of Ne: %12.1f\n", *adjNe);
+	*totR2 = (float) bigR2;
+	*totW = (float) bigW;
+	*totRdrift = (float) bigRdrift;
+	*r2driftAve = (float) (bigRdrift/bigW);	// weighted average of r2-drift.
+	*rBurrAve = (float) (bigR2/bigW);			// weighted average of r2.
+	*expR2 = (float) (r2ExpW/bigW);
+	*adjNe = LD_Ne(harmonic, *r2driftAve, matingMod, infinite);
+	fprintf (con, "     Final estimate of Ne: %14.1f\n", *adjNe);
 	return 1;
 }
 
@@ -5759,6 +6751,25 @@ void AlleInSamp (int nfish, int m, int **pGen, int *noDatFish, char *countm)
 }
 
 
+// --------------------------------------------------------------------------
+
+void Burrows_Coef (float f1, float f2, float x, float y, float nSamp,
+					float pSum, float *dBur, float *rBur, float *rBur2)
+// Oct 2026: Burrows coefficients from pSum, the number of allele pairs
+// m1, m2 counted in samples (see Burrows_Delta), from there on.
+{
+	*dBur = 0;
+	if (nSamp > 0) *dBur = pSum /((float) 2.0*nSamp) - 2.0*f1*f2;
+	// (unbias) adjusting factor: nSamp/(nSamp-1)
+	if (nSamp > 1) *dBur *= (nSamp/(nSamp -(float) 1.0));
+//	Note: The condition x,y > 0 must hold before this function is called
+	*rBur = (*dBur)/sqrt(x*y);
+   	*rBur2 = (*rBur)*(*rBur);
+	// although absolute value of rBur is at most 1 if not for the factor
+	// nSamp/(nSamp-1) applied to "dBur" above, so we bring back to 1
+	if (*rBur2 > 1.0) *rBur2 = 1.0;
+}
+
 // --------------------------------------------------------------------------
 
 void Burrows_Delta (float f1, float f2, float x, float y,
@@ -5794,15 +6805,7 @@ void Burrows_Delta (float f1, float f2, float x, float y,
 	for (countM = 0, i = 0; i < nfish; i++)
 			countM += (countm1[i]*countm2[i]);
 	*pSum = (float) countM;
-	if (nSamp > 0) *dBur = *pSum /((float) 2.0*nSamp) - 2.0*f1*f2;
-	// (unbias) adjusting factor: nSamp/(nSamp-1)
-	if (nSamp > 1) *dBur *= (nSamp/(nSamp -(float) 1.0));
-//	Note: The condition x,y > 0 must hold before this function is called
-	*rBur = (*dBur)/sqrt(x*y);
-   	*rBur2 = (*rBur)*(*rBur);
-	// although absolute value of rBur is at most 1 if not for the factor
-	// nSamp/(nSamp-1) applied to "dBur" above, so we bring back to 1
-	if (*rBur2 > 1.0) *rBur2 = 1.0;
+	Burrows_Coef (f1, f2, x, y, nSamp, *pSum, dBur, rBur, rBur2);
 
 }
 
@@ -5869,738 +6872,481 @@ char r2Default (float nSamp, float frac, float f1x, float homo1,
 }
 
 // ---------------------------------------------------------------------------
-// Modified Dec 2016:
-// Add a local variable cutoffRev to be parameter of IndAlle2, and reset
-// cutoff = cutoffRev. When Burrows_Calcul is called again for another
-// locus pair, cutoff as parameter of Burrows_Calcul is still the old one.
-void Burrows_Calcul (float cutoff, ALLEPTR allep1, ALLEPTR allep2,
-                FISHPTR popLoc1, FISHPTR popLoc2, int p1, int p2,
-                int nMp1, int nMp2, int nfish, float *nSamp,
-                int *nInd1, int *nInd2, int *nMpairs, float *rB,
-                int currPop, int *missptr, FILE *outBurr,
-                char *outBurrName, char moreBurr, char BurrPause,
-                float *expR2, char weighsmp,
-// add in Nov 2014/ Jan 2015/ Mar 2015:
-                char sepBurOut, char moreCol, char BurAlePair,
-// add Mar 2016:
-// unidented variables are for checking, remove them together with those in
-// LDRunPairs, Pair_Analysis, LDMethod, etc., later:
-// for checking with checkR2
-//char *opened,
-                char jack, int **p1Gen, int **p2Gen, int *noDatFish,
-                char *countm1, char *countm2,
-                int *mValp1, float *freqp1, float *homop1,
-                int *mValp2, float *freqp2, float *homop2,
-                float *r2AtPairX,
-// temporarily add for checking with checkR2:
-//double *r2JackTot,
-                float *JweighPair,
-                unsigned long long *r2Count, float epsilon)
-
-// calculate Burrows coefficients for a pair of loci (p1, p2).
-// nMp1, nMp2: number of alleles at loci p1, p2
-// added in Sept 2011 parameter BurrPause
-// weighsmp to denote if the population has missing data
-// epsilon is a small number, used to check some rational number should be 0
-
-// r2AtPairX is array of r^2 calculated at this locus pair, for each sample
-// set where one sample is removed from S. Name such sample set as S# or Sk
-// (when sample k is removed); there are "nfish" such sets.
-// So r2AtPairX[k] = average of r^2 over all allele pairs at locus pair
-// (p1, p2) for sample set Sk.
-//
-// r2JackTot contains the sum of r^2 up to this locus pair (p1, p2), for
-// each sample set S#.
-//
-// JweighPair contains product of independent alleles at each S#;
-// this is used for calculating weighted average of r^2 in each S#.
-// r2Count is the number of r^2 evaluated for each sample set S#. Some sample
-// set S# may not have r^2 calculated (ineligible for Burrows calculations)
-{
-
-	int i, j, k, nEff1, nEff2;
-	int countM, m1, m2;
-	char writeBur;
-	float f1, f2, x, xy;
-	float varp1;
-	float dBur, rBur, rBur2;
-	float rMean, dBurMean, r2Mean;   // for averages of rBur and dBur, r2Mean
-	// *rB = r2Mean is the output for average of rBur2 (square of rBur)
-	// Added in Nov 2014 for min freq at loci p1, p2:
-	float fminp1, fminp2;
-// add cutoffRev in Dec 2016, for reassigning cutoff value:
-	float cutoffRev;
-
-	IndAlle2 (p1Gen, p2Gen, noDatFish, popLoc1, popLoc2, cutoff, nfish,
-			allep1, allep2, nMp1, nMp2, &nEff1, mValp1, &nEff2, mValp2,
-			nSamp, freqp1, homop1, freqp2, homop2, nInd1, nInd2,
-			weighsmp, &fminp1, &fminp2, &cutoffRev);
-// Dec 2016: the rest use cutoff, so we don't want to go to change them,
-// just set cutoff to be this reassignment when cutoff is a special value
-// for dropping singletons (old cutoff is still unchanged when this exits):
-	cutoff = cutoffRev;
-
-// nInd1, nInd2 are the number of alleles having freq > cutoff
-// when measured against samples having data at both loci p1, p2.
-// However, if there are no freq <= cutoff, nIndJ will be the number
-// of alleles at locus J, less 1 (since the sum of freq = 1, only nIndJ
-// values of freq are needed in this case, the one left is then known).
-// They are defined as numbers of independent alleles at loci p1, p2
-// taken against samples having data at both lci.
-// nEff1 and nEff2 are the number of alleles in loci p1, p2 whose
-// freqs are between cutoff and < 1. Allele having frequency (1-cutoff) and
-// above is not counted. Those alleles (counted nEff1, nEff2) are used in
-// calculating Burrows coeffs. We have nInd1 <= nEff1, nInd2 <= nEff2.
-
-// nInd1 < nEff1: no allele being dropped (no allele having freq < cutoff)
-// Similarly for nInd2 < nEff2.
-
-// Added in Jan 2016:
-	float rowSum;
-	char rSkip1, rSkip2, rSkip, dSkip;
-// Add in March 2016:
-	float pSum, pSumx, rBur2x, f1x, f2x, var1, var2;
-	char reject;
-	char rSet;
-	float frac, frac2, dBurx;
-
-/* **********************************************************************
-   The following can be proved mathematically.
-   (dBur, rBur are Burrows disequilibrium and correlation, rBur2 = (rBur)^2.)
-   (1) nInd1 < nEff1 and nInd2 < nEff2 (no allele dropped).
-        Then dBurMean = 0.
-    a. If nEff1 = 2 (=> nInd1 = 1), there are only 2 alleles A1, A2
-       at locus p1, then the Burrows coefficients dBur, rBur for
-       the two pairs of loci (A1,B), (A2,B) are equal in absolute value
-       and of opposite signs for any allele B at the other locus.
-       Similarly for nEff2 = 2.
-    b. If both nEff1 = 2 and nEff2 = 2 (each locus has 2 alleles),
-       then average of rBur2 (square of rBur), which is one of returned
-       value *rB, is any rBur2 at one of the 4 pairs.
-   (2) nInd1 < nEff1 and nInd2 = nEff2, no allele dropped at locus
-    p1 but some are dropped at locus p2.
-        Then dBurMean = 0 (averaged over all eligible locus pairs).
-        If also nEff1 = 2, then we have a similar result as in (1)a.
-        It follows that rMean = 0.
-        Similar results are for nInd1 = nEff1 and nInd2 < nEff2.
+// Oct 2026: Burrows_Calcul is compiled from burcalc.h in variants, for
+// jackknife on samples or not, missing data or not, Burrows outputs or
+// not, so its loops on alleles and samples carry no tests on those.
+#define BC_NAME	BurCalc_N
+#define BC_JACK	0
+#define BC_MISS	0
+#define BC_OUT	0
+#include "burcalc.h"
+
+#define BC_NAME	BurCalc_J
+#define BC_JACK	1
+#define BC_MISS	0
+#define BC_OUT	0
+#include "burcalc.h"
+
+#define BC_NAME	BurCalc_JM
+#define BC_JACK	1
+#define BC_MISS	1
+#define BC_OUT	0
+#include "burcalc.h"
+
+#define BC_NAME	BurCalc_O
+#define BC_JACK	0
+#define BC_MISS	0
+#define BC_OUT	1
+#include "burcalc.h"
+
+#define BC_NAME	BurCalc_JO
+#define BC_JACK	1
+#define BC_MISS	0
+#define BC_OUT	1
+#include "burcalc.h"
+
+#define BC_NAME	BurCalc_JMO
+#define BC_JACK	1
+#define BC_MISS	1
+#define BC_OUT	1
+#include "burcalc.h"
 
-*/
-// **********************************************************************
+//-------------------------------------------------------------------------
 
-// nMpairs is the number of allele pairs at locus pair (p1, p2) at which
-// Burrows coefficients are calculated; nInd1*nInd2 is number of ind. alleles
-	*nMpairs = nEff1 * nEff2;
+BURCALC BurCalcPick (char jack, char weighsmp, char out)
+// Oct 2026: variant of Burrows_Calcul for a population at a critical value:
+// jack != 0 for jackknife on samples, weighsmp != 0 if there are missing
+// data, out = 1 if Burrows coefficients are written (outBurr != NULL and
+// moreBurr = 1). Callers going over locus pairs pick it once.
+{
+	if (out == 1) {
+		if (jack == 0) return BurCalc_O;
+		return (weighsmp != 0)? BurCalc_JMO: BurCalc_JO;
+	}
+	if (jack == 0) return BurCalc_N;
+	return (weighsmp != 0)? BurCalc_JM: BurCalc_J;
+}
 
-	*rB = 0;
-	*expR2 = ExpR2Samp(*nSamp);
-// added in Sept 2011 to prevent division by zero:
-	if (*nMpairs <= 0) return;
+//-------------------------------------------------------------------------
 
-// write to Burrows file, add BurrPause in Sept 2011, BurAlePair in Apr 2015:
-	writeBur = (outBurr != NULL && moreBurr == 1 && BurrPause == 0)? 1: 0;
-	if (writeBur == 1  && BurAlePair == 1)
-	{
-		if (sepBurOut == 0) {
-			fprintf (outBurr, "\n      Pop.    Loc._Pairs   Allele_Pairs    P1"
-			"    P2    Burrows->D       r         r^2\n");
-		fprintf (outBurr, "   ");
-        PrtLines (outBurr, 85, '-');
-//  	} else {
-//          fprintf (outBurr, "\nLoc._Pairs   Allele_Pairs    P1"
-//          "    P2    Burrows->D       r         r^2\n");
+void Burrows_Calcul (float cutoff, ALLEPTR allep1, ALLEPTR allep2,
+				FISHPTR popLoc1, FISHPTR popLoc2, int p1, int p2,
+				int nMp1, int nMp2, int nfish, float *nSamp,
+				int *nInd1, int *nInd2, int *nMpairs, float *rB,
+				int currPop, int *missptr, FILE *outBurr,
+				char *outBurrName, char moreBurr, char BurrPause,
+				float *expR2, char weighsmp,
+				char sepBurOut, char moreCol, char BurAlePair,
+				char jack, int **p1Gen, int **p2Gen, int *noDatFish,
+				char *countm1, char *countm2,
+				int *mValp1, float *freqp1, float *homop1,
+				int *mValp2, float *freqp2, float *homop2,
+				float *r2AtPairX, float *JweighPair,
+				unsigned long long *r2Count, float epsilon)
+// Oct 2026: calculate Burrows coefficients at locus pair (p1, p2) by the
+// variant for the flags, see burcalc.h, for callers at a single pair.
+{
+	BURCALC calc = BurCalcPick (jack, weighsmp,
+							(outBurr != NULL && moreBurr == 1)? 1: 0);
+	(*calc) (cutoff, allep1, allep2, popLoc1, popLoc2, p1, p2, nMp1, nMp2,
+			nfish, nSamp, nInd1, nInd2, nMpairs, rB, currPop, missptr,
+			outBurr, outBurrName, moreBurr, BurrPause, expR2, weighsmp,
+			sepBurOut, moreCol, BurAlePair, jack, p1Gen, p2Gen, noDatFish,
+			countm1, countm2, mValp1, freqp1, homop1, mValp2, freqp2,
+			homop2, r2AtPairX, JweighPair, r2Count, epsilon);
+}
+//-------------------------------------------------------------------------
+
+void IndAlleStat (float cutoff, float nSamp, int nAlle, int *copy,
+				int *homo, int *nEff, int *aIdx, float *freq, float *homop,
+				int *nInd)
+// Oct 2026: as IndAlle2 at one locus of a pair, from copies copy[a] and
+// homozygotes homo[a] of its alleles a = 0, ..., nAlle-1 in samples having
+// data at both loci, see PairStatSave. Alleles taken are aIdx[0], ...,
+// aIdx[nEff-1], with frequencies freq and homozygote frequencies homop.
+{
+	int a, n, ndrop, nMp;
+	float x;
+	for (a = 0, n = 0, ndrop = 0, nMp = 0; a < nAlle; a++) {
+		if (*(copy+a) == 0) continue;	// not in those samples
+		nMp++;
+		x = (float) *(copy+a)/(2*nSamp);
+		if (x < cutoff) ndrop++;
+		else if (x < 1 && x <= 1 - cutoff) {
+			*(aIdx+n) = a;
+			*(freq+n) = x;
+			*(homop+n) = (float) *(homo+a)/nSamp;
+			n++;
 		}
-		fflush (outBurr);
 	}
+	*nEff = n;
+	if (ndrop > 0) nMp -= ndrop;
+	else nMp--;
+	if (n == 0) nMp = 0;
+	*nInd = nMp;
+}
+
+//-------------------------------------------------------------------------
 
-	rMean= 0.0; dBurMean= 0.0, r2Mean = 0.0;
-	// rSkip# = 1 if exactly 2 alleles at the locus, and no allele dropped.
-	// Either rSkip1 = 1 or rSkip2 = 1 will imply that the sum of
-	// coefficients rBur across all pairs of loci is zero
+void Burrows_Stat (float cutoff, PAIRSTAT stat, float *nSamp, int *nInd1,
+				int *nInd2, int *nMpairs, float *rB, float *expR2,
+				int *aIdx1, float *freqp1, float *homop1,
+				int *aIdx2, float *freqp2, float *homop2, float epsilon)
+// Oct 2026: same as Burrows_Calcul without jackknife on samples and
+// Burrows outputs, at the locus pair last read in stat (see PairStatNext):
+// the same steps on allele pairs, with pSum taken from the joint counts.
+{
+	int i, j, nEff1, nEff2, nA2;
+	int *copy1, *homo1, *copy2, *homo2, *joint;
+	char rSkip1, rSkip2;
+	float f1, f2, x, xy, varp1, t, pSum, rowSum, r2Mean;
+	float dBur = 0, rBur = 0, rBur2 = 0;
+	float *varp2, *colSum, *rRow, *r2Row;
+
+	nA2 = stat->nA2;
+	copy1 = stat->count;
+	homo1 = copy1 + stat->nA1;
+	copy2 = homo1 + stat->nA1;
+	homo2 = copy2 + nA2;
+	joint = homo2 + nA2;
+	*nSamp = (float) stat->nSamp;
+	if (*nSamp > 0 && cutoff > 0 &&  cutoff <= PCRITX) {
+		x = 2*(*nSamp) - 1;
+		if (*nSamp > 2) x -= 1.5;
+		cutoff = 1.0/x;
+	}
+	IndAlleStat (cutoff, *nSamp, stat->nA1, copy1, homo1, &nEff1, aIdx1,
+				freqp1, homop1, nInd1);
+	IndAlleStat (cutoff, *nSamp, nA2, copy2, homo2, &nEff2, aIdx2,
+				freqp2, homop2, nInd2);
+	*nMpairs = nEff1 * nEff2;
+	*rB = 0;
+	*expR2 = ExpR2Samp(*nSamp);
+	if (*nMpairs <= 0) return;
 	rSkip1 = ((*nInd1<nEff1) && (nEff1==2))? 1: 0;
 	rSkip2 = ((*nInd2<nEff2) && (nEff2==2))? 1: 0;
-	rSkip = rSkip1 + rSkip2;
-	// rSkip > 0 implies that the sum of rBur will be zero.
-	dSkip = ((*nInd1<nEff1) || (*nInd2<nEff2))? 1: 0;
-	// dSkip > 0 implies that the sum of dBur will be zero;
-	// rSkip > 0 implies that dSkip > 0.
-	// Thus, if rSkip > 0, sum of dBur and sum of rBur will be zero,
-	// no need to keep track their sums for their averages dBurMean, rMean
-
-	frac = 1.0/(*nSamp - 1); // *nSamp > 1 is known
-	frac2 = frac/2.0;
-
-	dBurMean = 0;
-	rMean = 0;
-	if (rSkip == 2) {    // each locus has 2 alleles, none is dropped
-		m1 = *mValp1;
+	if (rSkip1 + rSkip2 == 2) {	// each locus has 2 alleles, none dropped
 		f1 = *freqp1;
 		varp1 =  f1 * (float) (1.0 - 2*f1) + (*homop1);
-		m2 = *mValp2;
 		f2 = *freqp2;
-		float t =  f2 * (float) (1.0 - 2*f2) + (*homop2);
-		if ((varp1 < epsilon) || (t < epsilon)) { // => varp1 = 0 or t = 0
-			dBur = 0;   // varp1 = 0 or t = 0: heterozygote throughout with
-			rBur = 0;   // m1 at loc p1, or with m2 at loc p2
-			rBur2 = 0;
-// for jackknife on samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-        // for any sample removed, same thing applies to the remaining:
-        // r^2 = 0 for each sample set with one removed,
-        // only the number of r^2 evaluated is increased
-			if (jack != 0) {
-				for (k = 0; k< nfish; k++) {
-					r2Count[k]++;
-					r2AtPairX[k] = 0;
-					JweighPair[k] = 1;
-				}
-			}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-		} else {    // in this case, we have *nSamp >= 2 (otherwise, only one
-    // sample having data at 2 loci, implying it is heterozygote (varp1=t=0)
-			AlleInSamp (nfish, m1, p1Gen, noDatFish, countm1);
-			AlleInSamp (nfish, m2, p2Gen, noDatFish, countm2);
-			Burrows_Delta (f1, f2, varp1, t, *nSamp, nfish,
-				 &dBur, &rBur, &rBur2, &pSum, countm1, countm2);
-	// The rest of this "else" are for jackknife on Samples
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-			if (jack != 0) {
-				for (k = 0; k < nfish; k++) {
-        // for each sample (k+1) removed, let's call the rest as Sk
-        // This loop calculates r^2 at each sample set Sk
-					if (noDatFish[k] > 0) {		// sample (k+1)th has no data
-						r2AtPairX[k] = rBur2;	// same r^2 when removing it
-// temporarily add for checking with checkR2:
-//r2JackTot[k] += rBur2;
-						r2Count[k]++;
-						JweighPair[k] = 1;
-					} else {
-						reject = Rejected(cutoff, *nSamp,f1,countm1[k], &f1x)
-							+ Rejected (cutoff, *nSamp,f2, countm2[k], &f2x);
-				// if reject = 0: both alleles are accepted
-						if (reject == 0) {
-							rSet = r2Default (*nSamp, frac, f1x, *homop1,
-									countm1[k], f2x, *homop2, countm2[k],
-									&var1, &var2, epsilon);
-				// rSet = 0 when var1 or var2 = 0, then r^2 = 0 on Sk
-							if (rSet != 0) {
-								dBurx = pSum - countm1[k]*countm2[k];
-								dBurx *= frac2;
-								dBurx -= (2*f1x*f2x);   // Burrows for Sk
-								if (*nSamp > 2.5)   // i.e., is at least 3
-						// adjust Burrows disequilibrium by a factor
-								dBurx = dBurx *((*nSamp-1)/(*nSamp-2));
-								rBur2x = (dBurx*dBurx)/(var1*var2);
-								if (rBur2x > 1.0) rBur2x = 1.0; // pull back!
-								r2AtPairX[k] = rBur2x;
-// temporarily add for checking with checkR2:
-//r2JackTot [k] += rBur2x;    // r^2 for Sk
-							}
-							r2Count[k]++;
-							JweighPair[k] = 1;
-						} else {	// this pair of loci is rejected in Sk
-							JweighPair[k] = 0;
-							r2AtPairX[k] = 0;
-						} // end of "if (reject == 0) ... else"
-				// if reject != 0, no r^2 on Sk, r2Count[k] not increased
-					}   // end of "if (noDatFish[k] > 0) ... else ..."
-				}   // end of "for (k = 0; k< nfish; k++)"
-			}   // end of "if (jack != 0)"
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-		}   // end of "if ((varp1 < epsilon) || (t < epsilon)) ... else ..."
+		t =  f2 * (float) (1.0 - 2*f2) + (*homop2);
+		if ((varp1 >= epsilon) && (t >= epsilon)) {
+			pSum = (float) *(joint + (*aIdx1)*nA2 + (*aIdx2));
+			Burrows_Coef (f1, f2, varp1, t, *nSamp, pSum,
+						&dBur, &rBur, &rBur2);
+		}
 		*rB = rBur2;
-// write to auxiliary file here
-		if (writeBur == 1) {
-// This next line is for testing purpose only, comment out later
-//fprintf (outBurr, "Short cut\n");
-			if (BurAlePair == 1)
-			{
-				for(i = 0; i < 2; i++) {
-					if (i == 1) {   // Note: at i = 1, the loop j just ends
-				// with i = 0, j = 1. The dBur, rBur change signs by the
-				// code in next loop, which are then the values at allele
-				// pair corresponding to i = 1,j = 0 (starting next loop)
-						m1 = *(mValp1+1); m2 = *mValp2;
-						f1 = *(freqp1+1); f2 = *freqp2;
-					}
-					for (j = 0; j < 2; j++) {
-						if (j == 1) {
-							m2 = *(mValp2+1); f2 = *(freqp2+1);
-							dBur = -dBur; rBur = -rBur;
-						}
-						if (sepBurOut == 0) fprintf (outBurr,
-							"%9d%8d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
-							currPop, p1+1, p2+1, m1, m2, f1, f2, dBur,
-							rBur, rBur2);
-						else fprintf (outBurr,
-							"%3d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
-							p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
-					}
-				}
-				if (sepBurOut == 0) {
-					fprintf (outBurr, "   ");
-        			PrtLines (outBurr, 85, '-');
-					fprintf (outBurr, "   Number of Allele Pairs:%8d,      "
-							"Means:  %15.3e%12.3e%12.3e\n",
-							*nMpairs, dBurMean, rMean, *rB);
-// added, but can be removed (Aug 2016) ----------------------------------
-					float w1 = 1.0;
-					float w2 = (*nSamp)*(*nSamp);
-					if (weighsmp > 0)
-						fprintf (outBurr, "%49cIndp. = (1, 1), Size =%5.0f,"
-									" Wt:%7.0f\n", ' ', *nSamp, w1*w2);
-					else
-						fprintf (outBurr, "%78cWt:%7.0f\n", ' ', w1);
-// -----------------------------------------------------------------------
-				}
-			} else {
-				if (moreCol == 0)
-					fprintf (outBurr, "%6d %6d %7.4f %7.4f %8d %14.5e %14.5e\n",
-							p1+1, p2+1, fminp1, fminp2, (int) *nSamp, *rB,
-							(*rB)-(*expR2));
-				else fprintf (outBurr,  "%6d %6d %7.4f %7.4f %5d%5d "
-							"%7d%7d %13.4e %13.4e %13.4e %13.4e\n",
-							p1+1, p2+1, fminp1, fminp2, *nInd1, *nInd2,
-							*nMpairs, (int) *nSamp, dBurMean, rMean,
-							*rB, (*rB)-(*expR2));
-			}
-			fflush (outBurr);
-		} // end of "if (writeBur == 1)"
 		return;
 	}
-
-// Added in Jan 2016:
-//	float *y = (float*) malloc(sizeof(float)*nEff2); // changed y to array
-	float *varp2 = (float*) malloc(sizeof(float)*nEff2);
-	float *colSum = (float*) malloc(sizeof(float)* nEff2);
-	float *rRow = (float*) malloc(sizeof(float)*nEff2);
-	float *r2Row = (float*) malloc(sizeof(float)*nEff2);
-
-// for jackknife on Samples
-// In the comments, we use the symbol S for the whole set of samples,
-// Sk for the sample set S with one sample removed (assuming sample (k+1)th)
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-	int c;
-	float *f1xAt = (float*) malloc(sizeof(float)*nfish);
-	float *f2xAt = (float*) malloc(sizeof(float)*nfish);
-// to keep track of r^2 at all Sk, for a pair of alleles
-	float *r2xAt = (float*) malloc(sizeof(float)*nfish);
-// to count number of eligible alleles at each Sk
-	int *m1Acc = (int*) malloc(sizeof(int)*nfish);
-	int *m2Acc = (int*) malloc(sizeof(int)*nfish);
-// to determine if current allele pairs are rejected at Sk
-	char *m1Rej = (char*) malloc(sizeof(char)*nfish);
-	char *m2Rej = (char*) malloc(sizeof(char)*nfish);
-	char gotr2x;
-// for the sum of frequencies of eligible alleles at Sk
-	float *f1xSum = (float*) malloc(sizeof(float)*nfish);
-	float *f2xSum = (float*) malloc(sizeof(float)*nfish);
-
-	for (k = 0; k < nfish; k++) {
-		f1xAt[k] = 0;
-		f2xAt[k] = 0;
-		r2xAt[k] = 0;
-		m1Acc[k] = 0;
-		m2Acc[k] = 0;
-		m1Rej[k] = 0;
-		m2Rej[k] = 0;
-		f1xSum[k] = 0;
-		f2xSum[k] = 0;
-		r2AtPairX[k] = 0;
-	}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+	varp2 = (float*) malloc(sizeof(float)*nEff2);
+	colSum = (float*) malloc(sizeof(float)* nEff2);
+	rRow = (float*) malloc(sizeof(float)*nEff2);
+	r2Row = (float*) malloc(sizeof(float)*nEff2);
 	for (j = 0; j < nEff2; j++) {
-		f2 = *(freqp2+j);   // frequency of allele (j+1)th at locus p2.
-		varp2[j] = f2 * (float) (1.0 - 2*f2) + *(homop2+j); // for variance
-                        // related to allele (j+1)th at locus p2
-		colSum[j] = 0;              // related to allele (j+1)th at locus p2
-		rRow[j] = 0;    // colSum, rRow, r2Row for holding values calculated
+		f2 = *(freqp2+j);
+		varp2[j] = f2 * (float) (1.0 - 2*f2) + *(homop2+j);
+		colSum[j] = 0;
+		rRow[j] = 0;
 		r2Row[j] = 0;
-// for jackknife on Samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-// Determine m2Acc[k] = number of alleles at locus p2 that are accepted at Sk
-		if (jack != 0) {
-			if (varp2[j] < epsilon) {   // locus p2 is het. with allele (j+1)th,
-	// so allele (j+1)th is eligible at locus p2 (freq = 0.5) in all Sk.
-				for (k = 0; k < nfish; k++) m2Acc[k]++;
+	}
+// dBur at (nInd1, j) and (i, nInd2) are the negative of sums at column j,
+// row i, as in Burrows_Calcul
+	for (i = 0, r2Mean = 0; i < nEff1; i++) {
+		f1 = *(freqp1+i);
+		varp1 =  f1 * (float) (1.0 - 2*f1) + *(homop1+i);
+		if (varp1 < epsilon) continue;	// r^2 = 0 with any allele at p2
+		rowSum = 0;
+		for (j = 0; j < nEff2; j++) {
+			f2 = *(freqp2+j);
+			if (varp2[j] < epsilon) {
+				dBur = 0; rBur = 0; rBur2 = 0;
+			} else if (i == *nInd1) {
+				dBur = - colSum[j];
+				if (nEff1 == 2) {
+					rBur = - rRow[j];
+					rBur2 = r2Row[j];
+				} else {
+					xy = varp1 * varp2[j];
+					rBur = dBur/sqrt(xy);
+					rBur2 = rBur * rBur;
+					if (rBur2 > 1.0) rBur2 = 1.0;
+				}
 			} else {
-				m2 = *(mValp2+j);   // m2 is allele (j+1)th
-				for (k = 0; k < nfish; k++) {
-					if (noDatFish[k] > 0) m2Acc[k]++;
+				if (j == *nInd2) {
+					dBur = - rowSum;
+					if (j == 1) rBur = -rBur;	// rBur2 as at (i, 0)
 					else {
-						c = Count(p2Gen[k], m2);
-						if (Rejected(cutoff, *nSamp, f2, c, (f2xAt+k)) == 0) {
-							m2Acc[k]++;
-							f2xSum[k] += f2xAt[k];
-						}
+						xy = varp1 * varp2[j];
+						rBur = dBur/sqrt(xy);
+						rBur2 = rBur * rBur;
+						if (rBur2 > 1.0) rBur2 = 1.0;
 					}
+				} else {
+					pSum = (float) *(joint + (*(aIdx1+i))*nA2 + *(aIdx2+j));
+					Burrows_Coef (f1, f2, varp1, varp2[j], *nSamp, pSum,
+								&dBur, &rBur, &rBur2);
+					rowSum += dBur;
 				}
+				colSum[j] += dBur;
+				rRow[j] = rBur;
+				r2Row[j] = rBur2;
 			}
+			r2Mean += rBur2;
 		}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
 	}
+	*rB = r2Mean/(*nMpairs);
+	free (varp2);
+	free (colSum);
+	free (rRow);
+	free (r2Row);
+}
 
-// In the next loop, for each i, rRow[.] is a vector of rBur-values corresp.
-// to i, at various j (in loop of j). It contains rBur(i,j) for various j.
-// The values in this array are only needed for storing at i = 0 in the case
-// 1 = nInd1 < nEff1 = 2.  When going to the next i = 1 in the loop, those
-// values in rRow (stored rBur values at i = 0 for various j) are reused.
-// In such case, then for each j, rBur(1,j) = -rBur(0,j). Thus, at each j,
-// just set rBur(1,j) = -rRow[j].
-// Simlarly for r2Row (storing values of rBur2).
+//-------------------------------------------------------------------------
 
-// colSum[j] stores the sum of dBur-values at column j, up to row i = nInd1-1.
-// This will be used at row i = nInd1, which can only happen if nInd1 < nEff1.
-// When this happens (at i = nInd1), the dBur at this i, for any column j,
-// is the negative of the sum of all previous dBur values under the same j.
-// That sum was stored as colSum[j].
-//
-// On the other hand, rowSum is the sum of dBur at row i, up to j = (nInd2-1).
-// This will be used at each i, and only at j = nInd2 (this can only happen
-// if nInd2 < nEff2). The value of dBur at (i, nInd2) is negative of the sum
-// of all dBur at the same i, of all j < nInd2. That sum is rowSum.
-	for (i = 0; i < nEff1; i++) {
-		m1 = *(mValp1+i);
-		f1 = *(freqp1+i);       // frequency of allele m1 at locus p1.
-		varp1 =  f1 * (float) (1.0 - 2*f1) + *(homop1+i);   // represent variance
-                                                // related to allele m1
-		if (varp1 < epsilon) {  // this means variance related to m1 is zero;
-		// so, all samples are heterozygotes with one allele being m1.
-			dBur = 0; rBur = 0; rBur2 = 0;
-// write to auxiliary file here
-			if (writeBur == 1 && BurAlePair == 1)
-			{
-				for (j = 0; j < nEff2; j++) {
-					m2 = *(mValp2+j);
-					f2 = *(freqp2+j);   // frequency of allele m2 at locus p2.
-					if (sepBurOut == 0) fprintf (outBurr,
-						"%9d%8d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
-						currPop, p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
-					else fprintf (outBurr,
-						"%3d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
-						p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
-					fflush (outBurr);
-				}
-			}
-        // The next "for" loop is for jackknife on Samples.
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-        // The same thing will happen when a sample is removed (whether
-        // that sample has data at both loci or not): all samples in Sk
-        // are heterozygotes with one allele being m1 (allele m1 in Sk
-        // has freq 1/2); so r^2 = 0 for each Sk when m1 is paired
-        // with any eligible allele at locus p2).
-
-        // r2AtPairX[k] = (sum of r^2 over all allele pairs in Sk) unchanged
-			if (jack != 0) {
-				for (k = 0; k < nfish; k++) {
-//          r2xAt[k] = 0;   // r^2 set = 0 for any pairing with m1
-				// this allele m1 is eligible in all Sk:
-					m1Rej[k] = 0;
-					m1Acc[k]++;
-				}
-			}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+int PairStatNext (PAIRSTAT stat)
+// Oct 2026: read the next locus pair of the block into stat, return 0 if
+// there are no more (then the pair is (nloci, nloci), after all others).
+{
+	int head[5], n;
+	int *ptr;
+	if (stat->nRead < stat->nPair
+		&& fread (head, sizeof(int), 5, stat->inp) == 5) {
+		n = 2*(head[3] + head[4]) + head[3]*head[4];
+		if (n > stat->maxCount
+			&& (ptr = (int*) realloc (stat->count, sizeof(int)*n)) != NULL) {
+			stat->count = ptr;
+			stat->maxCount = n;
+		}
+		if (n <= stat->maxCount
+			&& fread (stat->count, sizeof(int), n, stat->inp) == (size_t) n) {
+			stat->p1 = head[0];
+			stat->p2 = head[1];
+			stat->nSamp = head[2];
+			stat->nA1 = head[3];
+			stat->nA2 = head[4];
+			stat->nRead++;
+			return 1;
+		}
+	}
+	stat->p1 = stat->p2 = stat->nloci;
+	return 0;
+}
 
+//-------------------------------------------------------------------------
 
-		} else {    // of "(varp1 < epsilon)" => varp1 (related to m1) > 0.
-		// obtain countm1[k] = number of copies of allele m1 at each sample k
-			AlleInSamp (nfish, m1, p1Gen, noDatFish, countm1);
-// for jackknite on Sample
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-// must check if this allele m1 is existed and accepted in each Sk
-			if (jack != 0) {
-				for (k = 0; k < nfish; k++) {
-					if (noDatFish[k] > 0) {
-						m1Rej[k] = 0;
-						m1Acc[k]++;
-					} else {
-						m1Rej[k] = Rejected(cutoff, *nSamp, f1, countm1[k],
-										(f1xAt+k));
-						if (m1Rej[k] == 0) {
-							m1Acc[k]++;
-							f1xSum[k] += f1xAt[k];
-						}
-					}
-				}
-			}
-// As i goes through the "for" loop, m1Acc[k] is the total number of eligible
-// alleles in the sample set Sk (sample set after a sample k is deleted).
-// The number of alleles accepted in Sk was found before this "for" loop.
-// Therefore, the number of pairs accepted in Sk is m1Acc[k] * m2Acc[k]
-// after this "for i = " loop is through.
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-			rowSum = 0;
-			for (j = 0; j < nEff2; j++) {
-				m2 = *(mValp2+j);
-				f2 = *(freqp2+j);   // frequency of allele m2 at locus p2.
-				gotr2x = 0;
-				if (varp2[j] < epsilon) {   // varp2[j] = 0, variance at m2
-			// all samples are heterozygotes at locus p2 with one allele = m2
-					dBur = 0; rBur = 0; rBur2 = 0;
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-				// for jackknife on samples:
-				// For all k, r^2 at Sk = 0,  r2AtPairX[k] is unchanged
-				// This allele m2 is accepted in all Sk
-					if (jack != 0) {
-						for (k = 0; k < nfish; k++) m2Rej[k] = 0;
-					}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+int PairStatSeek (PAIRSTAT stat, int p1, int p2)
+// Oct 2026: go on to locus pair (p1, p2) in the block, pairs being in the
+// order of LDRunPairs. Return 1 if it is there, else 0.
+{
+	while (stat->p1 < p1 || (stat->p1 == p1 && stat->p2 < p2))
+		if (PairStatNext (stat) == 0) return 0;
+	return (stat->p1 == p1 && stat->p2 == p2)? 1: 0;
+}
 
-				} else {    // both varp1 and varp2[j] > 0 (rel. to m1, m2)
-		// obtain countm2[k] = number of copies of allele m2 at each sample k
-					AlleInSamp (nfish, m2, p2Gen, noDatFish, countm2);
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-				// jackknife on samples: check eligibility of m2 in each Sk
-					if (jack != 0) {
-						for (k = 0; k < nfish; k++) {
-							if (noDatFish[k] > 0) m2Rej[k] = 0;
-							else m2Rej[k] = Rejected(cutoff, *nSamp, f2,
-											countm2[k], (f2xAt+k));
-						}
-					}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-
-// Always have nInd1 <= nEff1. Then nInd1 < nEff1 <=> no allele dropped at
-// locus p1. The next "if" statement is to deal with this case.
-// First, dBur for the last i (which is nInd1), at any j, will be the negative
-// of the sum of all dBur at previous i (of the same j), which is colSum[j].
-// Moreover, if also nEff1 = 2 (or nInd1 = 1), then rBur at i = nInd1 = 1 and
-// at any j will be the negative of rBur at i = 0 and the same j (= rRow[j])
-					if (i == *nInd1) {  // only if *nInd1<nEff1, i=nEff1-1
-						dBur = - colSum[j];
-						if (nEff1 == 2) {
-							rBur = - rRow[j];
-							rBur2 = r2Row[j];
-						} else {
-							xy = varp1 * varp2[j];  // this must be > 0
-							rBur = dBur/sqrt(xy);
-							rBur2 = rBur * rBur;
-							if (rBur2 > 1.0) rBur2 = 1.0;
-						}
-// for Jackknife on samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-// At allele m1 of locus p1, we know if m1 is rejected or eligible under Sk
-// for each sample (k+1)th removed, from the value m1Rej[k] evaluated earlier
-// at the start of "else" of "if (varp1 < epsilon)". When m2 is not rejected
-// under Sk, r^2 will be calculated.
-// When allele pair (m1, m2) is eligible under Sk, and i = *nInd1 = 1, then
-// the previous m1 (corresponding to i=0) is also eligible at locus p1,
-// we actually have r^2 at this pair (m1, m2) being the same as r^2 at
-// (prev m1, m2). However, to be able to use this previous r^2-value, we will
-// need to store it in a 2-dimensional array (one for m2, the other for k,
-// to store r^2 with the first allele being fixed).
-// Without such array, we will need to calculate r^2 for each Sk
-// (when "nEff1 == 2"), based on the Burrows disequilibrium dBur for the
-// whole sample set S, instead of grabbing previous values in each Sk.
-// So, we will need to use the following value as in the case "else" above:
-						if (jack != 0) {
-							if (j == *nInd2 && j == 1) {
-								gotr2x = 1;
-								for (k = 0; k < nfish; k++) {
-// Note: In this "j=1" case, when allele m1, m2 are eligible in Sk, then
-// allele m1 ane previous m2 (corresponding to j = 0) will also eligible
-// in Sk, so r2xAt[k] is the available r2-value for previous pair
-									if (m1Rej[k] == 0 && m2Rej[k] == 0) {
-										r2AtPairX[k] += r2xAt[k];
-									}
-								}
-							} else //  of "(j == *nInd2 && j == 1)"
-								pSum = roundf((dBur + 2*f1*f2)*2*(*nSamp));
-						}	// end of "if (jack != 0)"
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-					} else {    // of "if (i == *nInd1)", i.e., i < *nInd1.
-					// If *nInd1 = nEff1, then case "else" always happens.
-						if (j == *nInd2) {  // can happen if nInd2 < nEff2
-							dBur = - rowSum;
-							if (j == 1) {
-								rBur = -rBur; // prev. rBur is for (i, 0)
-// for Jackknife on samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-// At each k, either the allele pair corresponding to (i, j=1) is rejected
-// or r^2 at this allele pair is the same as for previous pair (i, j=0).
-// If pair at (i, j=1) is eligible, then so is pair at (i, j=0).
-								if (jack != 0) {
-									gotr2x = 1;
-									for (k = 0; k < nfish; k++) {
-// Note: In this "j=1" case, when allele m1, m2 are eligible in Sk, then
-// allele m1 ane previous m2 (corresponding to j = 0) will also eligible
-// in Sk, so r2xAt[k] is the available r2-value for previous pair
-										if (m1Rej[k] == 0 && m2Rej[k] == 0) {
-											r2AtPairX[k] += r2xAt[k];
-										}
-									}
-								}
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-							} else { // j = nInd2 > 1: need to find rBur
-								xy = varp1 * varp2[j];
-								rBur = dBur/sqrt(xy);
-								rBur2 = rBur * rBur;
-								if (rBur2 > 1.0) rBur2 = 1.0;
-// for Jackknife on samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-								pSum = roundf((dBur + 2*f1*f2)*2*(*nSamp));
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-							}
-						} else {	// of "if (j == *nInd2)"
-        // Burrows coeff. need to be calculated at pair (i, j), for any j.
-        // (countm1, countm2 were determined)
-							Burrows_Delta (f1, f2, varp1, varp2[j], *nSamp, nfish,
-								&dBur, &rBur, &rBur2, &pSum, countm1, countm2);
-							rowSum += dBur; // sum of dBur across j, for this i
-						}
-						colSum[j] += dBur;  // colSum[j] is sum of entries of
-                                // dBur-matrix at column j, up to row i
-						rRow[j] = rBur; // rRow, r2Row are reassigned at each i;
-						r2Row[j] = rBur2;// only values for the last i are kept!
-					}   // end of "if (i == *nInd1) ... else ..."
-// for Jackknife on samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-// After the condition set for i (= nInd1 or not), except for the case
-// j = *nInd2 = 1 where r^2 in each Sk takes previous r^2-value (at j=0),
-// the rest (unconditional on i, and for j not in the case mentioned) need
-// value pSum. This pSum was assigned in case i = *nInd1. In case i /= *nInd1,
-// it was set at j = *nInd2 /= 1 through assignment, and at j /= *nInd2
-// through the call Burrows_Delta.
-// The exceptional case, where r^2 in each Sk takes previous r^2-value,
-// is signaled by gotr2x = 1 (otherwise, it is still 0).
-					if (jack != 0) {
-						if (gotr2x == 0) {
-// From Burrows disequilibrium at (m1, m2) under whole sample set S, which is
-// dBur = pSum - 2(f1*f2), we can derive Burrows disequilibrium at (m1,m2)
-// under sample set Sk. The calculations are based on "pSum". This pSum is
-// obtained through the call Burrows_Delta where dBur was calculated, or
-// straight from dBur if dBur was deduced from previous values.
-							for (k = 0; k < nfish; k++) {
-								if (m1Rej[k] == 0 && m2Rej[k] == 0) {
-                    // rBur2x will be r^2 for Sk
-									if (noDatFish[k] > 0) { // missing data at k
-										r2xAt[k] = rBur2;
-										r2AtPairX [k] += r2xAt[k];
-									} else {
-										rSet = r2Default (*nSamp, frac, f1xAt[k],
-											*(homop1+i), countm1[k], f2xAt[k],
-											*(homop2+j), countm2[k],
-											&var1, &var2, epsilon);
-										if (rSet != 0) {
-											pSumx = pSum - countm1[k]*countm2[k];
-											dBurx = frac2*pSumx -
-													2*f1xAt[k]*f2xAt[k];
-											if (*nSamp > 2.5) // i.e. at least 3
-							// adjust Burrows disequilib. by unbiased factor
-												dBurx *= (*nSamp-1)/(*nSamp-2);
-											r2xAt[k] = (dBurx*dBurx)/(var1*var2);
-											if (r2xAt[k] > 1.0) r2xAt[k] = 1.0;
-											r2AtPairX [k] += r2xAt[k];   // r^2 for Sk
-										} else {    // if rset=0, r^2 = 0
-											r2xAt[k] = 0;
-										}
-									}
-
-								}   // end of "if (m1Rej[k]==0 && m2Rej[k]==0)"
-							}   // end of "for (k = 0; k < nfish; k++)"
-						}   // end of "if (gotr2x == 0)"
-
-					}   // end of "if (jack != 0)"
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-				}   // end of "if (varp2[j] < epsilon) ...  else ..."
-				r2Mean += rBur2;
-				if (rSkip == 0) rMean += rBur;  // rMean = 0 if rSkip > 0
-				if (dSkip == 0) dBurMean += dBur;
-// write to auxiliary file here
-				if (writeBur == 1 && BurAlePair == 1)
-				{
-					if (sepBurOut == 0) fprintf (outBurr,
-							"%9d%8d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
-						currPop, p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
-					else fprintf (outBurr,
-							"%3d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
-							p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
-					fflush (outBurr);
-				}
-			}   // end of "for (j = 0; j < nEff2; j++)"
-		// This is the end of "else": varp1 is not 0; so r2, dBur can be
-		// nonzero when j runs in the "for" loop
-		}   // end of "if (varp1 < epsilon) ... else ..."
-	}    // end of "for (i = 0; i < nEff1; i++)"
-
-// for Jackknife on Samples:
-// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
-	if (jack != 0) { // wrap up information on Sk
-		x = 1.0 - epsilon;  // basically, if y <= 1 and y > x, then y = 1.
-		for (k = 0; k < nfish; k++) {
-			i = m1Acc[k] * m2Acc[k];
-			if (i > 0) {
-				r2AtPairX[k] /= i;   // mean of r^2 over all elig. alle pairs
-// temporarily add for checking with checkR2:
-// r2JackTot[k] += r2AtPairX[k];
-				r2Count[k]++;
-			}
-		// now for product of ind. alleles at each Sk:
-			if (noDatFish[k] > 0) JweighPair[k] = (*nInd1)*(*nInd2);
-			else {
-				m1 = m1Acc[k];  // number of eligible alleles at locus p1
-				m2 = m2Acc[k];  // number of eligible alleles at locus p2
-			// if Sum(eligible alleles) = 1, #(ind. alleles) is one less
-				if (f1xSum[k] > x) m1--;
-				if (f2xSum[k] > x) m2--;
-				JweighPair[k] = m1*m2;
-			}
-		}
+//-------------------------------------------------------------------------
+
+void PairStatRewind (PAIRSTAT stat)
+// Oct 2026: back to the beginning of the block, for the next critical value
+{
+	FSEEK64 (stat->inp, stat->start, SEEK_SET);
+	stat->nRead = 0;
+	stat->p1 = stat->p2 = -1;
+}
+
+//-------------------------------------------------------------------------
+
+int LocusDup (FISHPTR *fishHead, int lastOK, char *okLoc, int *slot)
+// Oct 2026: groups of loci taken (okLoc, up to lastOK) having the same
+// genotypes in all samples: slot[p] = g for loci p of group g = 0, 1, ...,
+// -1 for loci not in a group of two or more. Return the number of groups.
+// Loci of a group have the same allele lists, so Burrows_Calcul gives the
+// same at locus pairs (p1, p2) for all p2 of a group. (Loci having the same
+// genotypes up to allele names are not grouped, their alleles are in
+// another order, so sums of allele pairs would differ by rounding.)
+{
+	int p, q, k, n, size, nGroup = 0;
+	unsigned long long h, *hash;
+	int *table, *rep;
+	FISHPTR fish1, fish2;
+	n = lastOK+1;
+	for (p = 0; p < n; p++) *(slot+p) = -1;
+	for (size = 1; size < 2*n; size *= 2) ;
+	hash = (unsigned long long*) malloc(sizeof(unsigned long long)*n);
+	table = (int*) malloc(sizeof(int)*size);
+	rep = (int*) malloc(sizeof(int)*n);
+	if (hash == NULL || table == NULL || rep == NULL) {
+		free (hash);
+		free (table);
+		free (rep);
+		return 0;
 	}
-// Now, r2AtPairX[k] is the average of r^2 taken over all allele pairs for
-// sample set Sk at locus pair (p1, p2); so it represents r^2 at this pair.
-// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
-	*rB = r2Mean/(*nMpairs); // Burrows coeff. averaging over all allele
-                            // pairs for this locus pair (p1, p2).
-	rMean = rMean/(*nMpairs);
-	dBurMean = dBurMean/(*nMpairs);
-	// write to auxiliary file here (added BurrPause in Sept 2011):
-	if (writeBur == 1)
-	{
-		if (BurAlePair == 1) {
-			if (sepBurOut == 0) {
-				fprintf (outBurr, "   ");
-				for (j=0; j<85; j++) fprintf (outBurr, "-");
-				fprintf (outBurr, "\n");
-				fprintf (outBurr, "   Number of Allele Pairs:%8d,"
-						"      Means:  %15.3e%12.3e%12.3e\n",
-						*nMpairs, dBurMean, rMean, *rB);
-// added, but can be removed (Aug 2016) ----------------------------------
-				float w1 = (*nInd1)*(*nInd2);
-				float w2 = (*nSamp)*(*nSamp);
-				if (weighsmp > 0)
-					fprintf (outBurr, "%47cIndp. = (%2d, %2d), Size =%5.0f,"
-							" Wt:%7.0f\n", ' ', *nInd1, *nInd2, *nSamp, w1*w2);
-				else
-					fprintf (outBurr, "%78cWt:%7.0f\n", ' ', w1);
-// -----------------------------------------------------------------------
-			}
-		} else {
-			if (moreCol == 0)
-				fprintf (outBurr, "%6d%7d%8.4f%8.4f %8d %14.5e %14.5e\n",
-				p1+1, p2+1, fminp1, fminp2, (int) *nSamp, *rB, (*rB)-(*expR2));
-			else fprintf (outBurr,
-				"%6d%7d%8.4f%8.4f%6d%5d%8d%7d%14.4e%14.4e%14.4e%14.4e\n",
-				p1+1, p2+1, fminp1, fminp2, *nInd1, *nInd2, *nMpairs,
-				(int) *nSamp, dBurMean, rMean, *rB, (*rB)-(*expR2));
+	for (k = 0; k < size; k++) *(table+k) = -1;
+// rep[p] = the first locus of the same genotypes, by hash table of loci
+	for (p = 0; p < n; p++) {
+		*(rep+p) = p;
+		if (*(okLoc+p) == 0) continue;
+		h = 14695981039346656037ULL;
+		for (fish1 = *(fishHead+p); fish1 != NULL; fish1 = fish1->next) {
+			h = HashInt (h, fish1->gene[0]);
+			h = HashInt (h, fish1->gene[1]);
 		}
-		fflush (outBurr);
-	};
+		*(hash+p) = h;
+		for (k = (int) (h & (size-1)); (q = *(table+k)) >= 0;
+				k = (k+1) & (size-1)) {
+			if (*(hash+q) != h) continue;
+			for (fish1 = *(fishHead+p), fish2 = *(fishHead+q);
+				fish1 != NULL && fish2 != NULL
+				&& fish1->gene[0] == fish2->gene[0]
+				&& fish1->gene[1] == fish2->gene[1];
+				fish1 = fish1->next, fish2 = fish2->next) ;
+			if (fish1 == NULL && fish2 == NULL) break;
+		}
+		if (q >= 0) *(rep+p) = q;
+		else *(table+k) = p;
+	}
+	for (p = 0; p < n; p++) {
+		if ((q = *(rep+p)) == p) continue;
+		if (*(slot+q) < 0) *(slot+q) = nGroup++;
+		*(slot+p) = *(slot+q);
+	}
+	free (hash);
+	free (table);
+	free (rep);
+	return nGroup;
+}
 
-	free (colSum);
-	free (varp2);
-	free (rRow);
-	free (r2Row);
-// for jackknife:
-	free (f1xAt);
-	free (f2xAt);
-	free (r2xAt);
-	free (m1Acc);
-	free (m2Acc);
-	free (m1Rej);
-	free (m2Rej);
-	free (f1xSum);
-	free (f2xSum);
+//-------------------------------------------------------------------------
+
+void RemovePairRes (PAIRRES res)
+{
+	if (res == NULL) return;
+	free (res->p1);
+	free (res->nSamp);
+	free (res->rB);
+	free (res->expR2);
+	free (res->nInd1);
+	free (res->nInd2);
+	free (res->nMpairs);
+	free (res->r2AtPairX);
+	free (res->JweighPair);
+	free (res->noDatFish);
+	free (res->r2Inc);
+	free (res->r2Count0);
+	free (res);
+}
+
+//-------------------------------------------------------------------------
+
+PAIRRES MakePairRes (int nGroup, int nfish, char jack)
+// Oct 2026: results kept for nGroup groups of identical loci, with those of
+// jackknife on samples if jack = 1. Return NULL if failed.
+{
+	int g;
+	size_t n = (size_t) nGroup*nfish;
+	PAIRRES res;
+	if ((res = (PAIRRES) calloc (1, sizeof(struct pairres))) == NULL)
+		return NULL;
+	res->nGroup = nGroup;
+	res->nfish = nfish;
+	res->p1 = (int*) malloc(sizeof(int)*nGroup);
+	res->nSamp = (float*) malloc(sizeof(float)*nGroup);
+	res->rB = (float*) malloc(sizeof(float)*nGroup);
+	res->expR2 = (float*) malloc(sizeof(float)*nGroup);
+	res->nInd1 = (int*) malloc(sizeof(int)*nGroup);
+	res->nInd2 = (int*) malloc(sizeof(int)*nGroup);
+	res->nMpairs = (int*) malloc(sizeof(int)*nGroup);
+	if (jack != 0) {
+		res->r2AtPairX = (float*) malloc(sizeof(float)*n);
+		res->JweighPair = (float*) malloc(sizeof(float)*n);
+		res->noDatFish = (int*) malloc(sizeof(int)*n);
+		res->r2Inc = (char*) malloc(sizeof(char)*n);
+		res->r2Count0 = (unsigned long long*)
+						malloc(sizeof(unsigned long long)*nfish);
+	}
+	if (res->p1 == NULL || res->nSamp == NULL || res->rB == NULL
+		|| res->expR2 == NULL || res->nInd1 == NULL || res->nInd2 == NULL
+		|| res->nMpairs == NULL || (jack != 0 && (res->r2AtPairX == NULL
+		|| res->JweighPair == NULL || res->noDatFish == NULL
+		|| res->r2Inc == NULL || res->r2Count0 == NULL))) {
+		RemovePairRes (res);
+		return NULL;
+	}
+	for (g = 0; g < nGroup; g++) *(res->p1+g) = -1;
+	return res;
+}
+
+//-------------------------------------------------------------------------
+
+void PairResPut (PAIRRES res, int g, int p1, float nSamp, int nInd1,
+				int nInd2, int nMpairs, float rB, float expR2,
+				float *r2AtPairX, float *JweighPair, int *noDatFish,
+				unsigned long long *r2Count)
+// Oct 2026: keep results of Burrows_Calcul at (p1, p2), p2 in group g;
+// r2Count is compared with r2Count0, taken before the call.
+{
+	int k, nfish = res->nfish;
+	size_t at = (size_t) g*nfish;
+	*(res->p1+g) = p1;
+	*(res->nSamp+g) = nSamp;
+	*(res->nInd1+g) = nInd1;
+	*(res->nInd2+g) = nInd2;
+	*(res->nMpairs+g) = nMpairs;
+	*(res->rB+g) = rB;
+	*(res->expR2+g) = expR2;
+	if (res->r2Count0 == NULL) return;
+	memcpy (res->r2AtPairX+at, r2AtPairX, sizeof(float)*nfish);
+	memcpy (res->JweighPair+at, JweighPair, sizeof(float)*nfish);
+	memcpy (res->noDatFish+at, noDatFish, sizeof(int)*nfish);
+	for (k = 0; k < nfish; k++)
+		*(res->r2Inc+at+k) = (char) (r2Count[k] - *(res->r2Count0+k));
+}
+
+//-------------------------------------------------------------------------
+
+void PairResGet (PAIRRES res, int g, float *nSamp, int *nInd1, int *nInd2,
+				int *nMpairs, float *rB, float *expR2, float *r2AtPairX,
+				float *JweighPair, int *noDatFish,
+				unsigned long long *r2Count)
+// Oct 2026: reuse results kept for group g, as if Burrows_Calcul was called
+{
+	int k, nfish = res->nfish;
+	size_t at = (size_t) g*nfish;
+	*nSamp = *(res->nSamp+g);
+	*nInd1 = *(res->nInd1+g);
+	*nInd2 = *(res->nInd2+g);
+	*nMpairs = *(res->nMpairs+g);
+	*rB = *(res->rB+g);
+	*expR2 = *(res->expR2+g);
+	if (res->r2Count0 == NULL) return;
+	memcpy (r2AtPairX, res->r2AtPairX+at, sizeof(float)*nfish);
+	memcpy (JweighPair, res->JweighPair+at, sizeof(float)*nfish);
+	memcpy (noDatFish, res->noDatFish+at, sizeof(int)*nfish);
+	for (k = 0; k < nfish; k++) r2Count[k] += *(res->r2Inc+at+k);
 }
+
+//-------------------------------------------------------------------------
+
+PAIRRES PairResBegin (FISHPTR *fishHead, int lastOK, char *okLoc,
+					int nfish, char jack, int nRow, int **slot)
+// Oct 2026: groups of identical loci into *slot (see LocusDup), and their
+// results to be kept for nRow loci p1 at a time (results of group g for
+// row r are at g*nRow + r); with jackknife on samples, at most
+// LDDUPJACK/(nfish*nRow) groups. Return NULL if none or out of memory,
+// *slot is freed by the caller.
+{
+	int p, nGroup = 0;
+	if (lastOK > 0
+		&& (*slot = (int*) malloc(sizeof(int)*(lastOK+1))) != NULL)
+		nGroup = LocusDup (fishHead, lastOK, okLoc, *slot);
+	if (jack != 0 && nGroup > LDDUPJACK/(nfish*nRow)) {
+		nGroup = LDDUPJACK/(nfish*nRow);
+		for (p = 0; p <= lastOK; p++)
+			if (*(*slot+p) >= nGroup) *(*slot+p) = -1;
+	}
+	if (nGroup > 0) return MakePairRes (nGroup*nRow, nfish, jack);
+	return NULL;
+}
+
 //-------------------------------------------------------------------------
 
 void AddBurrVal (int nInd1, int nInd2, float rB, float nSamp,		// in
@@ -6693,7 +7439,361 @@ void JackWeight (char weighsmp, float nSamp, int nfish, int *noDatFish,
 }
 
 //-------------------------------------------------------------------------
-// return the number of r^2-values in parameter list,
+
+long MemInUse (char peak)
+// Oct 2026: memory in use by the program (resident set) in kB, or its peak
+// so far if peak = 1, read from /proc/self/status where there is one;
+// return -1 if not known.
+{
+	FILE *status;
+	char line[100];
+	long kB = -1;
+	if ((status = fopen ("/proc/self/status", "r")) == NULL) return -1;
+	while (fgets (line, 100, status) != NULL)
+		if (strncmp (line, (peak == 1)? "VmHWM:": "VmRSS:", 6) == 0) {
+			kB = atol (line+6);
+			break;
+		}
+	fclose (status);
+	return kB;
+}
+
+//-------------------------------------------------------------------------
+
+double WallClock (void)
+// Oct 2026: wall-clock time in seconds, for timing phases
+{
+	struct timespec now;
+	timespec_get (&now, TIME_UTC);
+	return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+//-------------------------------------------------------------------------
+
+void PhaseBegin (PHASE prof, int k)
+// Oct 2026: phase k begins, nothing is done if not profiled (prof = NULL).
+// The CPU time is of the whole program, so it counts all threads busy
+// at the time, e.g., on other populations run concurrently.
+{
+	if (prof == NULL) return;
+	(prof+k)->wall0 = WallClock ();
+	(prof+k)->cpu0 = (double) clock () / CLOCKS_PER_SEC;
+}
+
+//-------------------------------------------------------------------------
+
+void PhaseEnd (PHASE prof, int k)
+// Oct 2026: phase k, begun by PhaseBegin, ends
+{
+	if (prof == NULL) return;
+	(prof+k)->calls++;
+	(prof+k)->wall += WallClock () - (prof+k)->wall0;
+	(prof+k)->cpu += (double) clock () / CLOCKS_PER_SEC - (prof+k)->cpu0;
+}
+
+//-------------------------------------------------------------------------
+
+void PrtProfHead (FILE *profOut)
+// Oct 2026: column names of the profile file, see PopReport
+{
+	fprintf (profOut, "# input\tpop\tphase\tcalls\twallSec\tcpuSec"
+					"\tpairs\tbytes\tpeakKB\n");
+	fflush (profOut);
+}
+
+//-------------------------------------------------------------------------
+
+void LDProgress (LDPROG prog, unsigned long long done, char state)
+// Oct 2026: write progress of LD method, done = locus pairs gone over.
+// state = 0 when starting, 2 when done; 1 in the loops of locus pairs,
+// written at most once a second, so it is cheap to call (callers check
+// it every LDPROGPAIR pairs).
+{
+	time_t now;
+	double sec, rate, eta;
+	char *name[3] = {"start", "run", "end"};
+	if (prog == NULL || prog->out == NULL) return;
+	time (&now);
+	if (state == 0) prog->start = now;
+	else if (state == 1 && now == prog->last) return;
+	prog->last = now;
+	sec = difftime (now, prog->start);
+	rate = (sec > 0)? done/sec: 0;
+	eta = (rate > 0 && done < prog->total)? (prog->total - done)/rate: 0;
+	if (state == 1 && rate == 0) eta = -1;
+	#pragma omp critical (progress)
+	{
+		fprintf (prog->out, "{\"state\":\"%s\",\"input\":%d,\"pop\":%d,"
+				"\"crit\":%g,\"done\":%llu,\"total\":%llu,\"sec\":%.0f,"
+				"\"pairsPerSec\":%.1f,\"etaSec\":%.0f,\"memKB\":%ld}\n",
+				name[(int) state], prog->icount, prog->popRead, prog->cutoff,
+				done, prog->total, sec, rate, eta, MemInUse (0));
+		fflush (prog->out);
+	}
+}
+
+//-------------------------------------------------------------------------
+
+R2STORE R2Open (char *name)
+// Oct 2026: create file name as the binary store of r^2-values at locus
+// pairs, return NULL if failed. The file consists of
+//	* header: R2MAGIC (8 chars), then R2NCOL, R2BLOCKPAIR (4-byte int);
+//	* blocks: each has up to R2BLOCKPAIR locus pairs of one population at
+//	  one critical value, as R2NCOL columns of count 4-byte entries:
+//	  p1, p2, chr1, chr2, nInd1, nInd2 (int), nSamp, r2, r2drift, weight
+//	  (float); loci numbered as in Burrows file, chromosomes as in the
+//	  list of chromosomes from 1 (0 if not given); r2drift = r^2 - E(r^2),
+//	  weight is before adjusting by the estimate of Ne (see AddBurrVal);
+//	* index: a struct r2index for each block, in the order written;
+//	* trailer: offset of index, number of blocks (8-byte int), R2MAGIC.
+// Numbers are in the byte order of this machine, and blocks are not
+// compressed, so a reader can map the file in memory, read the index
+// from the trailer, and go to blocks of a population or a locus range.
+{
+	R2STORE store;
+	int head[2] = {R2NCOL, R2BLOCKPAIR};
+	if ((store = (R2STORE) malloc(sizeof(struct r2store))) == NULL) {
+		printf ("Out of memory for r^2 store!\n");
+		return NULL;
+	};
+	if ((store->out = fopen (name, "wb")) == NULL) {
+		perror (name);
+		free (store);
+		return NULL;
+	};
+	setvbuf (store->out, NULL, _IOFBF, OUTBUF);
+	fwrite (R2MAGIC, 1, 8, store->out);
+	fwrite (head, sizeof(int), 2, store->out);
+	store->nBlock = 0;
+	store->maxBlock = 0;
+	store->index = NULL;
+	return store;
+}
+
+//-------------------------------------------------------------------------
+
+void R2Close (R2STORE store)
+// Oct 2026: write index and trailer of the r^2 store, then close it.
+{
+	long long at[2];
+	at[0] = ftell (store->out);
+	at[1] = store->nBlock;
+	fwrite (store->index, sizeof(struct r2index), store->nBlock, store->out);
+	fwrite (at, sizeof(long long), 2, store->out);
+	fwrite (R2MAGIC, 1, 8, store->out);
+	fclose (store->out);
+	free (store->index);
+	free (store);
+}
+
+//-------------------------------------------------------------------------
+
+int R2Begin (R2SECT sect, R2STORE store, int icount, int popRead,
+			float cutoff, FILE *con)
+// Oct 2026: start the locus pairs of population popRead at critical value
+// cutoff, to be written to store by R2Add. Return -1 if out of memory.
+// Messages go to console stream con.
+{
+	int *buf;
+	if ((buf = (int*) malloc(sizeof(int)*R2NCOL*R2BLOCKPAIR)) == NULL) {
+		fprintf (con, "Out of memory for r^2 store at c = %5.3f!\n", cutoff);
+		return -1;
+	};
+	sect->store = store;
+	sect->con = con;
+	sect->icount = icount;
+	sect->popRead = popRead;
+	sect->cutoff = cutoff;
+	sect->count = 0;
+	sect->p1 = buf;
+	sect->p2 = buf + R2BLOCKPAIR;
+	sect->chr1 = buf + 2*R2BLOCKPAIR;
+	sect->chr2 = buf + 3*R2BLOCKPAIR;
+	sect->nInd1 = buf + 4*R2BLOCKPAIR;
+	sect->nInd2 = buf + 5*R2BLOCKPAIR;
+	sect->nSamp = (float*) (buf + 6*R2BLOCKPAIR);
+	sect->r2 = (float*) (buf + 7*R2BLOCKPAIR);
+	sect->r2drift = (float*) (buf + 8*R2BLOCKPAIR);
+	sect->weight = (float*) (buf + 9*R2BLOCKPAIR);
+	return 0;
+}
+
+//-------------------------------------------------------------------------
+
+void R2Flush (R2SECT sect)
+// Oct 2026: write the locus pairs kept in sect as a block of the store.
+// Populations run concurrently take turns.
+{
+	int n = sect->count;
+	R2STORE store = sect->store;
+	struct r2index *ptr;
+	if (n == 0) return;
+	#pragma omp critical (r2store)
+	{
+		if (store->nBlock == store->maxBlock) {
+			ptr = (struct r2index*) realloc (store->index,
+						sizeof(struct r2index)*(2*store->maxBlock + 64));
+			if (ptr != NULL) {
+				store->index = ptr;
+				store->maxBlock = 2*store->maxBlock + 64;
+			};
+		};
+		if (store->nBlock < store->maxBlock) {
+			ptr = store->index + store->nBlock;
+			ptr->offset = ftell (store->out);
+			ptr->icount = sect->icount;
+			ptr->popRead = sect->popRead;
+			ptr->cutoff = sect->cutoff;
+			ptr->count = n;
+			ptr->p1First = *(sect->p1);
+			ptr->p2First = *(sect->p2);
+			ptr->p1Last = *(sect->p1 + n-1);
+			ptr->p2Last = *(sect->p2 + n-1);
+			fwrite (sect->p1, sizeof(int), n, store->out);
+			fwrite (sect->p2, sizeof(int), n, store->out);
+			fwrite (sect->chr1, sizeof(int), n, store->out);
+			fwrite (sect->chr2, sizeof(int), n, store->out);
+			fwrite (sect->nInd1, sizeof(int), n, store->out);
+			fwrite (sect->nInd2, sizeof(int), n, store->out);
+			fwrite (sect->nSamp, sizeof(float), n, store->out);
+			fwrite (sect->r2, sizeof(float), n, store->out);
+			fwrite (sect->r2drift, sizeof(float), n, store->out);
+			fwrite (sect->weight, sizeof(float), n, store->out);
+			(store->nBlock)++;
+		} else fprintf (sect->con, "Out of memory for index of r^2 store!\n");
+	}
+	sect->count = 0;
+}
+
+//-------------------------------------------------------------------------
+
+void R2Add (R2SECT sect, int p1, int p2, int m, int n, int nInd1,
+			int nInd2, float nSamp, float rB, float expR2, char weighsmp)
+// Oct 2026: keep r^2-value rB at locus pair (p1, p2), on chromosomes m, n
+// of chromoList (-1 if none), to be written when a block is full.
+// Weight is as in AddBurrVal.
+{
+	int k = sect->count;
+	float weight = (float) nInd1 * nInd2;
+	if (weighsmp > 0) weight *= (nSamp*nSamp);
+	*(sect->p1 + k) = p1 + 1;
+	*(sect->p2 + k) = p2 + 1;
+	*(sect->chr1 + k) = m + 1;
+	*(sect->chr2 + k) = n + 1;
+	*(sect->nInd1 + k) = nInd1;
+	*(sect->nInd2 + k) = nInd2;
+	*(sect->nSamp + k) = nSamp;
+	*(sect->r2 + k) = rB;
+	*(sect->r2drift + k) = rB - expR2;
+	*(sect->weight + k) = weight;
+	if (++(sect->count) == R2BLOCKPAIR) R2Flush (sect);
+}
+
+//-------------------------------------------------------------------------
+
+void R2End (R2SECT sect)
+// Oct 2026: write the rest of locus pairs in sect, free its columns.
+{
+	R2Flush (sect);
+	free (sect->p1);
+}
+
+//-------------------------------------------------------------------------
+
+RECOUT RecOpen (char *name)
+// Oct 2026: open file name to append records of results, return NULL if
+// failed. Format is CSV if name ends by ".csv" (column names RECHEAD are
+// written if the file is empty), otherwise a JSON object on each line.
+{
+	RECOUT rec;
+	int n = strlen (name);
+	if ((rec = (RECOUT) malloc(sizeof(struct recout))) == NULL) {
+		printf ("Out of memory for records of results!\n");
+		return NULL;
+	};
+	if ((rec->out = fopen (name, "a")) == NULL) {
+		perror (name);
+		free (rec);
+		return NULL;
+	};
+	rec->csv = (n >= 4 && strcmp (name+n-4, ".csv") == 0)? 1: 0;
+	fseek (rec->out, 0, SEEK_END);
+	if (rec->csv == 1 && ftell (rec->out) == 0)
+		fprintf (rec->out, "%s\n", RECHEAD);
+	return rec;
+}
+
+//-------------------------------------------------------------------------
+
+void RecClose (RECOUT rec)
+{
+	fclose (rec->out);
+	free (rec);
+}
+
+//-------------------------------------------------------------------------
+
+void PrtRecStr (FILE *out, char *str, char csv)
+// Oct 2026: write str quoted, for JSON if csv = 0, else for CSV
+{
+	fputc ('"', out);
+	for ( ; *str != '\0'; str++) {
+		if (*str == '"') fputc ((csv == 0)? '\\': '"', out);
+		else if (*str == '\\' && csv == 0) fputc ('\\', out);
+		fputc (*str, out);
+	};
+	fputc ('"', out);
+}
+
+//-------------------------------------------------------------------------
+
+void PrtRecord (RECOUT rec, struct result *res)
+// Oct 2026: write result res as a line of records file (see RecOpen),
+// fields as in RECHEAD, those not for the method are null in JSON, empty
+// in CSV. Estimates and CIs are as calculated, so those printed as
+// Infinite in other outputs are negative, or not less than INFINITE.
+{
+	int k;
+	FILE *out = rec->out;
+	char *name[10] = {"estimate", "paraLo", "paraHi", "jackLo", "jackHi",
+					"hMeanS", "indAlleles", "r2", "expR2", "jackDF"};
+	double val[10];
+	val[0] = res->estimate;
+	val[1] = res->paraLo;
+	val[2] = res->paraHi;
+	val[3] = res->jackLo;
+	val[4] = res->jackHi;
+	val[5] = res->hMean;
+	val[6] = (res->indAlle < 0)? NAN: res->indAlle;
+	val[7] = res->r2;
+	val[8] = res->expR2;
+	val[9] = (res->jackDF < 0)? NAN: res->jackDF;
+	if (rec->csv == 0) {
+		fprintf (out, "{\"input\":%d,\"pop\":%d,\"popID\":",
+				res->icount, res->popRead);
+		PrtRecStr (out, res->popID, 0);
+		if (res->samp >= 0) fprintf (out, ",\"samples\":%d", res->samp);
+		else fprintf (out, ",\"samples\":null");
+		fprintf (out, ",\"method\":\"%s\",\"crit\":%g", res->method,
+				res->cutoff);
+	} else {
+		fprintf (out, "%d,%d,", res->icount, res->popRead);
+		PrtRecStr (out, res->popID, 1);
+		if (res->samp >= 0) fprintf (out, ",%d", res->samp);
+		else fprintf (out, ",");
+		fprintf (out, ",%s,%g", res->method, res->cutoff);
+	};
+	for (k = 0; k < 10; k++) {
+		if (rec->csv == 0) fprintf (out, ",\"%s\":", name[k]);
+		else fputc (',', out);
+		if (isnan (val[k])) fprintf (out, "%s", (rec->csv == 0)? "null": "");
+		else fprintf (out, (k == 6 || k == 9)? "%.0f": "%.7g", val[k]);
+	};
+	fprintf (out, (rec->csv == 0)? "}\n": "\n");
+}
+
+//-------------------------------------------------------------------------
+// return the number of r^2-values in parameter list,
 // The function returns the number of locus pairs calculated in LD method
 
 unsigned long long LDRunPairs (
@@ -6720,6 +7820,8 @@ unsigned long long LDRunPairs (
 					unsigned long long *npairTot, long *npairSkip,	// in-out
 					unsigned long long prompt,	// in
 					// (to inform the user after "prompt" pairs calculated)
+// Oct 2026: progress file and console, see LDProgress, store of r^2, see R2Add
+					LDPROG prog, R2SECT r2Sect,
 					char sepBurOut, char moreCol, char BurAlePair,	// in
 // add in Mar 2016
 					char jack, int **p1Gen, int **p2Gen, int *noDatFish,
@@ -6734,13 +7836,20 @@ unsigned long long LDRunPairs (
 //double *r2Ave,
 //char *opened,
 
-					float epsilon)
+					float epsilon,
+// Oct 2026: statistics of locus pairs to evaluate from, or NULL
+					PAIRSTAT stat)
 {
 	char BurrPause = 0;
+	BURCALC calc = BurCalcPick (jack, weighsmp,
+							(outBurr != NULL && moreBurr == 1)? 1: 0);
 	int p1, p2;
 	int nInd1, nInd2;
 	float expR2, rB, nSamp;
 	int nMpairs;
+	int g;
+	int *slot = NULL;
+	PAIRRES res = NULL;
 // comment out the next line sinse those are used in
 //	float rdrift, reNSamp, nIndtot, weight, rBweight;
 
@@ -6762,6 +7871,12 @@ unsigned long long LDRunPairs (
 // of loci are in the set of accepted pairs given by array okLoc, which was
 // determined by function Loci_Eligible.
 // Then calculate Burrows coefficients by function Burrows_Calcul.
+// Oct 2026: loci of the same genotypes (see LocusDup) are paired only once
+// with each locus p1, results are reused for the others (not when there
+// are Burrows outputs). With jackknife on samples, at most LDDUPJACK/nfish
+// groups are kept.
+	if (outBurr == NULL || moreBurr != 1)
+		res = PairResBegin (fishHead, lastOK, okLoc, nfish, jack, 1, &slot);
 	for (p1=0; (p1<lastOK); p1++) {
 		if (*(okLoc+p1) == 0) continue;
 		allep1 = *(alleList+p1);
@@ -6769,6 +7884,8 @@ unsigned long long LDRunPairs (
 		for (p2=p1+1; (p2<=lastOK); p2++) {
 			if (*(okLoc+p2) == 0) continue;	// locus (p2+1) is skipped.
 			(*npairTot)++;
+			if (prog->out != NULL && (*npairTot) % LDPROGPAIR == 0)
+				LDProgress (prog, *npairTot, 1);
 			allep2 = *(alleList+p2);
 			popLoc2 = *(fishHead+p2);
 // changed in Nov 30, 11:
@@ -6778,7 +7895,18 @@ unsigned long long LDRunPairs (
 				BurrPause = 0;
 				(*nPairPtr)++;
 			}
-			Burrows_Calcul (cutoff, allep1, allep2, popLoc1, popLoc2,
+			g = (res != NULL)? *(slot+p2): -1;
+			if (g >= 0 && *(res->p1+g) != p1 && jack != 0)
+				memcpy (res->r2Count0, r2Count,
+						sizeof(unsigned long long)*nfish);
+			if (g >= 0 && *(res->p1+g) == p1)
+				PairResGet (res, g, &nSamp, &nInd1, &nInd2, &nMpairs, &rB,
+						&expR2, r2AtPairX, JweighPair, noDatFish, r2Count);
+			else if (stat != NULL && PairStatSeek (stat, p1, p2) == 1)
+				Burrows_Stat (cutoff, stat, &nSamp, &nInd1, &nInd2, &nMpairs,
+					&rB, &expR2, mValp1, freqp1, homop1, mValp2, freqp2,
+					homop2, epsilon);
+			else (*calc) (cutoff, allep1, allep2, popLoc1, popLoc2,
 					p1, p2, *(nMobil+p1), *(nMobil+p2), nfish, &nSamp,
 					&nInd1, &nInd2, &nMpairs, &rB, currPop, missptr,
 					outBurr, outBurrName, moreBurr, BurrPause, &expR2,
@@ -6791,6 +7919,9 @@ unsigned long long LDRunPairs (
 // temporarily add for checking:
 //r2JackTot,
 					JweighPair, r2Count, epsilon);
+			if (g >= 0 && *(res->p1+g) != p1)
+				PairResPut (res, g, p1, nSamp, nInd1, nInd2, nMpairs, rB,
+						expR2, r2AtPairX, JweighPair, noDatFish, r2Count);
 			if (nMpairs <= 0) {
 				(*npairSkip)++;
 				continue;
@@ -6802,11 +7933,14 @@ unsigned long long LDRunPairs (
 					nLocPairs, rB2, rBdrift, prodInd, sampCount, pairWt,
 					rAveTemp, totInd, wMeanSamp, rWeight, bigExpR2,
 					bigRprime, bigR);
+			if (r2Sect != NULL) R2Add (r2Sect, p1, p2, -1, -1, nInd1,
+							nInd2, nSamp, rB, expR2, weighsmp);
 			if (jack != 0) JackWeight (weighsmp, nSamp, nfish, noDatFish,
 							r2AtPairX, r2WRemSmp, JweighPair, JweightTot);
 // add this prompt to inform the user the progress:
 			if ((nLocPairs) == pairval) {
-				printf ("%18llu done, at loc. pair (%d, %d)\n", pairval, p1+1, p2+1);
+				fprintf (prog->con, "%18llu done, at loc. pair (%d, %d)\n",
+						pairval, p1+1, p2+1);
 				pairval +=prompt;
 			}
             // count the number of locus pairs nLocPairs.
@@ -6816,11 +7950,34 @@ unsigned long long LDRunPairs (
 			nLocPairs++;
 		}
 	}
+	RemovePairRes (res);
+	free (slot);
 	return nLocPairs++;
 }
 //-------------------------------------------------------------------------
 // Version of LDRunPairs, but locus pairs are taken across chromosomes
 
+int LDRowFirst (struct chromosome *chromoList, int m, int n, int k1)
+// Oct 2026: the first locus (in chromosome n) paired with locus k1 of
+// chromosome m: the next one if n = m, unless there is a distance window
+{
+	if (n != m) return 0;
+	if (chromoList[m].pairLo == NULL) return k1+1;
+	return (chromoList[m].pairLo)[k1];
+}
+
+//-------------------------------------------------------------------------
+
+int LDRowEnd (struct chromosome *chromoList, int m, int n, int k1)
+// Oct 2026: loci (in chromosome n) paired with locus k1 of chromosome m
+// are before this one
+{
+	if (n != m || chromoList[m].pairHi == NULL) return chromoList[n].nloci;
+	return (chromoList[m].pairHi)[k1];
+}
+
+//-------------------------------------------------------------------------
+
 unsigned long long LDTwoChromo (
 				float cutoff, ALLEPTR *alleList, int currPop,	// 3 in
 				int nfish, FISHPTR *fishHead, int *nMobil,		// 3 in
@@ -6845,6 +8002,8 @@ unsigned long long LDTwoChromo (
 				unsigned long long *npairTot, long *npairSkip,	// 2 in-out
 				unsigned long long prompt,						// 1 in
 					// (to inform the user after "prompt" pairs calculated)
+// Oct 2026: progress file and console, see LDProgress, store of r^2, see R2Add
+				LDPROG prog, R2SECT r2Sect,
 				char sepBurOut, char moreCol, char BurAlePair,	// 3 in
 // add 2 in-parameters in Apr 2015:
 				struct chromosome *chromoList, int nChromo,		// 2 in
@@ -6864,6 +8023,8 @@ unsigned long long LDTwoChromo (
 {
 
 	char BurrPause = 0;
+	BURCALC calc = BurCalcPick (jack, weighsmp,
+							(outBurr != NULL && moreBurr == 1)? 1: 0);
 	int p1, p2, nInd1, nInd2;
 	int m, k1, k2, n;
 	int pair12;
@@ -6915,7 +8076,8 @@ unsigned long long LDTwoChromo (
 			pair12 = 0;
 			for (k1 = 0; k1 < chromoList[m].nloci; k1++) {
 				p1 = (chromoList[m].locus)[k1]; // "p" is increasing with "k"
-				if (p1 > lastOK) break;	// quit when it passes last accepted one
+				// Oct 2026: not "break", loci may be in order of positions
+				if (p1 > lastOK) continue;	// past last accepted one
 				if (*(okLoc+p1) == 0) continue;
 				allep1 = *(alleList+p1);
 				popLoc1 = *(fishHead+p1);
@@ -6924,6 +8086,8 @@ unsigned long long LDTwoChromo (
 					if (*(okLoc+p2) == 0) continue;
 					if (p2 > lastOK) break;
 					(*npairTot)++;
+					if (prog->out != NULL && (*npairTot) % LDPROGPAIR == 0)
+						LDProgress (prog, *npairTot, 1);
 					allep2 = *(alleList+p2);
 					popLoc2 = *(fishHead+p2);
 					if (p1 - locSkip >= LOCBURR || p2 - locSkip >= LOCBURR) {
@@ -6932,7 +8096,7 @@ unsigned long long LDTwoChromo (
 						BurrPause = 0;
 						(*nPairPtr)++;
 					}
-					Burrows_Calcul (cutoff, allep1, allep2, popLoc1, popLoc2,
+					(*calc) (cutoff, allep1, allep2, popLoc1, popLoc2,
 						p1, p2, *(nMobil+p1), *(nMobil+p2), nfish, &nSamp,
 						&nInd1, &nInd2, &nMpairs, &rB, currPop, missptr,
 						outBurr, outBurrName, moreBurr, BurrPause, &expR2,
@@ -6957,13 +8121,16 @@ unsigned long long LDTwoChromo (
 							locSkip, nLocPairs, rB2, rBdrift, prodInd,
 							sampCount, pairWt, rAveTemp, totInd, wMeanSamp,
 							rWeight, bigExpR2, bigRprime, bigR);
+					if (r2Sect != NULL) R2Add (r2Sect, p1, p2, m, n, nInd1,
+							nInd2, nSamp, rB, expR2, weighsmp);
 					if (jack != 0)
 						JackWeight (weighsmp, nSamp, nfish, noDatFish,
 							r2AtPairX, r2WRemSmp, JweighPair, JweightTot);
 
 				// add this prompt to inform the user the progress:
 					if ((nLocPairs) == pairval) {
-						printf ("%18llu done, at loc. pair (%d, %d)\n",
+						fprintf (prog->con,
+							"%18llu done, at loc. pair (%d, %d)\n",
 								pairval, p1+1, p2+1);
 						pairval +=prompt;
 					}
@@ -7011,6 +8178,8 @@ unsigned long long LDOneChromo (
 				unsigned long long *npairTot, long *npairSkip,	// 2 in-out
 				unsigned long long prompt,						// 1 in
 					// (to inform the user after "prompt" pairs calculated)
+// Oct 2026: progress file and console, see LDProgress, store of r^2, see R2Add
+				LDPROG prog, R2SECT r2Sect,
 				char sepBurOut, char moreCol, char BurAlePair,	// 3 in
 // add 2 in-parameters in Apr 2015:
 				struct chromosome *chromoList, int nChromo,		// 2 in-out
@@ -7029,6 +8198,8 @@ unsigned long long LDOneChromo (
 {
 
 	char BurrPause = 0;
+	BURCALC calc = BurCalcPick (jack, weighsmp,
+							(outBurr != NULL && moreBurr == 1)? 1: 0);
 	int p1, p2, nInd1, nInd2;
 	int m, k1, k2;
 	int pair12;
@@ -7068,15 +8239,20 @@ unsigned long long LDOneChromo (
 		pair12 = 0;
 		for (k1 = 0; k1 < (chromoList[m].nloci - 1); k1++) {
 			p1 = (chromoList[m].locus)[k1]; // "p" is increasing with "k"
-			if (p1 > lastOK) break;	// quit when it passes last accepted one
+			// Oct 2026: not "break", loci may be in order of positions
+			if (p1 > lastOK) continue;	// past last accepted one
 			if (*(okLoc+p1) == 0) continue;
 			allep1 = *(alleList+p1);
 			popLoc1 = *(fishHead+p1);
-			for (k2 = k1+1; k2 < chromoList[m].nloci; k2++) {
+			// Oct 2026: loci in the distance window, if any
+			for (k2 = LDRowFirst (chromoList, m, m, k1);
+				k2 < LDRowEnd (chromoList, m, m, k1); k2++) {
 				p2 = (chromoList[m].locus)[k2];
 				if (*(okLoc+p2) == 0) continue;
 				if (p2 > lastOK) break;
 				(*npairTot)++;
+				if (prog->out != NULL && (*npairTot) % LDPROGPAIR == 0)
+					LDProgress (prog, *npairTot, 1);
 				allep2 = *(alleList+p2);
 				popLoc2 = *(fishHead+p2);
 				if (p1 - locSkip >= LOCBURR || p2 - locSkip >= LOCBURR) {
@@ -7085,7 +8261,7 @@ unsigned long long LDOneChromo (
 					BurrPause = 0;
 					(*nPairPtr)++;
 				}
-				Burrows_Calcul (cutoff, allep1, allep2, popLoc1, popLoc2,
+				(*calc) (cutoff, allep1, allep2, popLoc1, popLoc2,
 						p1, p2, *(nMobil+p1), *(nMobil+p2), nfish, &nSamp,
 						&nInd1, &nInd2, &nMpairs, &rB, currPop, missptr,
 						outBurr, outBurrName, moreBurr, BurrPause, &expR2,
@@ -7110,13 +8286,15 @@ unsigned long long LDOneChromo (
 							locSkip, nLocPairs, rB2, rBdrift, prodInd,
 							sampCount, pairWt, rAveTemp, totInd, wMeanSamp,
 							rWeight, bigExpR2, bigRprime, bigR);
+				if (r2Sect != NULL) R2Add (r2Sect, p1, p2, m, m, nInd1,
+							nInd2, nSamp, rB, expR2, weighsmp);
 				if (jack != 0)
 					JackWeight (weighsmp, nSamp, nfish, noDatFish,
 							r2AtPairX, r2WRemSmp, JweighPair, JweightTot);
 
 				// add this prompt to inform the user the progress:
 				if ((nLocPairs) == pairval) {
-					printf ("%18llu done, at loc. pair (%d, %d)\n",
+					fprintf (prog->con, "%18llu done, at loc. pair (%d, %d)\n",
 								pairval, p1+1, p2+1);
 					pairval +=prompt;
 				}
@@ -7135,124 +8313,1310 @@ unsigned long long LDOneChromo (
 }
 
 
-// --------------------------------------------------------------------------
-
-void Pair_Analysis (float cutoff, ALLEPTR *alleList, int currPop,
-						int nfish, FISHPTR *fishHead, int *nMobil,
-						int *missptr, int lastOK, char *okLoc,
-						double *nIndSum, float *rB2WAve, float *wHarmonic,
-						float *wExpR2, FILE *outBurr,
-//						FILE *outLoc, char moreDat,
-						char moreBurr, char *outBurrName,
-						unsigned long long *nBurrAve, float *rB2, float *rBdrift,
-						float *prodInd, float *sampCount, float *pairWt,
-						float *r2driftAve, float *totWeight, float *bigR2,
-						float *bigRdrift, char weighsmp, FILE *rAveTemp,
-// add in jan 2015
-						char sepBurOut, char moreCol, char BurAlePair,
-// temporarily added for checking:
-//char *opened,
-// add in Apr 2015
-						struct chromosome *chromoList, int nChromo, char chroGrp,
-// add in Jan, ..., 2016
-						char jack, int *mValp1, float *freqp1, float *homop1,
-						int *mValp2, float *freqp2, float *homop2,
-						double *r2WRemSmp, unsigned long long *r2Count)
-// rBdrift stores r2-drift for all locus pairs
-// prodInd stores product of ind. alleles at locus pairs
-// sampCount stores sample sizes for all locus pairs
+//-------------------------------------------------------------------------
+// Oct 2026: Scheduler for LD method on chromosomes, using more than one
+// thread. Locus pairs of LDOneChromo or LDTwoChromo are put in tasks,
+// which are run concurrently, heaviest first. Outputs at locus pairs are
+// then added to the totals in the same order as the serial run, so that
+// the results are the same.
+//-------------------------------------------------------------------------
 
+LDSCR MakeLDScr (int nfish, int maxNAlle)
+// Allocate work arrays for Burrows_Calcul, return NULL if failed.
 {
-// change to double (Apr 2012)
-    double bigR = 0.0;	// total of rB taken over all locus pairs, weighted
-						// by independent of allele pairs.
-//    float rBAveTotal = 0.0;	// sum of r2-averaged values to be stored,
-							// then retrieved later for Jackknife
-	int i, p;
-	float sign;
-// because of rouding off errors, use these to calculate (Apr 2012):
-	double wMeanSamp, totInd;	// weighted harmonic mean samp size, ind. alleles
-	double rWeight, bigExpR2, bigRprime;
-// add time to inform user:
-//	time_t rawtime;
-//	char info[15], *timeptr;
-// added Sep.- Nov 2011 the following variables:
-	int locSkip = 0;
-//	char BurrPause = 0;
-	long npairSkip = 0;
-	unsigned long long prompt;
-	unsigned long long nLocPairs = 0;
-	unsigned long long nPairPtr = 0;
-	unsigned long long npairTot = 0;
-	unsigned long long maxpairs;
+	int i;
+	int *genes;
+	LDSCR scr;
+	if ((scr = (LDSCR) calloc(1, sizeof(struct ldscr))) == NULL)
+		return NULL;
+	scr->p1Gen = (int**) malloc(sizeof(int*)*2*nfish);
+	genes = (int*) malloc(sizeof(int)*(5*nfish + 2*maxNAlle));
+	scr->countm1 = (char*) malloc(sizeof(char)*2*nfish);
+	scr->freqp1 = (float*) malloc(sizeof(float)*(2*nfish + 4*maxNAlle));
+	scr->r2Count = (unsigned long long*)
+					calloc(nfish, sizeof(unsigned long long));
+	if (scr->p1Gen == NULL || genes == NULL || scr->countm1 == NULL
+		|| scr->freqp1 == NULL || scr->r2Count == NULL) {
+		free (scr->p1Gen);
+		free (genes);
+		free (scr->countm1);
+		free (scr->freqp1);
+		free (scr->r2Count);
+		free (scr);
+		return NULL;
+	}
+	scr->p2Gen = scr->p1Gen + nfish;
+	for (i = 0; i < nfish; i++) {
+		scr->p1Gen[i] = genes + 2*i;
+		scr->p2Gen[i] = genes + 2*(nfish+i);
+	}
+	scr->noDatFish = genes + 4*nfish;
+	scr->mValp1 = scr->noDatFish + nfish;
+	scr->mValp2 = scr->mValp1 + maxNAlle;
+	scr->countm2 = scr->countm1 + nfish;
+	scr->homop1 = scr->freqp1 + maxNAlle;
+	scr->freqp2 = scr->homop1 + maxNAlle;
+	scr->homop2 = scr->freqp2 + maxNAlle;
+	scr->r2AtPairX = scr->homop2 + maxNAlle;
+	scr->JweighPair = scr->r2AtPairX + nfish;
+	return scr;
+}
 
-// added Mar 2016 -----------------------------------------------------
-// The following arrays are to store info at a pair of loci, say (p1, p2).
-// p1Gen, p2Gen are for genotypes of samples at two loci p1, p2
-// noDatFish is to indicate which sample has no data, or both have data
-// For sample (i+1)th:
-// noDatFish[i] = 0: both loci have data,
-//              = 1: no data at locus p1,
-//              = 2: no data at locus p2,
-//              = 3: both loci have no data.
-// countm1[i] = number of copies of a particular allele m1 at locus p1,
-// countm2[i] = number of copies of a particular allele m2 at locus p2,
-// Allocating them here, not at Burrows_Calcul (indirectly called by this
-// function) to decrease execution time, since Burrows_Calcul is called
-// repeatedly (at each pair of loci). Memory allocations consume time!
-	int **p1Gen = (int**) malloc(sizeof(int*)*nfish);
-	int **p2Gen = (int**) malloc(sizeof(int*)*nfish);
-	int *noDatFish = (int*) malloc(sizeof(int)*nfish);
-	char *countm1 = (char*) malloc(sizeof(char)*nfish);
-	char *countm2 = (char*) malloc(sizeof(char)*nfish);
+//-------------------------------------------------------------------------
 
-// those are actually needed to declare here:
-	float *r2AtPairX = (float*) malloc(sizeof(float)*nfish);
-// temporarily add for checking:
-//double *r2JackTot = (double*) malloc(sizeof(double)*nfish);
+void RemoveLDScr (LDSCR scr)
+{
+	if (scr == NULL) return;
+	free (scr->p1Gen[0]);	// block of genotypes, noDatFish, mValp1, mValp2
+	free (scr->p1Gen);
+	free (scr->countm1);
+	free (scr->freqp1);
+	free (scr->r2Count);
+	free (scr);
+}
 
-	float *JweighPair = (float*) malloc(sizeof(float)*nfish);
-	double *JweightTot = (double*) malloc(sizeof(double)*nfish);
-	for (i = 0; i < nfish; i++) {
-		p1Gen[i] = (int*) malloc (2*sizeof(int));
-		p2Gen[i] = (int*) malloc (2*sizeof(int));
-		r2Count[i] = 0;
-		r2AtPairX[i] = 0;
-// temporarily add for checking:
-//r2JackTot[i] = 0;
-		JweighPair[i] = 0;
-		JweightTot[i] = 0;
-		r2WRemSmp[i] = 0;
+//-------------------------------------------------------------------------
+
+unsigned long long LDRowPairs (struct chromosome *chromoList, int m, int n,
+								int k1, int lastOK, char *okLoc)
+// Number of locus pairs at row k1 of chromosome m, paired with later loci
+// in m if n = m (in the distance window, if any), or with loci in
+// chromosome n. Loci are skipped in the same way as in LDOneChromo,
+// LDTwoChromo.
+{
+	int k2, p1, p2;
+	unsigned long long count = 0;
+	p1 = (chromoList[m].locus)[k1];
+	if (p1 > lastOK || *(okLoc+p1) == 0) return 0;
+	for (k2 = LDRowFirst (chromoList, m, n, k1);
+		k2 < LDRowEnd (chromoList, m, n, k1); k2++) {
+		p2 = (chromoList[n].locus)[k2];
+		if (*(okLoc+p2) == 0) continue;
+		if (p2 > lastOK) break;
+		count++;
 	}
+	return count;
+}
 
-	float epsilon = (float) 8*nfish*nfish;
-	epsilon = (1/epsilon);
-	// for a rational number r (0 <= r) whose denominator <= 4*(nfish)^2,
-	// r < epsilon implies r = 0.
-// --------------------------------------------------------------------
+//-------------------------------------------------------------------------
 
-//	ALLEPTR allep1, allep2;
-//	FISHPTR popLoc1, popLoc2;
+unsigned long long LDPairTotal (struct chromosome *chromoList, int nChromo,
+								int chroGrp, int lastOK, char *okLoc)
+// Oct 2026: number of locus pairs to go over when loci are paired within
+// each chromosome (chroGrp = 1) or across chromosomes (chroGrp = 2),
+// for reporting progress.
+{
+	int m, n, k1;
+	unsigned long long total = 0;
+	for (m = 0; m < nChromo; m++)
+		for (n = (chroGrp == 1)? m: m+1; n <= ((chroGrp == 1)? m: nChromo-1);
+			n++)
+			for (k1 = 0; k1 < chromoList[m].nloci; k1++)
+				total += LDRowPairs (chromoList, m, n, k1, lastOK, okLoc);
+	return total;
+}
 
-	*nBurrAve = 0;		// number of r2-averaged values
-	*nIndSum = 0;		// Total of independent comparisons
-	*rB2WAve = 0;
-	*wHarmonic = 0;
-	*totWeight = 0;
-	*wExpR2 = 0;
-	*r2driftAve = 0;
-// these are double precision, will be assigned to parameters when done
-	wMeanSamp = 0;
-	totInd = 0;
-	rWeight = 0;
-/*
-	if (outLoc != NULL && (moreDat == 1)) {
-		for (i=0; i<40; i++) fprintf (outLoc, "-");
-		fprintf (outLoc, "\n\n");
-		fprintf (outLoc, "\nFor Linkage Disequilibrium Method\n");
-		for (i=0; i<45; i++) fprintf (outLoc, "-");
-		fprintf (outLoc, "\n   Locus pair    N. Ind. pair   #Samp. w/data\n");
-		fflush (outLoc);
+//-------------------------------------------------------------------------
+
+LDTASK LDMakeTasks (struct chromosome *chromoList, int nChromo, char within,
+					int lastOK, char *okLoc, unsigned long long blockPair,
+					int *nTask)
+// Tasks in the serial order of LDOneChromo (within = 1) or LDTwoChromo
+// (within = 0). Rows of a chromosome (or a pair of chromosomes) are put
+// in blocks of about blockPair locus pairs, so large chromosomes are split
+// and small ones are one task. Return NULL if out of memory.
+{
+	int m, n, nLast, k1, maxTask = 64;
+	unsigned long long rowPair, total = 0;
+	LDTASK tasks, task;
+	*nTask = 0;
+	if ((tasks = (LDTASK) malloc(sizeof(struct ldtask)*maxTask)) == NULL)
+		return NULL;
+	for (m = 0; m < nChromo; m++) {
+		nLast = (within == 1)? m: nChromo-1;
+		for (n = (within == 1)? m: m+1; n <= nLast; n++) {
+			task = NULL;
+			for (k1 = 0; k1 < chromoList[m].nloci; k1++) {
+				rowPair = LDRowPairs (chromoList, m, n, k1, lastOK, okLoc);
+				if (rowPair == 0) continue;
+				if (task == NULL || task->nPair >= blockPair) {
+					if (*nTask == maxTask) {
+						maxTask *= 2;
+						task = (LDTASK) realloc (tasks,
+										sizeof(struct ldtask)*maxTask);
+						if (task == NULL) {
+							free (tasks);
+							return NULL;
+						}
+						tasks = task;
+					}
+					task = tasks + (*nTask)++;
+					task->m = m;
+					task->n = n;
+					task->k1Lo = k1;
+					task->nPair = 0;
+					task->first = total;
+				}
+				task->k1Hi = k1 + 1;
+				task->nPair += rowPair;
+				total += rowPair;
+			}
+		}
+	}
+	return tasks;
+}
+
+//-------------------------------------------------------------------------
+
+int LDTaskCmp (const void *a, const void *b)
+// for qsort: tasks with more locus pairs first, then in serial order
+{
+	LDTASK t1 = *(LDTASK*) a;
+	LDTASK t2 = *(LDTASK*) b;
+	if (t1->nPair != t2->nPair) return (t1->nPair > t2->nPair)? -1: 1;
+	return (t1->first < t2->first)? -1: 1;
+}
+
+//-------------------------------------------------------------------------
+
+void LDRunTask (LDTASK task, struct chromosome *chromoList,
+				float cutoff, ALLEPTR *alleList, int currPop,
+				int nfish, FISHPTR *fishHead, int *nMobil,
+				int *missptr, int lastOK, char *okLoc, char weighsmp,
+				char sepBurOut, char moreCol, char BurAlePair, char jack,
+				LDSCR scr, struct ldpair *pairs, float *r2X, float *jwX,
+				int *noDatX, float epsilon)
+// Calculate Burrows coefficients at the locus pairs of the task, into
+// array pairs. When jack != 0, r2AtPairX, JweighPair, noDatFish of the
+// pairs are kept in r2X, jwX, noDatX (nfish entries per pair).
+// Nothing is written to Burrows file, so pairs can be done in any order.
+{
+	int k1, k2, p1, p2;
+	int m = task->m, n = task->n;
+	BURCALC calc = BurCalcPick (jack, weighsmp, 0);
+	float *r2AtPairX = scr->r2AtPairX;
+	float *JweighPair = scr->JweighPair;
+	int *noDatFish = scr->noDatFish;
+	for (k1 = task->k1Lo; k1 < task->k1Hi; k1++) {
+		p1 = (chromoList[m].locus)[k1];
+		if (p1 > lastOK || *(okLoc+p1) == 0) continue;
+		for (k2 = LDRowFirst (chromoList, m, n, k1);
+			k2 < LDRowEnd (chromoList, m, n, k1); k2++) {
+			p2 = (chromoList[n].locus)[k2];
+			if (*(okLoc+p2) == 0) continue;
+			if (p2 > lastOK) break;
+			if (jack != 0) {
+				r2AtPairX = r2X;
+				JweighPair = jwX;
+				noDatFish = noDatX;
+				r2X += nfish;
+				jwX += nfish;
+				noDatX += nfish;
+			}
+			pairs->p1 = p1;
+			pairs->p2 = p2;
+			pairs->m = m;
+			pairs->n = n;
+			(*calc) (cutoff, *(alleList+p1), *(alleList+p2),
+					*(fishHead+p1), *(fishHead+p2), p1, p2,
+					*(nMobil+p1), *(nMobil+p2), nfish, &(pairs->nSamp),
+					&(pairs->nInd1), &(pairs->nInd2), &(pairs->nMpairs),
+					&(pairs->rB), currPop, missptr, NULL, NULL, 0, 1,
+					&(pairs->expR2), weighsmp, sepBurOut, moreCol,
+					BurAlePair, jack, scr->p1Gen, scr->p2Gen, noDatFish,
+					scr->countm1, scr->countm2, scr->mValp1, scr->freqp1,
+					scr->homop1, scr->mValp2, scr->freqp2, scr->homop2,
+					r2AtPairX, JweighPair, scr->r2Count, epsilon);
+			pairs++;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------
+// Same as LDOneChromo (within = 1) or LDTwoChromo (within = 0), running
+// tasks concurrently when there are more than one thread and Burrows
+// coefficients are not written at each pair. Otherwise, or when out of
+// memory, those functions are called.
+
+unsigned long long LDChromoSched (char within,
+				float cutoff, ALLEPTR *alleList, int currPop,
+				int nfish, FISHPTR *fishHead, int *nMobil,
+				int *missptr, int lastOK, char *okLoc,
+				FILE *outBurr, char moreBurr, char *outBurrName,
+				float *rB2, float *rBdrift, float *prodInd,
+				float *sampCount, float *pairWt,
+				char weighsmp, int locSkip, FILE *rAveTemp,
+				double *totInd, double *wMeanSamp,
+				double *rWeight, double *bigExpR2,
+				double *bigRprime, double *bigR,
+				unsigned long long *nPairPtr,
+				unsigned long long *npairTot, long *npairSkip,
+				unsigned long long prompt,
+// Oct 2026: progress file and console, see LDProgress, store of r^2, see R2Add
+				LDPROG prog, R2SECT r2Sect,
+				char sepBurOut, char moreCol, char BurAlePair,
+				struct chromosome *chromoList, int nChromo,
+				char jack, int **p1Gen, int **p2Gen, int *noDatFish,
+				char *countm1, char *countm2,
+				int *mValp1, float *freqp1, float *homop1,
+				int *mValp2, float *freqp2, float *homop2, float *r2AtPairX,
+				unsigned long long *r2Count,
+				double *r2WRemSmp, float *JweighPair, double *JweightTot,
+				float epsilon)
+{
+	int k, t, nTask, iTask, lastTask, maxNAlle;
+	int nThread = 1;
+	unsigned long long winPair, blockPair, nWin, j, pairval;
+	unsigned long long nLocPairs = 0;
+	char memOK;
+	LDTASK tasks = NULL;
+	LDTASK *order = NULL;
+	LDSCR *scr = NULL;
+	struct ldpair *pairs = NULL, *pr;
+	float *r2X = NULL, *jwX = NULL;
+	int *noDatX = NULL;
+
+#ifdef _OPENMP
+	// serial when inputs or populations are already run concurrently,
+	// unless nested threads are allowed (see PopCompute)
+	nThread = (omp_get_active_level() < omp_get_max_active_levels())?
+			omp_get_max_threads(): 1;
+#endif
+	memOK = (nThread > 1 && (outBurr == NULL || moreBurr != 1))? 1: 0;
+	if (memOK == 1) {
+		winPair = LDWINPAIR;
+		if (jack != 0 && winPair > LDWINJACK/nfish) winPair = LDWINJACK/nfish;
+		if (winPair < 1) winPair = 1;
+		blockPair = winPair/(nThread*LDTASKDIV);
+		if (blockPair < 1) blockPair = 1;
+		tasks = LDMakeTasks (chromoList, nChromo, within, lastOK, okLoc,
+							blockPair, &nTask);
+		if (tasks == NULL) memOK = 0;
+	}
+	if (memOK == 1) {
+	// buffer must hold a window of tasks, or the largest task
+		for (iTask = 0; iTask < nTask; iTask++)
+			if ((tasks+iTask)->nPair > winPair) winPair = (tasks+iTask)->nPair;
+		maxNAlle = 0;
+		for (k = 0; k <= lastOK; k++)
+			if (*(nMobil+k) > maxNAlle) maxNAlle = *(nMobil+k);
+		maxNAlle++;
+		order = (LDTASK*) malloc(sizeof(LDTASK)*(nTask+1));
+		pairs = (struct ldpair*) malloc(sizeof(struct ldpair)*winPair);
+		if ((scr = (LDSCR*) calloc(nThread, sizeof(LDSCR))) != NULL)
+			for (t = 0; t < nThread; t++)
+				if ((*(scr+t) = MakeLDScr (nfish, maxNAlle)) == NULL) memOK = 0;
+		if (jack != 0) {
+			r2X = (float*) malloc(sizeof(float)*winPair*nfish);
+			jwX = (float*) malloc(sizeof(float)*winPair*nfish);
+			noDatX = (int*) malloc(sizeof(int)*winPair*nfish);
+			if (r2X == NULL || jwX == NULL || noDatX == NULL) memOK = 0;
+		}
+		if (order == NULL || pairs == NULL || scr == NULL) memOK = 0;
+	}
+	if (memOK == 0) {
+		free (tasks);
+		free (order);
+		free (pairs);
+		free (r2X);
+		free (jwX);
+		free (noDatX);
+		if (scr != NULL) {
+			for (t = 0; t < nThread; t++) RemoveLDScr (*(scr+t));
+			free (scr);
+		}
+		if (within == 1)
+			return LDOneChromo (cutoff, alleList, currPop, nfish,
+							fishHead, nMobil, missptr, lastOK, okLoc,
+							outBurr, moreBurr, outBurrName, rB2,
+							rBdrift, prodInd, sampCount, pairWt,
+							weighsmp, locSkip, rAveTemp, totInd,
+							wMeanSamp, rWeight, bigExpR2, bigRprime,
+							bigR, nPairPtr, npairTot, npairSkip,
+							prompt, prog, r2Sect, sepBurOut, moreCol, BurAlePair,
+							chromoList, nChromo,
+							jack, p1Gen, p2Gen, noDatFish, countm1,
+							countm2, mValp1, freqp1, homop1, mValp2,
+							freqp2, homop2, r2AtPairX, r2Count,
+							r2WRemSmp, JweighPair, JweightTot, epsilon);
+		return LDTwoChromo (cutoff, alleList, currPop, nfish,
+							fishHead, nMobil, missptr, lastOK, okLoc,
+							outBurr, moreBurr, outBurrName, rB2,
+							rBdrift, prodInd, sampCount, pairWt,
+							weighsmp, locSkip, rAveTemp, totInd,
+							wMeanSamp, rWeight, bigExpR2, bigRprime,
+							bigR, nPairPtr, npairTot, npairSkip,
+							prompt, prog, r2Sect, sepBurOut, moreCol, BurAlePair,
+							chromoList, nChromo,
+							jack, p1Gen, p2Gen, noDatFish, countm1,
+							countm2, mValp1, freqp1, homop1, mValp2,
+							freqp2, homop2, r2AtPairX, r2Count,
+							r2WRemSmp, JweighPair, JweightTot, epsilon);
+	}
+
+	// to inform the user after "prompt" pairs calculated;
+	pairval = prompt;
+	for (iTask = 0; iTask < nTask; iTask = lastTask) {
+	// a window: tasks iTask, ..., (lastTask-1), with nWin locus pairs
+		nWin = (tasks+iTask)->nPair;
+		for (lastTask = iTask+1; lastTask < nTask; lastTask++) {
+			if (nWin + (tasks+lastTask)->nPair > winPair) break;
+			nWin += (tasks+lastTask)->nPair;
+		}
+		for (t = iTask; t < lastTask; t++) *(order+t-iTask) = tasks+t;
+		qsort (order, lastTask-iTask, sizeof(LDTASK), LDTaskCmp);
+		#pragma omp parallel for schedule(dynamic) num_threads(nThread) \
+				if (lastTask-iTask > 1)
+		for (t = 0; t < lastTask-iTask; t++) {
+			LDTASK task = *(order+t);
+			unsigned long long at = task->first - (tasks+iTask)->first;
+			int id = 0;
+#ifdef _OPENMP
+			id = omp_get_thread_num();
+#endif
+			LDRunTask (task, chromoList, cutoff, alleList, currPop, nfish,
+					fishHead, nMobil, missptr, lastOK, okLoc, weighsmp,
+					sepBurOut, moreCol, BurAlePair, jack, *(scr+id),
+					pairs+at, (jack != 0)? r2X+at*nfish: NULL,
+					(jack != 0)? jwX+at*nfish: NULL,
+					(jack != 0)? noDatX+at*nfish: NULL, epsilon);
+		}
+	// add to totals in serial order, as in LDOneChromo, LDTwoChromo
+		for (j = 0, pr = pairs; j < nWin; j++, pr++) {
+			(*npairTot)++;
+			if (prog->out != NULL && (*npairTot) % LDPROGPAIR == 0)
+				LDProgress (prog, *npairTot, 1);
+			if (pr->p1 - locSkip < LOCBURR && pr->p2 - locSkip < LOCBURR)
+				(*nPairPtr)++;
+			if (pr->nMpairs <= 0) {
+				(*npairSkip)++;
+				continue;
+			}
+			AddBurrVal (pr->nInd1, pr->nInd2, pr->rB, pr->nSamp, pr->expR2,
+						weighsmp, locSkip, nLocPairs, rB2, rBdrift, prodInd,
+						sampCount, pairWt, rAveTemp, totInd, wMeanSamp,
+						rWeight, bigExpR2, bigRprime, bigR);
+			if (r2Sect != NULL) R2Add (r2Sect, pr->p1, pr->p2, pr->m, pr->n,
+							pr->nInd1, pr->nInd2, pr->nSamp, pr->rB,
+							pr->expR2, weighsmp);
+			if (jack != 0)
+				JackWeight (weighsmp, pr->nSamp, nfish, noDatX+j*nfish,
+							r2X+j*nfish, r2WRemSmp, jwX+j*nfish, JweightTot);
+			if ((nLocPairs) == pairval) {
+				fprintf (prog->con, "%18llu done, at loc. pair (%d, %d)\n",
+						pairval, pr->p1+1, pr->p2+1);
+				pairval +=prompt;
+			}
+			nLocPairs++;
+		}
+	}
+
+	for (t = 0; t < nThread; t++) {
+		for (k = 0; k < nfish; k++) r2Count[k] += (*(scr+t))->r2Count[k];
+		RemoveLDScr (*(scr+t));
+	}
+	free (scr);
+	free (tasks);
+	free (order);
+	free (pairs);
+	free (r2X);
+	free (jwX);
+	free (noDatX);
+	return nLocPairs;
+}
+
+//-------------------------------------------------------------------------
+
+unsigned long long LDRunTiles (
+				float cutoff, ALLEPTR *alleList, int currPop,
+				int nfish, FISHPTR *fishHead, int *nMobil,
+				int *missptr, int lastOK, char *okLoc,
+				FILE *outBurr, char moreBurr, char *outBurrName,
+				float *rB2, float *rBdrift, float *prodInd,
+				float *sampCount, float *pairWt,
+				char weighsmp, int locSkip, FILE *rAveTemp,
+				double *totInd, double *wMeanSamp,
+				double *rWeight, double *bigExpR2,
+				double *bigRprime, double *bigR,
+				unsigned long long *nPairPtr,
+				unsigned long long *npairTot, long *npairSkip,
+				unsigned long long prompt, LDPROG prog, R2SECT r2Sect,
+				char sepBurOut, char moreCol, char BurAlePair,
+				char jack, int **p1Gen, int **p2Gen, int *noDatFish,
+				char *countm1, char *countm2,
+				int *mValp1, float *freqp1, float *homop1,
+				int *mValp2, float *freqp2, float *homop2, float *r2AtPairX,
+				unsigned long long *r2Count,
+				double *r2WRemSmp, float *JweighPair, double *JweightTot,
+				float epsilon, PAIRSTAT stat)
+// Oct 2026: same as LDRunPairs, with locus pairs gone over in tiles. Loci
+// (rows p1) are taken in bands; pairs of a band are calculated in tiles of
+// nTile columns (loci p2), so that genotypes of the loci of a tile stay in
+// the cache (LDTILEMEM bytes), then added to the totals in serial order,
+// as by LDRunPairs. LDRunPairs is called if Burrows coefficients are
+// written, pairs are from pair statistics, the loci are in one tile, or
+// when out of memory.
+{
+	int a, b, a0, a1, c0, c1, p1, p2, g, nOK, nTile, nBand = 0;
+	int *loc = NULL, *slot = NULL;
+	unsigned long long winPair, nWin, j, pairval;
+	unsigned long long *rowAt = NULL;
+	unsigned long long nLocPairs = 0;
+	char memOK;
+	struct ldpair *pairs = NULL, *pr;
+	float *r2X = NULL, *jwX = NULL, *r2P, *jwP;
+	int *noDatX = NULL, *ndP;
+	PAIRRES res = NULL;
+	BURCALC calc = BurCalcPick (jack, weighsmp, 0);
+
+	// a locus has a node struct fish for each sample, taken twice for
+	// the memory allocated; a tile has nTile loci of rows and of columns
+	nTile = LDTILEMEM/(4*nfish*(int) sizeof(struct fish));
+	for (nOK = 0, a = 0; a <= lastOK; a++) if (*(okLoc+a) != 0) nOK++;
+	memOK = ((outBurr == NULL || moreBurr != 1) && stat == NULL
+			&& nTile >= LDTILEMIN && nOK > nTile)? 1: 0;
+	if (memOK == 1) {
+	// the buffer holds pairs of a band, nBand rows
+		winPair = LDWINPAIR;
+		if (jack != 0 && winPair > LDWINJACK/nfish) winPair = LDWINJACK/nfish;
+		nBand = (winPair/nOK < nTile)? (int) (winPair/nOK): nTile;
+		if (nBand < LDTILEMIN) memOK = 0;
+	}
+	if (memOK == 1) {
+		winPair = (unsigned long long) nBand*nOK;
+		loc = (int*) malloc(sizeof(int)*nOK);
+		rowAt = (unsigned long long*)
+				malloc(sizeof(unsigned long long)*(nBand+1));
+		pairs = (struct ldpair*) malloc(sizeof(struct ldpair)*winPair);
+		if (jack != 0) {
+			r2X = (float*) malloc(sizeof(float)*winPair*nfish);
+			jwX = (float*) malloc(sizeof(float)*winPair*nfish);
+			noDatX = (int*) malloc(sizeof(int)*winPair*nfish);
+			if (r2X == NULL || jwX == NULL || noDatX == NULL) memOK = 0;
+		}
+		if (loc == NULL || rowAt == NULL || pairs == NULL) memOK = 0;
+	}
+	if (memOK == 0) {
+		free (loc);
+		free (rowAt);
+		free (pairs);
+		free (r2X);
+		free (jwX);
+		free (noDatX);
+		return LDRunPairs (cutoff, alleList, currPop, nfish, fishHead,
+						nMobil, missptr, lastOK, okLoc, outBurr, moreBurr,
+						outBurrName, rB2, rBdrift, prodInd, sampCount,
+						pairWt, weighsmp, locSkip, rAveTemp, totInd,
+						wMeanSamp, rWeight, bigExpR2, bigRprime, bigR,
+						nPairPtr, npairTot, npairSkip, prompt, prog, r2Sect,
+						sepBurOut, moreCol, BurAlePair,
+						jack, p1Gen, p2Gen, noDatFish, countm1, countm2,
+						mValp1, freqp1, homop1, mValp2, freqp2, homop2,
+						r2AtPairX, r2Count, r2WRemSmp, JweighPair,
+						JweightTot, epsilon, stat);
+	}
+	for (nOK = 0, a = 0; a <= lastOK; a++)
+		if (*(okLoc+a) != 0) *(loc + nOK++) = a;
+	res = PairResBegin (fishHead, lastOK, okLoc, nfish, jack, nBand,
+						&slot);
+	r2P = r2AtPairX;
+	jwP = JweighPair;
+	ndP = noDatFish;
+
+	// to inform the user after "prompt" pairs calculated;
+	pairval = prompt;
+	for (a0 = 0; a0 < nOK-1; a0 = a1) {
+		a1 = (a0+nBand < nOK)? a0+nBand: nOK;
+	// pairs of row a (locus loc[a]) are from rowAt[a-a0] in the buffer
+		for (*rowAt = 0, a = a0; a < a1; a++)
+			*(rowAt+a-a0+1) = *(rowAt+a-a0) + (nOK-1-a);
+		nWin = *(rowAt+a1-a0);
+		for (c0 = a0; c0 < nOK; c0 = c1) {
+			c1 = (c0+nTile < nOK)? c0+nTile: nOK;
+			for (a = a0; a < a1; a++) {
+				p1 = *(loc+a);
+				for (b = (c0 > a)? c0: a+1; b < c1; b++) {
+					p2 = *(loc+b);
+					j = *(rowAt+a-a0) + (b-a-1);
+					pr = pairs + j;
+					pr->p1 = p1;
+					pr->p2 = p2;
+					pr->m = -1;
+					pr->n = -1;
+					if (jack != 0) {
+						r2P = r2X + j*nfish;
+						jwP = jwX + j*nfish;
+						ndP = noDatX + j*nfish;
+					}
+				// identical loci as in LDRunPairs, kept for each row
+					g = (res != NULL)? *(slot+p2): -1;
+					if (g >= 0) g = g*nBand + (a-a0);
+					if (g >= 0 && *(res->p1+g) != p1 && jack != 0)
+						memcpy (res->r2Count0, r2Count,
+								sizeof(unsigned long long)*nfish);
+					if (g >= 0 && *(res->p1+g) == p1)
+						PairResGet (res, g, &(pr->nSamp), &(pr->nInd1),
+								&(pr->nInd2), &(pr->nMpairs), &(pr->rB),
+								&(pr->expR2), r2P, jwP, ndP, r2Count);
+					else (*calc) (cutoff, *(alleList+p1), *(alleList+p2),
+							*(fishHead+p1), *(fishHead+p2), p1, p2,
+							*(nMobil+p1), *(nMobil+p2), nfish, &(pr->nSamp),
+							&(pr->nInd1), &(pr->nInd2), &(pr->nMpairs),
+							&(pr->rB), currPop, missptr, NULL, NULL, 0, 1,
+							&(pr->expR2), weighsmp, sepBurOut, moreCol,
+							BurAlePair, jack, p1Gen, p2Gen, ndP, countm1,
+							countm2, mValp1, freqp1, homop1, mValp2, freqp2,
+							homop2, r2P, jwP, r2Count, epsilon);
+					if (g >= 0 && *(res->p1+g) != p1)
+						PairResPut (res, g, p1, pr->nSamp, pr->nInd1,
+								pr->nInd2, pr->nMpairs, pr->rB, pr->expR2,
+								r2P, jwP, ndP, r2Count);
+				}
+			}
+		}
+	// add to totals in serial order, as in LDRunPairs
+		for (j = 0, pr = pairs; j < nWin; j++, pr++) {
+			(*npairTot)++;
+			if (prog->out != NULL && (*npairTot) % LDPROGPAIR == 0)
+				LDProgress (prog, *npairTot, 1);
+			if (pr->p1 - locSkip < LOCBURR && pr->p2 - locSkip < LOCBURR)
+				(*nPairPtr)++;
+			if (pr->nMpairs <= 0) {
+				(*npairSkip)++;
+				continue;
+			}
+			AddBurrVal (pr->nInd1, pr->nInd2, pr->rB, pr->nSamp, pr->expR2,
+						weighsmp, locSkip, nLocPairs, rB2, rBdrift, prodInd,
+						sampCount, pairWt, rAveTemp, totInd, wMeanSamp,
+						rWeight, bigExpR2, bigRprime, bigR);
+			if (r2Sect != NULL) R2Add (r2Sect, pr->p1, pr->p2, -1, -1,
+							pr->nInd1, pr->nInd2, pr->nSamp, pr->rB,
+							pr->expR2, weighsmp);
+			if (jack != 0)
+				JackWeight (weighsmp, pr->nSamp, nfish, noDatX+j*nfish,
+							r2X+j*nfish, r2WRemSmp, jwX+j*nfish, JweightTot);
+			if ((nLocPairs) == pairval) {
+				fprintf (prog->con, "%18llu done, at loc. pair (%d, %d)\n",
+						pairval, pr->p1+1, pr->p2+1);
+				pairval +=prompt;
+			}
+			nLocPairs++;
+		}
+	}
+
+	RemovePairRes (res);
+	free (slot);
+	free (loc);
+	free (rowAt);
+	free (pairs);
+	free (r2X);
+	free (jwX);
+	free (noDatX);
+	return nLocPairs;
+}
+
+//-------------------------------------------------------------------------
+// Oct 2026: LD method on a random sample of locus pairs (argument "l:" on
+// the command line), when there are more eligible pairs than the number
+// asked. Pairs are put in strata: pairs within each chromosome (chroGrp
+// = 1), pairs across two chromosomes (chroGrp = 2), or all pairs if no
+// chromosomes. The number asked is shared among strata in proportion to
+// their pairs, so the sample is self-weighting, and r^2, r^2-drift are
+// averaged as for all pairs. The sample is the same at all critical
+// values of a population, given the seed.
+// With argument "a:" (anytime), all pairs (or as many as asked by "l:")
+// are gone over in a random order that spreads over all strata from the
+// start, and running estimates are published, see LDAnytime.
+//-------------------------------------------------------------------------
+
+unsigned long long LDRand (unsigned long long *state)
+// random 64-bit integer (splitmix64), state is updated
+{
+	unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+//-------------------------------------------------------------------------
+
+int LDIndexCmp (const void *a, const void *b)
+// for qsort: ascending order
+{
+	unsigned long long x = *(unsigned long long*) a;
+	unsigned long long y = *(unsigned long long*) b;
+	return (x < y)? -1: (x > y)? 1: 0;
+}
+
+//-------------------------------------------------------------------------
+
+void LDDrawIndex (unsigned long long *idx, unsigned long long k,
+				unsigned long long total, unsigned long long *state,
+				unsigned long long *comp)
+// Draw k distinct numbers among 0, ..., (total-1), put in idx in ascending
+// order. If k is more than half of total, the (total-k) numbers not taken
+// are drawn into comp (room for k+1 numbers).
+{
+	unsigned long long i, j, n;
+	if (k == 0) return;
+	if (k <= total - k) {
+		for (n = 0; n < k; ) {
+			for (j = n; j < k; j++) *(idx+j) = LDRand (state) % total;
+			qsort (idx, k, sizeof(unsigned long long), LDIndexCmp);
+			for (i = 1, n = 1; i < k; i++)
+				if (*(idx+i) != *(idx+n-1)) *(idx + n++) = *(idx+i);
+		}
+		return;
+	}
+	n = total - k;
+	LDDrawIndex (comp, n, total, state, NULL);
+	*(comp+n) = total;
+	for (i = 0, j = 0, n = 0; i < total; i++) {
+		if (i == *(comp+j)) j++;
+		else *(idx + n++) = i;
+	}
+}
+
+//-------------------------------------------------------------------------
+
+int LDLowerBound (int *list, int n, int key)
+// the first one in ascending list (n numbers) not less than key, n if none
+{
+	int lo = 0, hi = n, k;
+	while (lo < hi) {
+		k = (lo+hi)/2;
+		if (*(list+k) < key) lo = k+1;
+		else hi = k;
+	}
+	return lo;
+}
+
+//-------------------------------------------------------------------------
+
+void LDPairAt (struct ldstra *st, unsigned long long i, int *p1, int *p2)
+// Locus pair i of stratum st: pairs (a, b) of loc1, a < b, in the order
+// of rows a (row a has n1-1-a pairs, or those in the distance window),
+// or pairs of loc1 by loc2.
+{
+	unsigned long long a, n = (unsigned long long) st->n1;
+	double b;
+	int lo, hi, k;
+	if (st->n2 > 0) {
+		*p1 = *(st->loc1 + i / st->n2);
+		*p2 = *(st->loc2 + i % st->n2);
+		return;
+	}
+	if (st->rowFirst != NULL) {
+		for (lo = 0, hi = st->n1-1; lo < hi; ) {
+			k = (lo+hi+1)/2;
+			if (*(st->rowFirst+k) <= i) lo = k;
+			else hi = k-1;
+		}
+		*p1 = *(st->loc1 + lo);
+		*p2 = *(st->loc1 + *(st->rowLo+lo) + (i - *(st->rowFirst+lo)));
+		return;
+	}
+	// row a starts at a*(2n-a-1)/2, solved for a then adjusted
+	b = (double) (2*n-1);
+	b = (b - sqrt (b*b - 8.0*i)) / 2;
+	a = (b > 0)? (unsigned long long) b: 0;
+	if (a > n-2) a = n-2;
+	while (a > 0 && a*(2*n-a-1)/2 > i) a--;
+	while (a+1 < n-1 && (a+1)*(2*n-a-2)/2 <= i) a++;
+	*p1 = *(st->loc1 + a);
+	*p2 = *(st->loc1 + a + 1 + (i - a*(2*n-a-1)/2));
+}
+
+//-------------------------------------------------------------------------
+
+float LDSampError (struct ldstra *stra, int nStra)
+// Sampling error of the ratio (weighted r^2-drift) in stratified sampling
+// without replacement, from the sums of strata; strata with one pair drawn
+// are left out. Return 0 if no weights.
+{
+	int h;
+	struct ldstra *st;
+	double R, X, Y, Sz, Szz, s2, V;
+	for (h = 0, X = 0, Y = 0; h < nStra; h++) {
+		st = stra + h;
+		if (st->nDraw == 0) continue;
+		X += st->sw * st->total / st->nDraw;
+		Y += st->swd * st->total / st->nDraw;
+	}
+	if (X <= 0) return 0;
+	R = Y/X;
+	for (h = 0, V = 0; h < nStra; h++) {
+		st = stra + h;
+		if (st->nDraw < 2) continue;
+		Sz = st->swd - R*st->sw;
+		Szz = st->swwdd - 2*R*st->swwd + R*R*st->sww;
+		s2 = (Szz - Sz*Sz/st->nDraw) / (st->nDraw - 1);
+		if (s2 < 0) s2 = 0;
+		V += (double) st->total * st->total
+			* (1 - (double) st->nDraw/st->total) * s2 / st->nDraw;
+	}
+	return (float) (sqrt (V) / X);
+}
+
+//-------------------------------------------------------------------------
+
+void LDAnytime (LDPROG prog, unsigned long long done,
+				unsigned long long total, double r2, double r2drift,
+				float estNe, float confLow, float confHi, float infinite)
+// Running estimate of LD method after done of total locus pairs: to the
+// progress file (state "estimate", Ne and CI as calculated, see PrtRecord),
+// or to the console stream prog->con if there is no progress file.
+{
+	if (prog != NULL && prog->out != NULL) {
+		#pragma omp critical (progress)
+		{
+			fprintf (prog->out, "{\"state\":\"estimate\",\"input\":%d,"
+					"\"pop\":%d,\"crit\":%g,\"done\":%llu,\"total\":%llu,"
+					"\"r2\":%.7g,\"r2drift\":%.7g,\"estimate\":%.7g,"
+					"\"ciLo\":%.7g,\"ciHi\":%.7g}\n",
+					prog->icount, prog->popRead, prog->cutoff, done, total,
+					r2, r2drift, estNe, confLow, confHi);
+			fflush (prog->out);
+		}
+		return;
+	}
+	fprintf (prog->con, "%18llu pairs, r^2 =%9.6f, Ne:", done, r2);
+	if (estNe < 0 || estNe >= infinite) fprintf (prog->con, "%10s", "infinite");
+	else fprintf (prog->con, "%10.1f", estNe);
+	if (confLow < 0 || confLow >= infinite)
+		fprintf (prog->con, "%10s", "infinite");
+	else fprintf (prog->con, "%10.1f", confLow);
+	if (confHi < 0 || confHi >= infinite)
+		fprintf (prog->con, "%10s\n", "infinite");
+	else fprintf (prog->con, "%10.1f\n", confHi);
+}
+
+//-------------------------------------------------------------------------
+
+char LDSampPairs (LDOPT ldOpt, int icount,
+				float cutoff, ALLEPTR *alleList, int currPop,
+				int nfish, FISHPTR *fishHead, int *nMobil,
+				int *missptr, int lastOK, char *okLoc,
+				float *rB2, float *rBdrift, float *prodInd,
+				float *sampCount, float *pairWt,
+				char weighsmp, int locSkip, FILE *rAveTemp,
+				double *totInd, double *wMeanSamp,
+				double *rWeight, double *bigExpR2,
+				double *bigRprime, double *bigR,
+				unsigned long long *nPairPtr,
+				unsigned long long *npairTot, long *npairSkip,
+				unsigned long long prompt, LDPROG prog, R2SECT r2Sect,
+				char sepBurOut, char moreCol, char BurAlePair,
+				struct chromosome *chromoList, int nChromo, char chroGrp,
+				char jack, unsigned long long *r2Count,
+				double *r2WRemSmp, double *JweightTot,
+				float epsilon, char mating, float infinite,
+				unsigned long long *nLocPairs, float *sampSE)
+// Run LD method on a sample of ldOpt->nSample locus pairs, adding to the
+// totals in the same way as LDChromoSched, and put in sampSE the sampling
+// error of weighted r^2-drift. The number of pairs added is in nLocPairs.
+// In anytime mode, running estimates (mating, infinite for LD_Ne) are
+// published after every ldOpt->every pairs; it stops when the CI of
+// r^2-drift is within ldOpt->tol of it. If all pairs are gone over, sampSE
+// is -1, and the results are as from LDChromoSched or LDRunPairs, up to
+// rounding in the order of adding.
+// Oct 2026: in shard k of K (ldOpt->shard, nShard), the pairs are the k-th
+// of K ranges of the pairs in serial order, of (nearly) equal numbers of
+// pairs; sampSE is -1.
+// Return 1 if done, 0 if all pairs are to be taken (not more pairs than
+// asked, not in anytime mode), or if out of memory.
+{
+	int h, k, t, m, n, nStra, maxNAlle, a, lo, hi, kAll;
+	int nThread = 1;
+	int *locs, *hOf, *kOf;
+	unsigned long long *rowAt = NULL;
+	unsigned long long K, N, cum, kLo, kHi, maxK, j, nWin, winPair, pairval;
+	unsigned long long state, done, g, stride, x, y, jDraw, shLo = 0;
+	double w, d, r2, r2drift;
+	float harmonic, estNe, confLow, confHi;
+	char memOK = 1, anytime = ldOpt->anytime;
+	char shard = (ldOpt->nShard > 0 && ldOpt->shard > 0)? 1: 0;
+	char visit;		// pairs are gone over in turn, not drawn
+	BURCALC calc = BurCalcPick (jack, weighsmp, 0);
+	struct ldstra *stra, *st;
+	unsigned long long *idx = NULL, *comp = NULL;
+	LDSCR *scr = NULL;
+	struct ldpair *pairs = NULL, *pr;
+	float *r2X = NULL, *jwX = NULL;
+	int *noDatX = NULL;
+
+	if (chroGrp == 0 || nChromo <= 1) nChromo = 0;
+	// loci not skipped, by chromosome, in the order of LDRowPairs
+	for (m = 0, k = lastOK+1; m < nChromo; m++) k += chromoList[m].nloci;
+	nStra = (nChromo == 0)? 1: (chroGrp == 1)? nChromo:
+			nChromo*(nChromo-1)/2;
+	if (nStra < 1) return 0;
+	// and where they are in chromosomes, rows of pairs in distance windows
+	// (see LDPairAt)
+	kAll = k;
+	locs = (int*) malloc(sizeof(int)*3*kAll);
+	kOf = locs + kAll;
+	for (m = 0; m < nChromo && chroGrp == 1; m++)
+		if (chromoList[m].pairLo != NULL) {
+			rowAt = (unsigned long long*)
+					malloc(sizeof(unsigned long long)*(kAll + nChromo));
+			break;
+		}
+	stra = (struct ldstra*) calloc(nStra + nChromo, sizeof(struct ldstra));
+	if (locs == NULL || stra == NULL
+		|| (chroGrp == 1 && m < nChromo && rowAt == NULL)) {
+		free (locs);
+		free (rowAt);
+		free (stra);
+		return 0;
+	}
+	if (nChromo == 0) {
+		stra->m = stra->n = -1;
+		stra->loc1 = locs;
+		for (k = 0; k <= lastOK; k++)
+			if (*(okLoc+k) != 0) *(locs + (stra->n1)++) = k;
+	} else {
+	// lists of chromosomes are kept after the strata
+		for (m = 0, k = 0; m < nChromo; m++) {
+			st = stra + nStra + m;
+			st->loc1 = locs + k;
+			for (t = 0; t < chromoList[m].nloci; t++) {
+				a = (chromoList[m].locus)[t];
+				if (*(okLoc+a) == 0 || a > lastOK) continue;
+				*(kOf + k) = t;
+				*(locs + k++) = a;
+				(st->n1)++;
+			}
+		// row t pairs with loci pairLo, ..., (pairHi-1) of the chromosome,
+		// which are from a to (lo-1) in the list
+			if (rowAt == NULL || chromoList[m].pairLo == NULL) continue;
+			h = k - st->n1;
+			st->rowLo = locs + 2*kAll + h;
+			st->rowFirst = rowAt + h + m;
+			*(st->rowFirst) = 0;
+			for (t = 0; t < st->n1; t++) {
+				n = *(kOf+h+t);
+				a = LDLowerBound (kOf+h, st->n1, (chromoList[m].pairLo)[n]);
+				lo = LDLowerBound (kOf+h, st->n1, (chromoList[m].pairHi)[n]);
+				*(st->rowLo+t) = a;
+				*(st->rowFirst+t+1) = *(st->rowFirst+t) + (lo - a);
+			}
+		}
+		for (m = 0, h = 0; m < nChromo; m++)
+			for (n = (chroGrp == 1)? m: m+1;
+				n <= ((chroGrp == 1)? m: nChromo-1); n++, h++) {
+				st = stra + h;
+				st->m = m;
+				st->n = n;
+				st->loc1 = (stra + nStra + m)->loc1;
+				st->n1 = (stra + nStra + m)->n1;
+				if (n == m) {
+					st->rowLo = (stra + nStra + m)->rowLo;
+					st->rowFirst = (stra + nStra + m)->rowFirst;
+				} else {
+					st->loc2 = (stra + nStra + n)->loc1;
+					st->n2 = (stra + nStra + n)->n1;
+				}
+			}
+	}
+	for (h = 0, N = 0; h < nStra; h++) {
+		st = stra + h;
+		st->total = (unsigned long long) st->n1;
+		if (st->n2 > 0) st->total *= st->n2;
+		else if (st->rowFirst != NULL) st->total = *(st->rowFirst + st->n1);
+		else st->total = (st->n1 > 1)? st->total*(st->n1-1)/2: 0;
+		st->first = N;
+		N += st->total;
+	}
+	K = ldOpt->nSample;
+	if (shard == 1) {
+		anytime = 0;
+		shLo = (unsigned long long) ((double) N * (ldOpt->shard-1)
+									/ ldOpt->nShard);
+		K = (unsigned long long) ((double) N * ldOpt->shard / ldOpt->nShard);
+		if (ldOpt->shard == ldOpt->nShard) K = N;
+		K -= shLo;
+	}
+	visit = (anytime == 1 || shard == 1)? 1: 0;
+	if (anytime == 1 && (K == 0 || K > N)) K = N;
+	if (N == 0 || (visit == 0 && K >= N)) {
+		free (locs);
+		free (rowAt);
+		free (stra);
+		return 0;
+	}
+	// proportional allocation, rounded so that they add up to K;
+	// in anytime mode, pairs drawn are counted as they are gone over.
+	maxK = 0;
+	if (visit == 0)
+		for (h = 0, cum = 0, kLo = 0; h < nStra; h++) {
+			st = stra + h;
+			cum += st->total;
+			kHi = (unsigned long long) ((double) K * cum / N);
+			st->nDraw = (kHi > kLo)? kHi - kLo: 0;
+			if (st->nDraw > st->total) st->nDraw = st->total;
+			if (st->nDraw > maxK) maxK = st->nDraw;
+			kLo = kHi;
+		}
+#ifdef _OPENMP
+	nThread = (omp_get_active_level() < omp_get_max_active_levels())?
+			omp_get_max_threads(): 1;
+#endif
+	winPair = LDWINPAIR;
+	if (jack != 0 && winPair > LDWINJACK/nfish) winPair = LDWINJACK/nfish;
+	if (anytime == 1 && winPair > ldOpt->every) winPair = ldOpt->every;
+	if (winPair < 1) winPair = 1;
+	maxNAlle = 0;
+	for (k = 0; k <= lastOK; k++)
+		if (*(nMobil+k) > maxNAlle) maxNAlle = *(nMobil+k);
+	maxNAlle++;
+	idx = (unsigned long long*) malloc(sizeof(unsigned long long)*(maxK+1));
+	comp = (unsigned long long*) malloc(sizeof(unsigned long long)*(maxK+1));
+	pairs = (struct ldpair*) malloc(sizeof(struct ldpair)*winPair);
+	hOf = (int*) malloc(sizeof(int)*winPair);
+	if ((scr = (LDSCR*) calloc(nThread, sizeof(LDSCR))) != NULL)
+		for (t = 0; t < nThread; t++)
+			if ((*(scr+t) = MakeLDScr (nfish, maxNAlle)) == NULL) memOK = 0;
+	if (jack != 0) {
+		r2X = (float*) malloc(sizeof(float)*winPair*nfish);
+		jwX = (float*) malloc(sizeof(float)*winPair*nfish);
+		noDatX = (int*) malloc(sizeof(int)*winPair*nfish);
+		if (r2X == NULL || jwX == NULL || noDatX == NULL) memOK = 0;
+	}
+	if (idx == NULL || comp == NULL || pairs == NULL || hOf == NULL
+		|| scr == NULL) memOK = 0;
+	if (memOK == 0) {
+		if (scr != NULL)
+			for (t = 0; t < nThread; t++) RemoveLDScr (*(scr+t));
+		free (scr);
+		free (idx);
+		free (comp);
+		free (pairs);
+		free (hOf);
+		free (r2X);
+		free (jwX);
+		free (noDatX);
+		free (locs);
+		free (rowAt);
+		free (stra);
+		return 0;
+	}
+	if (nChromo > 0 && chroGrp == 1)
+		fprintf (prog->con, "       Loci are paired within each chromosome\n");
+	else if (nChromo > 0)
+		fprintf (prog->con, "       Loci are paired across chromosomes\n");
+	if (shard == 1)
+		fprintf (prog->con,
+			"       Shard %d of %d: locus pairs %llu to %llu of %llu\n",
+				ldOpt->shard, ldOpt->nShard, shLo+1, shLo+K, N);
+	else if (anytime == 1)
+		fprintf (prog->con,
+			"       Up to %llu of %llu locus pairs in random order\n",
+				K, N);
+	else fprintf (prog->con,
+		"       %llu of %llu locus pairs are sampled\n", K, N);
+	if (prog->out != NULL) {
+		prog->total = K;
+		LDProgress (prog, 0, 0);
+	}
+	// same sample at all critical values of the population
+	state = ldOpt->seed + 0x632BE59BD9B4E019ULL*icount
+			+ 0x9E3779B97F4A7C15ULL*currPop;
+	// anytime: pairs g, g + stride, g + 2*stride, ... (mod N), stride
+	// near N/golden ratio and prime to N, so that all N pairs are visited,
+	// spread evenly over strata at any time.
+	g = stride = 0;
+	if (anytime == 1) {
+		g = LDRand (&state) % N;
+		stride = (unsigned long long) (0.6180339887*N) + LDRand (&state) % 64;
+		for ( ; ; stride++) {
+			for (x = stride % N, y = N; x > 0; ) {
+				j = y % x;
+				y = x;
+				x = j;
+			}
+			if (y == 1) break;
+		}
+		stride %= N;
+	} else if (shard == 1) {
+		g = shLo;
+		stride = 1;
+	}
+	pairval = prompt;
+	*nLocPairs = 0;
+	done = 0;
+	h = 0;
+	jDraw = 0;
+	while (1) {
+	// a window of pairs, in the order of strata, then of indices drawn;
+	// or in the order of visits (anytime, shard)
+		nWin = 0;
+		if (visit == 1) for ( ; nWin < winPair && done < K; done++) {
+			for (lo = 0, hi = nStra-1; lo < hi; ) {
+				t = (lo+hi+1)/2;
+				if ((stra+t)->first <= g) lo = t;
+				else hi = t-1;
+			}
+			st = stra + lo;
+			pr = pairs + nWin;
+			LDPairAt (st, g - st->first, &(pr->p1), &(pr->p2));
+			pr->m = st->m;
+			pr->n = st->n;
+			(st->nDraw)++;
+			*(hOf + nWin++) = lo;
+			g += stride;
+			if (g >= N) g -= N;
+		}
+		else while (nWin < winPair && h < nStra) {
+			st = stra + h;
+			if (jDraw == 0)
+				LDDrawIndex (idx, st->nDraw, st->total, &state, comp);
+			if (jDraw == st->nDraw) {
+				h++;
+				jDraw = 0;
+				continue;
+			}
+			pr = pairs + nWin;
+			LDPairAt (st, *(idx + jDraw++), &(pr->p1), &(pr->p2));
+			pr->m = st->m;
+			pr->n = st->n;
+			*(hOf + nWin++) = h;
+		}
+		if (nWin == 0) break;
+		#pragma omp parallel for schedule(dynamic, 64) num_threads(nThread) \
+				if (nWin > 1)
+		for (j = 0; j < nWin; j++) {
+			struct ldpair *pj = pairs + j;
+			LDSCR sc;
+			float *r2AtPairX, *JweighPair;
+			int *noDatFish;
+			int id = 0;
+#ifdef _OPENMP
+			id = omp_get_thread_num();
+#endif
+			sc = *(scr+id);
+			r2AtPairX = (jack != 0)? r2X+j*nfish: sc->r2AtPairX;
+			JweighPair = (jack != 0)? jwX+j*nfish: sc->JweighPair;
+			noDatFish = (jack != 0)? noDatX+j*nfish: sc->noDatFish;
+			(*calc) (cutoff, *(alleList+pj->p1), *(alleList+pj->p2),
+					*(fishHead+pj->p1), *(fishHead+pj->p2), pj->p1, pj->p2,
+					*(nMobil+pj->p1), *(nMobil+pj->p2), nfish, &(pj->nSamp),
+					&(pj->nInd1), &(pj->nInd2), &(pj->nMpairs),
+					&(pj->rB), currPop, missptr, NULL, NULL, 0, 1,
+					&(pj->expR2), weighsmp, sepBurOut, moreCol,
+					BurAlePair, jack, sc->p1Gen, sc->p2Gen, noDatFish,
+					sc->countm1, sc->countm2, sc->mValp1, sc->freqp1,
+					sc->homop1, sc->mValp2, sc->freqp2, sc->homop2,
+					r2AtPairX, JweighPair, sc->r2Count, epsilon);
+		}
+	// add to totals in the order drawn, as in LDChromoSched
+		for (j = 0, pr = pairs; j < nWin; j++, pr++) {
+			(*npairTot)++;
+			if (prog->out != NULL && (*npairTot) % LDPROGPAIR == 0)
+				LDProgress (prog, *npairTot, 1);
+			if (pr->p1 - locSkip < LOCBURR && pr->p2 - locSkip < LOCBURR)
+				(*nPairPtr)++;
+			if (pr->nMpairs <= 0) {
+				(*npairSkip)++;
+				continue;
+			}
+			AddBurrVal (pr->nInd1, pr->nInd2, pr->rB, pr->nSamp, pr->expR2,
+						weighsmp, locSkip, *nLocPairs, rB2, rBdrift, prodInd,
+						sampCount, pairWt, rAveTemp, totInd, wMeanSamp,
+						rWeight, bigExpR2, bigRprime, bigR);
+			if (r2Sect != NULL) R2Add (r2Sect, pr->p1, pr->p2, pr->m, pr->n,
+							pr->nInd1, pr->nInd2, pr->nSamp, pr->rB,
+							pr->expR2, weighsmp);
+			if (jack != 0)
+				JackWeight (weighsmp, pr->nSamp, nfish, noDatX+j*nfish,
+							r2X+j*nfish, r2WRemSmp, jwX+j*nfish, JweightTot);
+			// weight as in AddBurrVal, sums for the sampling error
+			st = stra + *(hOf+j);
+			w = (float) pr->nInd1 * pr->nInd2;
+			if (weighsmp > 0) w *= (pr->nSamp*pr->nSamp);
+			d = pr->rB - pr->expR2;
+			st->sw += w;
+			st->swd += w*d;
+			st->sww += w*w;
+			st->swwd += w*w*d;
+			st->swwdd += w*w*d*d;
+			if ((*nLocPairs) == pairval) {
+				fprintf (prog->con, "%18llu done, at loc. pair (%d, %d)\n",
+						pairval, pr->p1+1, pr->p2+1);
+				pairval +=prompt;
+			}
+			(*nLocPairs)++;
+		}
+		if (anytime == 0 || *rWeight <= 0 || *wMeanSamp <= 0) continue;
+	// anytime: running estimate, stop if precise enough
+		r2 = *bigR / *rWeight;
+		r2drift = *bigRprime / *rWeight;
+		harmonic = (float) (*totInd / *wMeanSamp);
+		*sampSE = (done < N)? LDSampError (stra, nStra): 0;
+		estNe = LD_Ne (harmonic, (float) r2drift, mating, infinite);
+		confLow = LD_Ne (harmonic, r2drift + LDSAMPZ*(*sampSE), mating,
+						infinite);
+		confHi = LD_Ne (harmonic, r2drift - LDSAMPZ*(*sampSE), mating,
+						infinite);
+		LDAnytime (prog, done, K, r2, r2drift, estNe, confLow, confHi,
+					infinite);
+		if (ldOpt->tol > 0 && LDSAMPZ*(*sampSE) <= ldOpt->tol*fabs (r2drift))
+			break;
+	}
+	if (shard == 1) *sampSE = -1;
+	else if (anytime == 0) *sampSE = LDSampError (stra, nStra);
+	else if (done < N) {
+		fprintf (prog->con,
+			"       %llu of %llu locus pairs are taken\n", done, N);
+		*sampSE = LDSampError (stra, nStra);
+	} else *sampSE = -1;
+
+	for (t = 0; t < nThread; t++) {
+		for (k = 0; k < nfish; k++) r2Count[k] += (*(scr+t))->r2Count[k];
+		RemoveLDScr (*(scr+t));
+	}
+	free (scr);
+	free (idx);
+	free (comp);
+	free (pairs);
+	free (hOf);
+	free (r2X);
+	free (jwX);
+	free (noDatX);
+	free (locs);
+	free (rowAt);
+	free (stra);
+	return 1;
+}
+
+// --------------------------------------------------------------------------
+
+void Pair_Analysis (float cutoff, ALLEPTR *alleList, int currPop,
+						int nfish, FISHPTR *fishHead, int *nMobil,
+						int *missptr, int lastOK, char *okLoc,
+						double *nIndSum, float *rB2WAve, float *wHarmonic,
+						float *wExpR2, FILE *outBurr,
+//						FILE *outLoc, char moreDat,
+						char moreBurr, char *outBurrName,
+						unsigned long long *nBurrAve, float *rB2, float *rBdrift,
+						float *prodInd, float *sampCount, float *pairWt,
+						float *r2driftAve, float *totWeight, float *bigR2,
+						float *bigRdrift, char weighsmp, FILE *rAveTemp,
+// add in jan 2015
+						char sepBurOut, char moreCol, char BurAlePair,
+// temporarily added for checking:
+//char *opened,
+// add in Apr 2015
+						struct chromosome *chromoList, int nChromo, char chroGrp,
+// add in Jan, ..., 2016
+						char jack, int *mValp1, float *freqp1, float *homop1,
+						int *mValp2, float *freqp2, float *homop2,
+						double *r2WRemSmp, unsigned long long *r2Count,
+// Oct 2026: progress file and console, see LDProgress, store of r^2, see R2Add,
+// options of LD method (icount for sampling pairs; mating, infinite for
+// running estimates), see LDSampPairs
+						LDPROG prog, R2SECT r2Sect, LDOPT ldOpt, int icount,
+						char mating, float infinite, float *sampSE,
+// Oct 2026: sums of locus pairs are put in part (a shard, or to be cached),
+// or taken from part if given there (shards merged, or from the cache);
+// r^2 at locus pairs from stat if not NULL, see PairStatBegin
+						LDPART part, PAIRSTAT stat)
+// rBdrift stores r2-drift for all locus pairs
+// prodInd stores product of ind. alleles at locus pairs
+// sampCount stores sample sizes for all locus pairs
+
+{
+// change to double (Apr 2012)
+    double bigR = 0.0;	// total of rB taken over all locus pairs, weighted
+						// by independent of allele pairs.
+//    float rBAveTotal = 0.0;	// sum of r2-averaged values to be stored,
+							// then retrieved later for Jackknife
+	int i, p;
+	float sign;
+// because of rouding off errors, use these to calculate (Apr 2012):
+	double wMeanSamp, totInd;	// weighted harmonic mean samp size, ind. alleles
+	double rWeight, bigExpR2, bigRprime;
+// add time to inform user:
+//	time_t rawtime;
+//	char info[15], *timeptr;
+// added Sep.- Nov 2011 the following variables:
+	int locSkip = 0;
+//	char BurrPause = 0;
+	long npairSkip = 0;
+	unsigned long long prompt;
+	unsigned long long nLocPairs = 0;
+	unsigned long long nPairPtr = 0;
+	unsigned long long npairTot = 0;
+	unsigned long long maxpairs;
+	char sampled = 0;
+
+// added Mar 2016 -----------------------------------------------------
+// The following arrays are to store info at a pair of loci, say (p1, p2).
+// p1Gen, p2Gen are for genotypes of samples at two loci p1, p2
+// noDatFish is to indicate which sample has no data, or both have data
+// For sample (i+1)th:
+// noDatFish[i] = 0: both loci have data,
+//              = 1: no data at locus p1,
+//              = 2: no data at locus p2,
+//              = 3: both loci have no data.
+// countm1[i] = number of copies of a particular allele m1 at locus p1,
+// countm2[i] = number of copies of a particular allele m2 at locus p2,
+// Allocating them here, not at Burrows_Calcul (indirectly called by this
+// function) to decrease execution time, since Burrows_Calcul is called
+// repeatedly (at each pair of loci). Memory allocations consume time!
+	int **p1Gen = (int**) malloc(sizeof(int*)*nfish);
+	int **p2Gen = (int**) malloc(sizeof(int*)*nfish);
+	int *noDatFish = (int*) malloc(sizeof(int)*nfish);
+	char *countm1 = (char*) malloc(sizeof(char)*nfish);
+	char *countm2 = (char*) malloc(sizeof(char)*nfish);
+
+// those are actually needed to declare here:
+	float *r2AtPairX = (float*) malloc(sizeof(float)*nfish);
+// temporarily add for checking:
+//double *r2JackTot = (double*) malloc(sizeof(double)*nfish);
+
+	float *JweighPair = (float*) malloc(sizeof(float)*nfish);
+	double *JweightTot = (double*) malloc(sizeof(double)*nfish);
+	for (i = 0; i < nfish; i++) {
+		p1Gen[i] = (int*) malloc (2*sizeof(int));
+		p2Gen[i] = (int*) malloc (2*sizeof(int));
+		r2Count[i] = 0;
+		r2AtPairX[i] = 0;
+// temporarily add for checking:
+//r2JackTot[i] = 0;
+		JweighPair[i] = 0;
+		JweightTot[i] = 0;
+		r2WRemSmp[i] = 0;
+	}
+
+	float epsilon = (float) 8*nfish*nfish;
+	epsilon = (1/epsilon);
+	// for a rational number r (0 <= r) whose denominator <= 4*(nfish)^2,
+	// r < epsilon implies r = 0.
+// --------------------------------------------------------------------
+
+//	ALLEPTR allep1, allep2;
+//	FISHPTR popLoc1, popLoc2;
+
+	*nBurrAve = 0;		// number of r2-averaged values
+	*nIndSum = 0;		// Total of independent comparisons
+	*rB2WAve = 0;
+	*wHarmonic = 0;
+	*totWeight = 0;
+	*wExpR2 = 0;
+	*r2driftAve = 0;
+// these are double precision, will be assigned to parameters when done
+	wMeanSamp = 0;
+	totInd = 0;
+	rWeight = 0;
+/*
+	if (outLoc != NULL && (moreDat == 1)) {
+		for (i=0; i<40; i++) fprintf (outLoc, "-");
+		fprintf (outLoc, "\n\n");
+		fprintf (outLoc, "\nFor Linkage Disequilibrium Method\n");
+		for (i=0; i<45; i++) fprintf (outLoc, "-");
+		fprintf (outLoc, "\n   Locus pair    N. Ind. pair   #Samp. w/data\n");
+		fflush (outLoc);
 	}
 //*/
 // change in Nov 2014-Mar 2015
@@ -7317,10 +9681,10 @@ void Pair_Analysis (float cutoff, ALLEPTR *alleList, int currPop,
 	maxpairs *= (maxpairs+1);
 	maxpairs /= 2;
 	if (maxpairs > prompt) {
-		printf ("     Calculating r^2");
+		fprintf (prog->con, "     Calculating r^2");
 		if (chroGrp == 0 || nChromo <= 1)
-			printf (" (at most %llu values)", maxpairs);
-		printf (":\n");
+			fprintf (prog->con, " (at most %llu values)", maxpairs);
+		fprintf (prog->con, ":\n");
 	}
 // In the next "for" loop, pick a locus in the ascending order, another locus
 // from the set of loci at the order after the first, then go through all
@@ -7353,19 +9717,65 @@ else checkR2 = fopen ("checkR2.txt", "a");
 //*/
 
 //	info[15] = '\0';
+// Oct 2026: a random sample of locus pairs if there are more than asked,
+// or pairs in random order with running estimates
+// Oct 2026: or merging shards, sums of pairs were read by the caller
+	if (part != NULL && part->given == 1) {
+		sampled = 1;
+		nLocPairs = part->nLocPairs;
+		npairTot = part->npairTot;
+		nPairPtr = part->nPairPtr;
+		npairSkip = part->npairSkip;
+		totInd = part->totInd;
+		wMeanSamp = part->wMeanSamp;
+		rWeight = part->rWeight;
+		bigExpR2 = part->bigExpR2;
+		bigRprime = part->bigRprime;
+		bigR = part->bigR;
+		for (i = 0; i < nfish; i++) {
+			r2Count[i] = part->r2Count[i];
+			r2WRemSmp[i] = part->r2WRemSmp[i];
+			JweightTot[i] = part->JweightTot[i];
+		}
+		if (ldOpt->nShard > 0)
+			fprintf (prog->con, "       Locus pairs of %d shards are merged\n",
+					ldOpt->nShard);
+		else fprintf (prog->con, "       Locus pairs are taken from cache\n");
+	} else if (ldOpt != NULL && (ldOpt->nSample > 0 || ldOpt->anytime == 1
+			|| ldOpt->nShard > 0))
+		sampled = LDSampPairs (ldOpt, icount, cutoff, alleList, currPop,
+							nfish, fishHead, nMobil, missptr, lastOK, okLoc,
+							rB2, rBdrift, prodInd, sampCount, pairWt,
+							weighsmp, locSkip, rAveTemp, &totInd,
+							&wMeanSamp, &rWeight, &bigExpR2, &bigRprime,
+							&bigR, &nPairPtr, &npairTot, &npairSkip,
+							prompt, prog, r2Sect, sepBurOut, moreCol,
+							BurAlePair, chromoList, nChromo, chroGrp,
+							jack, r2Count, r2WRemSmp, JweightTot,
+							epsilon, mating, infinite, &nLocPairs, sampSE);
+// Oct 2026: report progress, the total of pairs is known by the caller
+// when all pairs are taken
+	if (prog->out != NULL && sampled == 0) {
+		if (chroGrp > 0 && nChromo > 1)
+			prog->total = LDPairTotal (chromoList, nChromo, chroGrp,
+										lastOK, okLoc);
+		LDProgress (prog, 0, 0);
+	}
 // Added Apr 2015
 // If there is only one chromosome (nChromo = 1), then all pairs are taken
-	if (chroGrp > 0 && nChromo > 1) {
+	if (sampled == 1) ;	// done by LDSampPairs
+	else if (chroGrp > 0 && nChromo > 1) {
 		if (chroGrp == 1) {
-			printf ("       Loci are paired within each chromosome\n");
-			nLocPairs = LDOneChromo (cutoff, alleList, currPop, nfish,	//4
+			fprintf (prog->con,
+				"       Loci are paired within each chromosome\n");
+			nLocPairs = LDChromoSched (1, cutoff, alleList, currPop, nfish,	//4
 							fishHead, nMobil, missptr, lastOK, okLoc,	//5
 							outBurr, moreBurr, outBurrName, rB2,		//4
 							rBdrift, prodInd, sampCount, pairWt,		//4
 							weighsmp, locSkip, rAveTemp, &totInd,		//4
 							&wMeanSamp, &rWeight, &bigExpR2, &bigRprime,//4
 							&bigR, &nPairPtr, &npairTot, &npairSkip,	//4
-							prompt, sepBurOut, moreCol, BurAlePair,		//4
+							prompt, prog, r2Sect, sepBurOut, moreCol, BurAlePair,	//5
 							chromoList, nChromo,						//2
 							jack, p1Gen, p2Gen, noDatFish, countm1,
 							countm2, mValp1, freqp1, homop1, mValp2,
@@ -7378,15 +9788,15 @@ else checkR2 = fopen ("checkR2.txt", "a");
 //&r2Ave, opened,
 							epsilon);
 		} else {
-			printf ("       Loci are paired across chromosomes\n");
-			nLocPairs = LDTwoChromo (cutoff, alleList, currPop, nfish,
+			fprintf (prog->con, "       Loci are paired across chromosomes\n");
+			nLocPairs = LDChromoSched (0, cutoff, alleList, currPop, nfish,
 							fishHead, nMobil, missptr, lastOK, okLoc,
 							outBurr, moreBurr, outBurrName, rB2,
 							rBdrift, prodInd, sampCount, pairWt,
 							weighsmp, locSkip, rAveTemp, &totInd,
 							&wMeanSamp, &rWeight, &bigExpR2, &bigRprime,
 							&bigR, &nPairPtr, &npairTot, &npairSkip,
-							prompt,	sepBurOut, moreCol, BurAlePair,
+							prompt,	prog, r2Sect, sepBurOut, moreCol, BurAlePair,
 							chromoList, nChromo,
 							jack, p1Gen, p2Gen, noDatFish, countm1,
 							countm2, mValp1, freqp1, homop1, mValp2,
@@ -7400,12 +9810,15 @@ else checkR2 = fopen ("checkR2.txt", "a");
 							epsilon);
 		}
 	} else {
-		nLocPairs = LDRunPairs (cutoff, alleList, currPop, nfish, fishHead,	//5
+		if (stat != NULL)
+			fprintf (prog->con,
+				"       Locus pairs are taken from pair statistics\n");
+		nLocPairs = LDRunTiles (cutoff, alleList, currPop, nfish, fishHead,	//5
 						nMobil, missptr, lastOK, okLoc, outBurr, moreBurr,	//6
 						outBurrName, rB2, rBdrift, prodInd, sampCount,		//5
 						pairWt, weighsmp, locSkip, rAveTemp, &totInd,		//5
 						&wMeanSamp, &rWeight, &bigExpR2, &bigRprime, &bigR,	//5
-						&nPairPtr, &npairTot, &npairSkip, prompt,			//4
+						&nPairPtr, &npairTot, &npairSkip, prompt, prog, r2Sect,		//5
 						sepBurOut, moreCol, BurAlePair,
 						jack, p1Gen, p2Gen, noDatFish, countm1, countm2,
 						mValp1, freqp1, homop1, mValp2, freqp2, homop2,
@@ -7416,7 +9829,26 @@ else checkR2 = fopen ("checkR2.txt", "a");
 						r2WRemSmp, JweighPair, JweightTot,
 // temporarily add for checking:
 //&r2Ave, opened,
-						epsilon);
+						epsilon, stat);
+	}
+	if (prog->out != NULL) LDProgress (prog, npairTot, 2);
+// Oct 2026: sums of a shard or to be cached, written by the caller
+	if (part != NULL && part->given == 0) {
+		part->nLocPairs = nLocPairs;
+		part->npairTot = npairTot;
+		part->nPairPtr = nPairPtr;
+		part->npairSkip = npairSkip;
+		part->totInd = totInd;
+		part->wMeanSamp = wMeanSamp;
+		part->rWeight = rWeight;
+		part->bigExpR2 = bigExpR2;
+		part->bigRprime = bigRprime;
+		part->bigR = bigR;
+		for (i = 0; i < nfish; i++) {
+			part->r2Count[i] = r2Count[i];
+			part->r2WRemSmp[i] = r2WRemSmp[i];
+			part->JweightTot[i] = JweightTot[i];
+		}
 	}
 
 // --------------------------------------------------------------------
@@ -7467,100 +9899,648 @@ i+1, r2Count[i], JweightTot[i], r2JackTot[i], r2WRemSmp[i]);
 	free (JweighPair);
 	free (JweightTot);
 
-// -------------------------------
-	if (nLocPairs == 0) return;
-	*nBurrAve = nLocPairs;
-	*nIndSum = totInd;
-	*totWeight = (float) rWeight;
-	if (*nIndSum > 0) {
-		*bigR2 = (float) bigR;
-		*bigRdrift = (float) bigRprime;
-// this is used for calculating Ne from r^2
-		bigR /= rWeight;
-// this is used for calculating Ne from r^2-(exp. r^2): changed in Feb 2012
-		bigRprime /= rWeight;
-		if (wMeanSamp > 0) wMeanSamp = totInd/wMeanSamp;
-// change in Feb 2012: calculate expected R^2-sample as weighted average
-// of all R^2 in pairs:
-		bigExpR2 /= rWeight;
+// -------------------------------
+	if (nLocPairs == 0) return;
+	*nBurrAve = nLocPairs;
+	*nIndSum = totInd;
+	*totWeight = (float) rWeight;
+	if (*nIndSum > 0) {
+		*bigR2 = (float) bigR;
+		*bigRdrift = (float) bigRprime;
+// this is used for calculating Ne from r^2
+		bigR /= rWeight;
+// this is used for calculating Ne from r^2-(exp. r^2): changed in Feb 2012
+		bigRprime /= rWeight;
+		if (wMeanSamp > 0) wMeanSamp = totInd/wMeanSamp;
+// change in Feb 2012: calculate expected R^2-sample as weighted average
+// of all R^2 in pairs:
+		bigExpR2 /= rWeight;
+
+		*rB2WAve = (float) bigR;
+		*wExpR2 = (float) bigExpR2;
+		*r2driftAve = (float) bigRprime;
+		*wHarmonic = (float) wMeanSamp;
+	}
+
+
+// next 3 lines for checking, comment out later:
+/*
+if (toChk != 0) {
+fprintf(checkR2, "\nr^2 Weighted for whole sample = %10.6f\n", *rB2WAve);
+fflush (checkR2);
+fclose (checkR2);
+}
+//*/
+
+//    *wExpR2 = ExpR2Samp(*wHarmonic);
+	if (maxpairs > prompt)
+		fprintf (prog->con,
+			"     Actual number of r^2-values evaluated = %llu\n", *nBurrAve);
+    // write the total weight, the sum of ave. r2-values of allele pairs,
+	// unweighted and weighted.
+	// These will be the last records for those temporary files, which will be
+	// used for doing Jackknife.
+	// write 0 when done with rAveTemp to mark the end of this file
+	sign = 0;
+	if (rAveTemp != NULL && (*nBurrAve) > 0) {
+		fwrite (&sign, sizeof(float), 1, rAveTemp);
+//		fwrite (&rBAveTotal, sizeof(float), 1, rAveTemp);
+//		fwrite (&bigR, sizeof(float), 1, rAveTemp);
+	}
+/*
+	// write to auxiliary file (for locus data) as needed
+    if (outLoc != NULL && (moreDat == 1)) {
+		for (i=0; i<45; i++) fprintf (outLoc, "-");
+		fprintf (outLoc,"\n\n");
+		if (nLocPairs > nPairPtr) fprintf (outLoc,
+				"Only %lu accepted locus pairs are listed, up to locus %d\n",
+				nPairPtr, LOCOUTPUT+locSkip);
+		fprintf (outLoc,"Total locus pairs investigated =%13lu\n", npairTot);
+		fprintf (outLoc,"    * Number of pairs rejected =%13lu\n", npairSkip);
+		fprintf (outLoc,"    * Number of pairs accepted =%13lu\n", nLocPairs);
+		fprintf (outLoc,
+		"\nWeighted Harmonic Mean Sample Size =%9.2f\n(by Ind. Alleles)\n", *wHarmonic);
+//		fprintf (outLoc, "Weighted Mean of Expected R^2 Sample =    %11.6f\n\n", *wExpR2);
+		for (i=0; i<45; i++) fprintf (outLoc, "*"); fprintf (outLoc, "\n");
+		fflush (outLoc);
+	}
+//*/
+	if (outBurr != NULL && moreBurr == 1 &&
+	// change in Nov 2014: add condition
+		(sepBurOut != 1)) {
+		if (nLocPairs > nPairPtr) fprintf (outBurr,
+				"\nOnly %llu accepted locus pairs are listed, up to locus %d",
+				nPairPtr, LOCBURR+locSkip);
+		fprintf (outBurr,"\nTotal locus pairs investigated =%13llu\n", npairTot);
+		if ((*nBurrAve) == 0) {
+			fflush (outBurr);
+			return;
+		}
+		fprintf (outBurr,"    * Number of pairs rejected =%13lu\n", npairSkip);
+		fprintf (outBurr,"    * Number of pairs accepted =%13llu\n", nLocPairs);
+		fprintf (outBurr,
+				"\nWeighted (by Ind. Alleles) Harmonic Mean Sample Size =%11.2f\n",
+				*wHarmonic);
+		fprintf (outBurr,
+			"Expected R^2-sample calculated from this sample size = %10.6f\n",
+				ExpR2Samp(*wHarmonic));
+		fprintf (outBurr, "\n# Weighted Mean of r^2 =%22.6f\n", *rB2WAve);
+		fprintf (outBurr, "# Weighted Mean of Exp. r^2 Sample =%10.6f\n", *wExpR2);
+		fprintf (outBurr, "# Weighted Mean of r^2-drift =%16.6f  (%11.3e), ",
+				*r2driftAve, *r2driftAve);
+	// Note: this last output line does not end with a new line, since a value
+	// for Ne will be added after the call for this function, under the same
+	// conditions on outBurr here
+		fflush (outBurr);
+	}
+
+}
+
+
+// --------------------------------------------------------------------------
+
+LDPART MakeLDPart (int nfish)
+// Oct 2026: sums of LD method for nfish samples, all zero; NULL if failed.
+{
+	LDPART part;
+	if ((part = (LDPART) calloc(1, sizeof(struct ldpart))) == NULL)
+		return NULL;
+	part->nfish = nfish;
+	part->r2Count = (unsigned long long*)
+					calloc(nfish, sizeof(unsigned long long));
+	part->r2WRemSmp = (double*) calloc(2*nfish + 3*(nfish+1), sizeof(double));
+	if (part->r2Count == NULL || part->r2WRemSmp == NULL) {
+		free (part->r2Count);
+		free (part->r2WRemSmp);
+		free (part);
+		return NULL;
+	}
+	part->JweightTot = part->r2WRemSmp + nfish;
+	part->binW = part->JweightTot + nfish;
+	part->binR2 = part->binW + (nfish+1);
+	part->binDrift = part->binR2 + (nfish+1);
+	return part;
+}
+
+//-------------------------------------------------------------------------
+
+void RemoveLDPart (LDPART part)
+{
+	if (part == NULL) return;
+	free (part->r2Count);
+	free (part->r2WRemSmp);	// block of r2WRemSmp, JweightTot, bins
+	free (part);
+}
+
+//-------------------------------------------------------------------------
+
+void LDZeroPart (LDPART part)
+{
+	int i, n = part->nfish;
+	part->nLocPairs = part->npairTot = part->nPairPtr = 0;
+	part->npairSkip = 0;
+	part->totInd = part->wMeanSamp = part->rWeight = 0;
+	part->bigExpR2 = part->bigRprime = part->bigR = 0;
+	for (i = 0; i < n; i++) *(part->r2Count+i) = 0;
+	for (i = 0; i < 2*n + 3*(n+1); i++) *(part->r2WRemSmp+i) = 0;
+}
+
+//-------------------------------------------------------------------------
+
+void LDPartBins (LDPART part, FILE *rAveTemp, float *prodInd,
+				float *sampCount, float *rB2, float *rBdrift,
+				unsigned long long nPair)
+// Oct 2026: sums of a shard by samples having data at locus pairs, from
+// the nPair records written by AddBurrVal to rAveTemp, or to the arrays.
+{
+	unsigned long long i;
+	float rec[5];
+	int s;
+	if (rAveTemp != NULL) rewind (rAveTemp);
+	for (i = 0; i < nPair; i++) {
+		if (rAveTemp != NULL) {
+			if (fread (rec, sizeof(float), 5, rAveTemp) < 5) break;
+		} else {
+			rec[0] = *(prodInd+i);
+			rec[1] = *(sampCount+i);
+			rec[2] = *(rB2+i);
+			rec[3] = *(rBdrift+i);
+		}
+		if (rec[0] < 0.5F) break;
+		s = (int) (rec[1] + 0.5F);
+		if (s < 0 || s > part->nfish) continue;
+		*(part->binW+s) += rec[0];
+		*(part->binR2+s) += rec[0]*rec[2];
+		*(part->binDrift+s) += rec[0]*rec[3];
+	}
+}
+
+//-------------------------------------------------------------------------
+
+void LDPartPrint (FILE *out, LDPART part)
+// Oct 2026: write the sums in part as lines of text, ending with "end",
+// see LDShardWrite. Doubles are written in full.
+{
+	int i, n = part->nfish;
+	fprintf (out, "%llu %llu %llu %ld %.17g %.17g %.17g %.17g %.17g %.17g\n",
+			part->nLocPairs, part->npairTot, part->nPairPtr,
+			part->npairSkip, part->totInd, part->wMeanSamp, part->rWeight,
+			part->bigExpR2, part->bigRprime, part->bigR);
+	for (i = 0; i < n; i++)
+		fprintf (out, "%llu %.17g %.17g\n", *(part->r2Count+i),
+				*(part->r2WRemSmp+i), *(part->JweightTot+i));
+	for (i = 0; i <= n; i++)
+		if (*(part->binW+i) > 0)
+			fprintf (out, "bin %d %.17g %.17g %.17g\n", i, *(part->binW+i),
+					*(part->binR2+i), *(part->binDrift+i));
+	fprintf (out, "end\n");
+}
+
+//-------------------------------------------------------------------------
+
+int LDPartScan (FILE *inp, LDPART part)
+// Oct 2026: add to part the sums written by LDPartPrint, read from inp.
+// Return 1 if read up to "end", 0 if not.
+{
+	char word[16] = "";
+	int i, s, nf = part->nfish;
+	unsigned long long u1, u2, u3;
+	long l1;
+	double d[6], x, y, z;
+	if (fscanf (inp, "%llu %llu %llu %ld %lf %lf %lf %lf %lf %lf", &u1, &u2,
+				&u3, &l1, d, d+1, d+2, d+3, d+4, d+5) != 10) return 0;
+	part->nLocPairs += u1;
+	part->npairTot += u2;
+	part->nPairPtr += u3;
+	part->npairSkip += l1;
+	part->totInd += d[0];
+	part->wMeanSamp += d[1];
+	part->rWeight += d[2];
+	part->bigExpR2 += d[3];
+	part->bigRprime += d[4];
+	part->bigR += d[5];
+	for (i = 0; i < nf; i++) {
+		if (fscanf (inp, "%llu %lf %lf", &u1, &x, &y) != 3) return 0;
+		*(part->r2Count+i) += u1;
+		*(part->r2WRemSmp+i) += x;
+		*(part->JweightTot+i) += y;
+	}
+	while (fscanf (inp, "%15s", word) == 1 && strcmp (word, "bin") == 0) {
+		if (fscanf (inp, "%d %lf %lf %lf", &s, &x, &y, &z) != 4
+			|| s < 0 || s > nf) return 0;
+		*(part->binW+s) += x;
+		*(part->binR2+s) += y;
+		*(part->binDrift+s) += z;
+	}
+	return (strcmp (word, "end") == 0)? 1: 0;
+}
+
+//-------------------------------------------------------------------------
+
+int LDShardOpen (LDOPT ldOpt)
+// Oct 2026: start the partial-result file of shard ldOpt->shard, named
+// shardName.shard, see LDShardWrite. Return 0 if OK, -1 if failed.
+{
+	char name[PATHFILE];
+	FILE *out;
+	snprintf (name, PATHFILE, "%s.%d", ldOpt->shardName, ldOpt->shard);
+	if ((out = fopen (name, "w")) == NULL) {
+		perror (name);
+		return -1;
+	}
+	fprintf (out, "Ne2shard %d %d\n", ldOpt->shard, ldOpt->nShard);
+	fclose (out);
+	return 0;
+}
+
+//-------------------------------------------------------------------------
+
+void LDShardWrite (LDOPT ldOpt, LDPART part, int icount, int popRead,
+					float cutoff)
+// Oct 2026: LD method in shards (argument "h:" on the command line).
+// Each shard, a separate run on the same inputs (e.g., on another node),
+// goes over its range of locus pairs (see LDSampPairs), then appends the
+// sums at each population and critical value to its partial-result file,
+// as a block of text:
+//		block icount popRead cutoff nfish
+//		nLocPairs npairTot nPairPtr npairSkip totInd wMeanSamp rWeight
+//			bigExpR2 bigRprime bigR
+//		r2Count r2WRemSmp JweightTot	(a line for each sample)
+//		bin s binW binR2 binDrift		(s samples with data, if any pair)
+//		end
+// Doubles are written in full. A run merging the shards (see LDShardRead)
+// adds the blocks up, in place of going over the pairs, so that estimates
+// and CIs are as from a run on all pairs, up to rounding.
+{
+	char name[PATHFILE];
+	FILE *out;
+	snprintf (name, PATHFILE, "%s.%d", ldOpt->shardName, ldOpt->shard);
+	#pragma omp critical (ldshard)
+	{
+		if ((out = fopen (name, "a")) == NULL) perror (name);
+		else {
+			fprintf (out, "block %d %d %.9g %d\n", icount, popRead, cutoff,
+					part->nfish);
+			LDPartPrint (out, part);
+			fclose (out);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------
+
+int LDShardRead (LDOPT ldOpt, LDPART part, int icount, int popRead,
+				float cutoff, FILE *con)
+// Oct 2026: add up in part the blocks of all shards at a population and
+// critical value, see LDShardWrite. Return the number of shards having
+// the block; if not all of them, part is left zero (no locus pairs).
+{
+	char name[PATHFILE], word[16];
+	FILE *inp;
+	int k, ic, pop, nf, found = 0;
+	float crit;
+	LDZeroPart (part);
+	for (k = 1; k <= ldOpt->nShard && found == k-1; k++) {
+		snprintf (name, PATHFILE, "%s.%d", ldOpt->shardName, k);
+		if ((inp = fopen (name, "r")) == NULL) {
+			perror (name);
+			break;
+		}
+		while (fscanf (inp, "%15s", word) == 1) {
+			if (strcmp (word, "block") != 0) continue;
+			if (fscanf (inp, "%d %d %f %d", &ic, &pop, &crit, &nf) != 4)
+				break;
+			if (ic != icount || pop != popRead || crit != cutoff
+				|| nf != part->nfish) continue;
+			found += LDPartScan (inp, part);
+			break;
+		}
+		fclose (inp);
+	}
+	if (found < ldOpt->nShard) {
+		fprintf (con, "       Partial results of LD method not found in %s\n",
+				name);
+		LDZeroPart (part);
+	}
+	return found;
+}
+
+//-------------------------------------------------------------------------
+
+unsigned long long HashInt (unsigned long long h, long long v)
+// Oct 2026: FNV-1a hash h, continued over the 8 bytes of v
+{
+	int i;
+	for (i = 0; i < 8; i++, v >>= 8) {
+		h ^= (unsigned long long) (v & 0xff);
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+//-------------------------------------------------------------------------
+
+unsigned long long LDCacheKey (float cutoff, int nfish, FISHPTR *fishHead,
+				int lastOK, char *okLoc, struct chromosome *chromoList,
+				int nChromo, int chroGrp)
+// Oct 2026: key of the sums of LD method in the result cache, a hash of
+// what they depend on: the critical value, genotypes at the loci taken,
+// and how loci are paired on chromosomes (with the distance window).
+// Mating model, CI and output options are not in the key.
+{
+	int p, m, i;
+	unsigned int bits;
+	unsigned long long h = 14695981039346656037ULL;
+	FISHPTR fish;
+	memcpy (&bits, &cutoff, sizeof(bits));
+	h = HashInt (h, bits);
+	h = HashInt (h, nfish);
+	for (p = 0; p <= lastOK; p++) {
+		if (*(okLoc+p) == 0) continue;
+		h = HashInt (h, p);
+		for (fish = *(fishHead+p); fish != NULL; fish = fish->next) {
+			h = HashInt (h, fish->gene[0]);
+			h = HashInt (h, fish->gene[1]);
+		}
+	}
+	if (chroGrp > 0 && nChromo > 1) {
+		h = HashInt (h, -chroGrp);
+		for (m = 0; m < nChromo; m++) {
+			h = HashInt (h, -1 - chromoList[m].nloci);
+			for (i = 0; i < chromoList[m].nloci; i++) {
+				h = HashInt (h, (chromoList[m].locus)[i]);
+				if (chroGrp == 1 && chromoList[m].pairLo != NULL) {
+					h = HashInt (h, (chromoList[m].pairLo)[i]);
+					h = HashInt (h, (chromoList[m].pairHi)[i]);
+				}
+			}
+		}
+	}
+	return h;
+}
+
+//-------------------------------------------------------------------------
+
+int LDCacheRead (LDOPT ldOpt, LDPART part, unsigned long long key,
+				char jack)
+// Oct 2026: look up the sums at key in the result cache, having jackknife
+// on samples if jack = 1. Return 1 if found, in part; else 0, part zero.
+{
+	char word[16];
+	FILE *inp;
+	unsigned long long k;
+	int j, nf, found = 0;
+	LDZeroPart (part);
+	#pragma omp critical (ldcache)
+	if ((inp = fopen (ldOpt->cacheName, "r")) != NULL) {
+		while (found == 0 && fscanf (inp, "%15s", word) == 1) {
+			if (strcmp (word, "cache") != 0) continue;
+			if (fscanf (inp, "%llx %d %*d %*d %*f %d", &k, &j, &nf) != 3)
+				break;
+			if (k != key || j < jack || nf != part->nfish) continue;
+			if ((found = LDPartScan (inp, part)) == 0) LDZeroPart (part);
+		}
+		fclose (inp);
+	}
+	return found;
+}
+
+//-------------------------------------------------------------------------
 
-		*rB2WAve = (float) bigR;
-		*wExpR2 = (float) bigExpR2;
-		*r2driftAve = (float) bigRprime;
-		*wHarmonic = (float) wMeanSamp;
+void LDCacheWrite (LDOPT ldOpt, LDPART part, unsigned long long key,
+				char jack, int icount, int popRead, float cutoff)
+// Oct 2026: result cache (argument "k:" on the command line). LD method,
+// after going over all locus pairs at a population and critical value,
+// appends their sums (see LDShardWrite) to the cache file as a block
+//		cache key jack icount popRead cutoff nfish
+//		...
+//		end
+// where key is from LDCacheKey, jack = 1 if the sums have jackknife on
+// samples. A later run on the same genotypes, in this or another input
+// file, takes the sums from there in place of going over the pairs, as
+// in merging shards, so only the mating model, CIs and outputs are redone.
+{
+	FILE *out;
+	#pragma omp critical (ldcache)
+	{
+		if ((out = fopen (ldOpt->cacheName, "a")) == NULL)
+			perror (ldOpt->cacheName);
+		else {
+			fprintf (out, "cache %016llx %d %d %d %.9g %d\n", key, jack,
+					icount, popRead, cutoff, part->nfish);
+			LDPartPrint (out, part);
+			fclose (out);
+		}
 	}
+}
 
+//-------------------------------------------------------------------------
 
-// next 3 lines for checking, comment out later:
-/*
-if (toChk != 0) {
-fprintf(checkR2, "\nr^2 Weighted for whole sample = %10.6f\n", *rB2WAve);
-fflush (checkR2);
-fclose (checkR2);
+FILE *PairStatFind (char *name, unsigned long long key, int nfish,
+					int nloci, unsigned long long *nPair)
+// Oct 2026: look up the block at key in the store of locus pair statistics,
+// return the store opened at the pairs of the block, NULL if not found.
+{
+	FILE *inp;
+	struct pairhead head;
+	if ((inp = fopen (name, "rb")) == NULL) return NULL;
+	while (fread (&head, sizeof(head), 1, inp) == 1) {
+		if (strncmp (head.tag, "pairs", 8) != 0) break;
+		if (head.key == key && head.nfish == nfish && head.nloci == nloci) {
+			*nPair = head.nPair;
+			return inp;
+		}
+		if (FSEEK64 (inp, head.size, SEEK_CUR) != 0) break;
+	}
+	fclose (inp);
+	return NULL;
 }
-//*/
 
-//    *wExpR2 = ExpR2Samp(*wHarmonic);
-	if (maxpairs > prompt)
-		printf("     Actual number of r^2-values evaluated = %llu\n", *nBurrAve);
-    // write the total weight, the sum of ave. r2-values of allele pairs,
-	// unweighted and weighted.
-	// These will be the last records for those temporary files, which will be
-	// used for doing Jackknife.
-	// write 0 when done with rAveTemp to mark the end of this file
-	sign = 0;
-	if (rAveTemp != NULL && (*nBurrAve) > 0) {
-		fwrite (&sign, sizeof(float), 1, rAveTemp);
-//		fwrite (&rBAveTotal, sizeof(float), 1, rAveTemp);
-//		fwrite (&bigR, sizeof(float), 1, rAveTemp);
+//-------------------------------------------------------------------------
+
+void PairStatSave (POPEST pe, POPSET ps, unsigned long long key, char *poly)
+// Oct 2026: keep statistics of locus pairs of population pe in the store
+// (argument "v:" on the command line). At each pair of loci p1 < p2 taken
+// (poly[p] = 1), in the order of LDRunPairs, for samples having data at
+// both loci, these are written as ints:
+//		p1 p2 nSamp nA1 nA2 copy1 homo1 copy2 homo2 joint
+// nA1, nA2 alleles of the allele lists at p1, p2, copy1[a], homo1[a] are
+// copies and homozygotes of allele a at p1 (copy2, homo2 at p2), joint
+// [a1*nA2+a2] the sum over samples of products of copies of a1 at p1 and
+// a2 at p2. Those are all Burrows_Calcul needs from the genotypes without
+// jackknife on samples, so Burrows_Stat has r^2 at any critical value.
+// The block goes to the end of the store, as in LDCacheWrite.
+{
+	int nfish = pe->samp, nloci = ps->nloci;
+	int p, p1, p2, k, g, a, b, c, d, n, nA1, nA2, maxA = 0;
+	int *nAlle, **code, *rec;
+	int *copy1, *homo1, *copy2, *homo2, *joint;
+	ALLEPTR curr;
+	FISHPTR fish;
+	FILE *tmp, *out;
+	struct pairhead head;
+
+	nAlle = (int*) calloc (nloci, sizeof(int));
+	code = (int**) calloc (nloci, sizeof(int*));
+	if (nAlle == NULL || code == NULL || (tmp = tmpfile()) == NULL) {
+		fprintf (pe->con, "   Locus pair statistics cannot be kept!\n");
+		free (nAlle);
+		free (code);
+		return;
 	}
-/*
-	// write to auxiliary file (for locus data) as needed
-    if (outLoc != NULL && (moreDat == 1)) {
-		for (i=0; i<45; i++) fprintf (outLoc, "-");
-		fprintf (outLoc,"\n\n");
-		if (nLocPairs > nPairPtr) fprintf (outLoc,
-				"Only %lu accepted locus pairs are listed, up to locus %d\n",
-				nPairPtr, LOCOUTPUT+locSkip);
-		fprintf (outLoc,"Total locus pairs investigated =%13lu\n", npairTot);
-		fprintf (outLoc,"    * Number of pairs rejected =%13lu\n", npairSkip);
-		fprintf (outLoc,"    * Number of pairs accepted =%13lu\n", nLocPairs);
-		fprintf (outLoc,
-		"\nWeighted Harmonic Mean Sample Size =%9.2f\n(by Ind. Alleles)\n", *wHarmonic);
-//		fprintf (outLoc, "Weighted Mean of Expected R^2 Sample =    %11.6f\n\n", *wExpR2);
-		for (i=0; i<45; i++) fprintf (outLoc, "*"); fprintf (outLoc, "\n");
-		fflush (outLoc);
+// alleles of samples at each locus taken, by their places in the allele
+// list, -1 if missing data
+	for (p = 0; p < nloci; p++) {
+		if (*(poly+p) == 0) continue;
+		for (curr = *(pe->alleList+p); curr != NULL; curr = curr->next)
+			(*(nAlle+p))++;
+		if (*(nAlle+p) > maxA) maxA = *(nAlle+p);
+		if ((*(code+p) = (int*) malloc(sizeof(int)*2*nfish)) == NULL) break;
+		for (fish = *(pe->fishHead+p), k = 0; fish != NULL && k < nfish;
+				fish = fish->next, k++)
+			for (g = 0; g < 2; g++) {
+				for (a = 0, curr = *(pe->alleList+p); curr != NULL
+					&& curr->mValue != fish->gene[g]; curr = curr->next) a++;
+				*(*(code+p) + 2*k+g) =
+					(fish->gene[0] == 0 || curr == NULL)? -1: a;
+			}
 	}
-//*/
-	if (outBurr != NULL && moreBurr == 1 &&
-	// change in Nov 2014: add condition
-		(sepBurOut != 1)) {
-		if (nLocPairs > nPairPtr) fprintf (outBurr,
-				"\nOnly %llu accepted locus pairs are listed, up to locus %d",
-				nPairPtr, LOCBURR+locSkip);
-		fprintf (outBurr,"\nTotal locus pairs investigated =%13llu\n", npairTot);
-		if ((*nBurrAve) == 0) {
-			fflush (outBurr);
-			return;
+	rec = (int*) malloc(sizeof(int)*(5 + 4*maxA + maxA*maxA));
+	memset (&head, 0, sizeof(head));
+	strcpy (head.tag, "pairs");
+	head.key = key;
+	head.icount = ps->icount;
+	head.popRead = pe->popRead;
+	head.nfish = nfish;
+	head.nloci = nloci;
+	for (p1 = 0; p1 < nloci && p == nloci && rec != NULL; p1++) {
+		if (*(poly+p1) == 0) continue;
+		nA1 = *(nAlle+p1);
+		for (p2 = p1+1; p2 < nloci; p2++) {
+			if (*(poly+p2) == 0) continue;
+			nA2 = *(nAlle+p2);
+			n = 2*(nA1 + nA2) + nA1*nA2;
+			memset (rec, 0, sizeof(int)*(5+n));
+			copy1 = rec + 5;
+			homo1 = copy1 + nA1;
+			copy2 = homo1 + nA1;
+			homo2 = copy2 + nA2;
+			joint = homo2 + nA2;
+			for (k = 0; k < nfish; k++) {
+				a = *(*(code+p1) + 2*k);
+				b = *(*(code+p1) + 2*k+1);
+				c = *(*(code+p2) + 2*k);
+				d = *(*(code+p2) + 2*k+1);
+				if (a < 0 || b < 0 || c < 0 || d < 0) continue;
+				rec[2]++;
+				copy1[a]++;
+				copy1[b]++;
+				if (a == b) homo1[a]++;
+				copy2[c]++;
+				copy2[d]++;
+				if (c == d) homo2[c]++;
+				joint[a*nA2+c]++;
+				joint[a*nA2+d]++;
+				joint[b*nA2+c]++;
+				joint[b*nA2+d]++;
+			}
+			rec[0] = p1;
+			rec[1] = p2;
+			rec[3] = nA1;
+			rec[4] = nA2;
+			fwrite (rec, sizeof(int), 5+n, tmp);
+			head.nPair++;
 		}
-		fprintf (outBurr,"    * Number of pairs rejected =%13lu\n", npairSkip);
-		fprintf (outBurr,"    * Number of pairs accepted =%13llu\n", nLocPairs);
-		fprintf (outBurr,
-				"\nWeighted (by Ind. Alleles) Harmonic Mean Sample Size =%11.2f\n",
-				*wHarmonic);
-		fprintf (outBurr,
-			"Expected R^2-sample calculated from this sample size = %10.6f\n",
-				ExpR2Samp(*wHarmonic));
-		fprintf (outBurr, "\n# Weighted Mean of r^2 =%22.6f\n", *rB2WAve);
-		fprintf (outBurr, "# Weighted Mean of Exp. r^2 Sample =%10.6f\n", *wExpR2);
-		fprintf (outBurr, "# Weighted Mean of r^2-drift =%16.6f  (%11.3e), ",
-				*r2driftAve, *r2driftAve);
-	// Note: this last output line does not end with a new line, since a value
-	// for Ne will be added after the call for this function, under the same
-	// conditions on outBurr here
-		fflush (outBurr);
 	}
+	head.size = FTELL64 (tmp);
+	if (rec == NULL || p < nloci || ferror (tmp)) {
+		fprintf (pe->con, "   Locus pair statistics cannot be kept!\n");
+		fclose (tmp);
+	} else {
+		#pragma omp critical (pairstat)
+		{
+			if ((out = fopen (ps->ldOpt->statName, "ab")) == NULL) {
+				perror (ps->ldOpt->statName);
+				fclose (tmp);
+			} else {
+				fwrite (&head, sizeof(head), 1, out);
+				AppendTmp (out, tmp);
+				fclose (out);
+			}
+		}
+		if (out != NULL)
+			fprintf (pe->con,
+				"   Statistics of %llu locus pairs are kept in %s\n",
+					head.nPair, ps->ldOpt->statName);
+	}
+	for (p = 0; p < nloci; p++) free (*(code+p));
+	free (code);
+	free (nAlle);
+	free (rec);
+}
+
+//-------------------------------------------------------------------------
+
+PAIRSTAT PairStatBegin (POPEST pe, POPSET ps)
+// Oct 2026: statistics of locus pairs of population pe, at its polymorphic
+// loci taken (all pairs LD method can go over at any critical value).
+// With argument "v:statFile", they are kept in statFile if not there yet,
+// see PairStatSave. With "x:statFile", those of the same genotypes are
+// looked up (see LDCacheKey) and returned, to evaluate LD method at the
+// critical values of this run, see Burrows_Stat; NULL if not found, or
+// if loci are paired by chromosomes, or pairs are sampled or in shards,
+// then the genotypes are used. Close by PairStatClose.
+{
+	LDOPT ldOpt = ps->ldOpt;
+	int p, nloci = ps->nloci;
+	char *poly;
+	unsigned long long key, nPair;
+	FILE *inp;
+	PAIRSTAT stat = NULL;
+
+	if (ldOpt == NULL || ldOpt->statName == NULL) return NULL;
+	if ((poly = (char*) malloc(sizeof(char)*nloci)) == NULL) return NULL;
+	for (p = 0; p < nloci; p++)
+		*(poly+p) = (*(ps->locUse+p) != 0 && *(pe->nMobil+p) > 1)? 1: 0;
+	key = LDCacheKey (0, pe->samp, pe->fishHead, nloci-1, poly, NULL, 0, 0);
+	#pragma omp critical (pairstat)
+	inp = PairStatFind (ldOpt->statName, key, pe->samp, nloci, &nPair);
+	if (ldOpt->statEval == 0) {
+		if (inp != NULL) fclose (inp);
+		else PairStatSave (pe, ps, key, poly);
+	} else if (inp == NULL)
+		fprintf (pe->con,
+			"   No locus pair statistics in %s, genotypes are used\n",
+				ldOpt->statName);
+	else if ((ps->chroGrp > 0 && ps->nChromo > 1) || ldOpt->nSample > 0
+			|| ldOpt->anytime == 1 || ldOpt->nShard > 0) {
+		fprintf (pe->con,
+			"   Locus pair statistics are only for all pairs in order,"
+				" genotypes are used\n");
+		fclose (inp);
+	} else if ((stat = (PAIRSTAT) malloc(sizeof(struct pairstat))) == NULL)
+		fclose (inp);
+	else {
+		stat->inp = inp;
+		stat->start = FTELL64 (inp);
+		stat->nPair = nPair;
+		stat->nloci = nloci;
+		stat->count = NULL;
+		stat->maxCount = 0;
+		PairStatRewind (stat);
+	}
+	free (poly);
+	return stat;
+}
+
+//-------------------------------------------------------------------------
 
+void PairStatClose (PAIRSTAT stat)
+{
+	if (stat == NULL) return;
+	fclose (stat->inp);
+	free (stat->count);
+	free (stat);
 }
 
 
@@ -7580,7 +10560,17 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 // temporarily added for checking with checkR2:
 // char *opened,
 // add in Apr 2015
-				struct chromosome *chromoList, int nChromo, char chroGrp)
+				struct chromosome *chromoList, int nChromo, char chroGrp,
+// Oct 2026: progress file, NULL if not reported; store of r^2 at locus
+// pairs, NULL if not stored; options ldOpt, NULL for defaults: sampSE is
+// the sampling error of r^2-drift, if locus pairs are sampled (else -1),
+// with CI in confSamplow, confSamphi; phases timed in prof (see
+// PhaseBegin), NULL if not profiled; r^2 at locus pairs from statistics
+// stat if not NULL (then no jackknife on samples), see PairStatBegin
+				FILE *progOut, R2STORE r2Out, LDOPT ldOpt, float *sampSE,
+				float *confSamplow, float *confSamphi, PHASE prof,
+				PAIRSTAT stat, FILE *con)
+// Oct 2026: console text goes to con (see PopWindow).
 {
 	FILE *rAveTemp = NULL;
 	FILE *weighFile = NULL;
@@ -7599,7 +10589,14 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 	char drift = 0;		// if = 1, use r2-drift for CI; otherwise, use r2.
 	float estNe = 0;
 //	float iniNe = 0;
+	struct ldprog prog;
+	struct r2sect r2Sect;
+	R2SECT r2Ptr = NULL;
+	LDPART part = NULL;
+	char cache;
+	unsigned long long key = 0;
 	*memOut = 0;
+	*sampSE = -1;
 
 // add in Mar 2016:
 	int maxNAlle = 0;
@@ -7625,19 +10622,18 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 // Initialize those 2 arrays will be done in Pair_Analysis
 
 // Give an early estimate how many r^2-values to considered to set the size of arrays
-	for (j=0; (j<lastOK); j++) {
-		if (*(okLoc+j) == 0) continue;	// marked by Loci_Eligible to be skipped.
-		for (k=j+1; (k<=lastOK); k++) {
-			if (*(okLoc+k) == 0) continue;	// locus (k+1) is skipped.
-			nBurrAve++;
-		}
-	}
+// Oct 2026: all pairs of the k loci not skipped (marked by Loci_Eligible)
+// up to lastOK, counted without going over the pairs.
+	for (j=0, k=0; (j<=lastOK); j++) if (*(okLoc+j) != 0) k++;
+	nBurrAve = (unsigned long long) k;
+	nBurrAve = (nBurrAve > 0)? nBurrAve*(nBurrAve-1)/2: 0;
 // print to console LD is started:
 //	printf ("     Linkage Disequilibrium Method\n");
 	if (tmpUsed == 1) {
 		if (((rAveTemp = tmpfile()) == NULL) || ((weighFile = tmpfile()) == NULL))
 		{
-			printf ("     The System does not allow creating temporary file. RAM is used\n");
+			fprintf (con, "     The System does not allow creating temporary"
+					" file. RAM is used\n");
 			tmpUsed = 0;
 		}
 	}
@@ -7651,7 +10647,8 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 			(sampCount = (float*) calloc (nBurrAve, sizeof(float))) == NULL ||
 			(pairWt = (float*) calloc (nBurrAve, sizeof(float))) == NULL)
 		{
-			printf ("Out of memory for doing LD method at c = %5.3f!\n", cutoff);
+			fprintf (con,
+				"Out of memory for doing LD method at c = %5.3f!\n", cutoff);
 			if (rB2 != NULL) free (rB2);
 			if (rBdrift != NULL) free (rBdrift);
 			if (prodInd != NULL) free (prodInd);
@@ -7671,10 +10668,43 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 			*(pairWt+nB) = 0;
 		}
 	}
+// Oct 2026: statistics of locus pairs have no jackknife on samples, and
+// no Burrows outputs
+	if (stat != NULL && outBurr != NULL && moreBurr == 1) stat = NULL;
+	if (stat != NULL) {
+		*jackOK = 2;
+		PairStatRewind (stat);
+	}
 // don't do jackknife when not needed
-	if (*jackOK == 0) jacknife = 0;
+	if (*jackOK != 1) jacknife = 0;
+	prog.out = progOut;
+	prog.con = con;
+	prog.icount = icount;
+	prog.popRead = popRead;
+	prog.cutoff = cutoff;
+	prog.total = nBurrAve;
+	if (r2Out != NULL && R2Begin (&r2Sect, r2Out, icount, popRead,
+									cutoff, con) == 0) r2Ptr = &r2Sect;
 	nBurrAve = 0;	// reset this, which will be calculated correctly
 					// in the next function
+// Oct 2026: in shards, sums of the shard, or of all shards to be merged.
+// With a result cache, sums of all pairs are cached, unless pairs are
+// sampled, or have outputs of their own (Burrows coefficients, r^2 store)
+	cache = (ldOpt != NULL && ldOpt->cacheName != NULL && ldOpt->nShard == 0
+			&& ldOpt->nSample == 0 && ldOpt->anytime == 0 && r2Ptr == NULL
+			&& (outBurr == NULL || moreBurr != 1))? 1: 0;
+	if (((ldOpt != NULL && ldOpt->nShard > 0) || cache == 1)
+		&& (part = MakeLDPart (samp)) == NULL)
+		fprintf (con, "Out of memory for partial results of LD method!\n");
+	if (part != NULL && cache == 1) {
+		key = LDCacheKey (cutoff, samp, fishHead, lastOK, okLoc, chromoList,
+						nChromo, chroGrp);
+		part->given = LDCacheRead (ldOpt, part, key, jacknife);
+	} else if (part != NULL && ldOpt->shard == 0) {
+		LDShardRead (ldOpt, part, icount, popRead, cutoff, con);
+		part->given = 1;
+	}
+	PhaseBegin (prof, PH_PAIR);
 	Pair_Analysis (cutoff, alleList, popRead, samp, fishHead, nMobil,
 						missptr, lastOK, okLoc, nIndSum, rB2WAve,
 						wHarmonic, wExpR2, outBurr, // outLoc, moreDat,
@@ -7688,7 +10718,19 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 						chromoList, nChromo, chroGrp,
 // add in Mar 2016:
 						jacknife, mValp1, freqp1, homop1,
-						mValp2, freqp2, homop2, r2WRemSmp, r2Count);
+						mValp2, freqp2, homop2, r2WRemSmp, r2Count,
+						&prog, r2Ptr, ldOpt, icount,
+						mating, infinite, sampSE, part, stat);
+	if (r2Ptr != NULL) R2End (r2Ptr);
+	if (part != NULL && part->given == 0) {
+		LDPartBins (part, rAveTemp, prodInd, sampCount, rB2, rBdrift,
+					nBurrAve);
+		if (cache == 1)
+			LDCacheWrite (ldOpt, part, key, jacknife, icount, popRead, cutoff);
+		else LDShardWrite (ldOpt, part, icount, popRead, cutoff);
+	}
+	PhaseEnd (prof, PH_PAIR);
+	if (prof != NULL) (prof+PH_PAIR)->pairs += nBurrAve;
 
 	free (mValp1);
 	free (freqp1);
@@ -7705,10 +10747,16 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 	j = 0;
 	// weighsmp > 0 when there are missing data
 //	if (weighsmp > 0) {
+	PhaseBegin (prof, PH_ADJ);
 	if (weighsmp > 0 && RESETNE != 0) {
 // print to console initial estimate:
 // recalculate with adjusted weights based on estNe above
-		if (tmpUsed == 1) {
+	// Oct 2026: merging shards or from the cache, on sums by samples
+	// having data
+		if (part != NULL && part->given == 1)
+			j = NeAdjustedBin (part, *wHarmonic, mating, infinite, &estNe,
+				r2driftAve, &totW, &totR2, &totRdrift, wExpR2, rB2WAve, con);
+		else if (tmpUsed == 1) {
 			rewind (rAveTemp);
 // Remove parameter weighFile
 //			j = NeAdjustedTmp (rAveTemp, weighFile,
@@ -7717,11 +10765,11 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 //*opened,
 
 				nBurrAve, *wHarmonic, mating, infinite, &estNe, r2driftAve,
-				&totW, &totR2, &totRdrift, wExpR2, rB2WAve);
+				&totW, &totR2, &totRdrift, wExpR2, rB2WAve, con);
 		} else {
 			j = NeAdjustedArr (pairWt, rB2, rBdrift, prodInd, sampCount, nBurrAve,
 				*wHarmonic, mating, infinite, &estNe, r2driftAve,
-				&totW, &totR2, &totRdrift, wExpR2, rB2WAve);
+				&totW, &totR2, &totRdrift, wExpR2, rB2WAve, con);
 		}
 //		j = NeRevisedTmp (tmpUsed, pairWt, rB2, rBdrift, prodInd, sampCount,
 //					rAveTemp, weighFile,
@@ -7734,10 +10782,11 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 //			printf ("     Final estimate of Ne: %14.1f\n", estNe);
 //		}
 	}
+	PhaseEnd (prof, PH_ADJ);
 	if (j == 0) {	// there is no attempt to reweight
 		// icount = 0 when the program does not run with multiple files
 //		if (icount == 0)
-		printf ("       Estimate of Ne: %20.1f\n", estNe);
+		fprintf (con, "       Estimate of Ne: %20.1f\n", estNe);
 
 // this part is blocked out since jackknife on loci is no longer used:
 /*
@@ -7769,6 +10818,7 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 				*r2driftAve, *r2driftAve, estNe);
 	}
 
+	PhaseBegin (prof, PH_LDCI);
 	modify = 0;
 	if (param==1)
 	{
@@ -7777,7 +10827,7 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 // param opened is temporarily added for checking: print to file checkR2
 //*opened,
 				modify, confParalow, confParahi, Jdegree, infinite,
-				mating, 0, moreBurr, outBurr);
+				mating, 0, moreBurr, outBurr, con);
 /* Comment out this call for Jackknife on loci:
 		LDConfidInt (drift, nBurrAve, *wHarmonic, *wExpR2, *rB2WAve, *r2driftAve,
 					*nIndSum, modify, confParalow, confParahi, infinite,
@@ -7786,13 +10836,13 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 //*/
 // print to console when not running multiple files::
 		if (icount == 0) {
-			printf ("     Parameter CI: ");
+			fprintf (con, "     Parameter CI: ");
 			if (*confParalow < 0 || *confParalow >= infinite)
-				printf("%15s", "infinite");
-			else printf("%15.1f", *confParalow);
+				fprintf (con, "%15s", "infinite");
+			else fprintf (con, "%15.1f", *confParalow);
 			if (*confParahi < 0 || *confParahi >= infinite)
-				printf("%16s\n", "infinite");
-			else printf("%16.1f\n", *confParahi);
+				fprintf (con, "%16s\n", "infinite");
+			else fprintf (con, "%16.1f\n", *confParahi);
 		}
 	}
 	*confJacklow = *confParalow;
@@ -7806,7 +10856,7 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 // param opened is temporarily added for checking: print to file checkR2
 //*opened,
 				modify, confJacklow, confJackhi, Jdegree, infinite,
-				mating, 1, moreBurr, outBurr);
+				mating, 1, moreBurr, outBurr, con);
 /* Comment out this call for Jackknife on loci:
 		LDConfidInt (drift, nBurrAve, *wHarmonic, *wExpR2, *rB2WAve, *r2driftAve,
 					*nIndSum, modify, confJacklow, confJackhi, infinite,
@@ -7815,15 +10865,33 @@ float LDmethod (float cutoff, ALLEPTR *alleList, int popRead, int samp,
 //*/
 // print to console when not running multiple files::
 		if (icount == 0) {
-			printf ("     Jackknife CI: ");
+			fprintf (con, "     Jackknife CI: ");
 			if (*confJacklow < 0 || *confJacklow >= infinite)
-				printf("%15s", "infinite");
-			else printf("%15.1f", *confJacklow);
+				fprintf (con, "%15s", "infinite");
+			else fprintf (con, "%15.1f", *confJacklow);
 			if (*confJackhi < 0 || *confJackhi >= infinite)
-				printf("%16s\n", "infinite");
-			else printf("%16.1f\n", *confJackhi);
+				fprintf (con, "%16s\n", "infinite");
+			else fprintf (con, "%16.1f\n", *confJackhi);
+		}
+	}
+// Oct 2026: CI from the sampling error of r^2-drift, if pairs were sampled
+	if (*sampSE >= 0) {
+		*confSamplow = LD_Ne (*wHarmonic, *r2driftAve + LDSAMPZ*(*sampSE),
+							mating, infinite);
+		*confSamphi = LD_Ne (*wHarmonic, *r2driftAve - LDSAMPZ*(*sampSE),
+							mating, infinite);
+		if (icount == 0) {
+			fprintf (con, "     Sampling CI: ");
+			if (*confSamplow < 0 || *confSamplow >= infinite)
+				fprintf (con, "%16s", "infinite");
+			else fprintf (con, "%16.1f", *confSamplow);
+			if (*confSamphi < 0 || *confSamphi >= infinite)
+				fprintf (con, "%16s\n", "infinite");
+			else fprintf (con, "%16.1f\n", *confSamphi);
 		}
 	}
+	PhaseEnd (prof, PH_LDCI);
+	RemoveLDPart (part);
 	free (r2Count);
 	free (r2WRemSmp);
 	if (outBurr != NULL && moreBurr == 1) fprintf (outBurr, "\n");
@@ -8561,7 +11629,6 @@ void PrintCoan (FILE *outLoc, char moreDat, COANPTR *coanList)
 		if (wt == 0) fprintf (outLoc, "%6d*", p);
 		else fprintf (outLoc, "%6d ", p);
 		fprintf (outLoc, "%12.6f %12.6f %12.6f %12.6f\n", f2, coan, fm, wt);
-		fflush (outLoc);
 	};
 }
 
@@ -8764,9 +11831,10 @@ int PutCoanInd0 (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 				int nloci, int nSamp, char *okLoc, COANPTR *coanList,
 				float *f1, FILE *outLoc, char moreDat,
 // add missptr, hSamp in Mar 2012 to calculate harmonic mean of sample size
-				int *missptr, float *hSamp)
+				int *missptr, float *hSamp, FILE *con)
 // Estimate the average molecular coancestry per locus, for all loci,
 // and put the values in coanList, which is created as going thru all loci.
+// Oct 2026: progress is printed to console stream con (see PopCompute).
 // Return -1 if the list cannot be completed, 0 if OK. However, the list
 // is considered as extra, not crucial.
 // The main purpose is to evaluate f1, used to find effective breeder.
@@ -8803,7 +11871,7 @@ int PutCoanInd0 (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 // put out information to the console, so the user can see how much progress:
 
 		if (locprt >= prompt) {
-			printf ("       Coan-Coeffs done up to locus %d\n", p+1);
+			fprintf (con, "       Coan-Coeffs done up to locus %d\n", p+1);
 //			time ( &rawtime );
 //			timeptr = ctime (&rawtime);
 //			for (i = 0; i < 15; info[i] = *(timeptr+4+i), i++);
@@ -8840,7 +11908,9 @@ int PutCoanInd0 (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 float CoanMethod (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 				int nloci, int nSamp, char *okLoc, float *f1, FILE *outLoc,
 				char moreDat, float *loNbCoan, float *hiNbCoan, char jack,
-				int *missptr, float *hSamp)
+				int *missptr, float *hSamp, FILE *con)
+// Oct 2026: con is the console stream, stdout unless the methods run at
+// the same time (see PopCompute).
 {
 	COANPTR *coanList;
 	float Nb;
@@ -8863,9 +11933,9 @@ float CoanMethod (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 			fprintf (outLoc, "\n\n");
 		};
 	};
-	printf ("     Molecular Coancestry Method\n");	// next code may run slow!
+	fprintf (con, "     Molecular Coancestry Method\n");	// may run slow!
 	if (PutCoanInd0 (fishList, alleList, nMobil, nloci, nSamp, okLoc,
-					coanList, f1, outLoc, moreDat, missptr, hSamp) == 0)
+				coanList, f1, outLoc, moreDat, missptr, hSamp, con) == 0)
 	{
 		if (jack == 1) CoanConfid(coanList, loNbCoan, hiNbCoan);
 		if (outLoc != NULL && moreDat == 1)
@@ -8888,9 +11958,9 @@ float CoanMethod (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 		PrtLines (outLoc, 58, '-');
 		fprintf (outLoc, "\n\n");
 	};
-	printf ("       Estimated Neb^: ");
-	if (Nb < INFINITE) printf ("%20.1f\n", Nb);
-	else printf ("%20s\n", "Infinite");
+	fprintf (con, "       Estimated Neb^: ");
+	if (Nb < INFINITE) fprintf (con, "%20.1f\n", Nb);
+	else fprintf (con, "%20s\n", "Infinite");
 	return Nb;
 }
 
@@ -8900,13 +11970,10 @@ float CoanMethod (FISHPTR *fishList, ALLEPTR *alleList, int nMobil[],
 // Temporal module
 //------------------------------------------------------------------
 
-FREQPTR MakeFreq (int mvalue, int samp, float freq,
-				  int nGeneration, int generation)
-// This create a new Freq node, return NULL if failed,
-// The new node is filled by data from the list of alleles across loci
-// that were stored when reading input, whose frequencies were also
-// calculated. Those data are parameters samp and freq.
-// The node is assumed to be created at generation "generation."
+FREQPTR MakeFreq (int maxAlle, int nGeneration)
+// Oct 2026: This creates a new Freq node for one locus, return NULL if
+// failed. The node holds all alleles at the locus across generations,
+// in dense arrays of frequencies, with room for maxAlle alleles.
 // (Each block of populations consists of nGeneration populations:
 // Generation 0 up to Generation "nGeneration-1")
 // A NULL value indicates that memory runs out.
@@ -8916,96 +11983,76 @@ FREQPTR MakeFreq (int mvalue, int samp, float freq,
 	size = sizeof(struct timefreq);
 	if ((newptr = (FREQPTR) malloc(size)) != NULL)
 	{
-		newptr->mValue = mvalue;
-		if ((newptr->samples = (int*) malloc(sizeof(int)*nGeneration))
-				== NULL) return NULL;
-		if ((newptr->freqs = (float*) malloc(sizeof(float)*nGeneration))
-				== NULL) return NULL;
-		for (i=0; i<nGeneration; i++){
-			*(newptr->samples +i) = 0;
-			*(newptr->freqs +i) = 0;
-		};
-		*(newptr->freqs +generation) = freq;
-		*(newptr->samples +generation) = samp;
-		newptr->next = NULL;
+		newptr->nAlle = 0;
+		newptr->maxAlle = maxAlle;
+		newptr->nGen = nGeneration;
+		newptr->mValue = (int*) malloc(sizeof(int)*maxAlle);
+		newptr->samples = (int*) malloc(sizeof(int)*nGeneration);
+		newptr->freqs = (float*) malloc(sizeof(float)*maxAlle*nGeneration);
+		if (newptr->mValue == NULL || newptr->samples == NULL
+			|| newptr->freqs == NULL) {
+			free (newptr->mValue);
+			free (newptr->samples);
+			free (newptr->freqs);
+			free (newptr);
+			return NULL;
+		};
+		for (i=0; i<nGeneration; i++) *(newptr->samples +i) = 0;
 	}
 	return newptr;
 };
 
 //------------------------------------------------------------------
 
-FREQPTR AddFreq (FREQPTR head, int alleleK, int samp, float freq,
-				int nGeneration, int generation, int *errcode)
+int AddFreq (FREQPTR head, int alleleK, float freq, int generation)
 {
-// This routine adds one allele to the list of alleles designed for
+// This routine adds one allele to the node of alleles designed for
 // temporal method (at one locus). Once it is done for one generation,
 // then for subsequence generations, it is rarely added, except in the case
 // there is an allele in the next generation that is not in previous one.
-
-// Return the pointer to the head of the list,
-// The list of alleles is in ascending order by its mValue's.
-// Note that the list of alleles is supposed to be known
-
-    FREQPTR ptr1, ptr2, newnode;
-
-	*errcode = 0;
-	if (head == NULL) {
-		if ((newnode = MakeFreq (alleleK, samp, freq, nGeneration, generation))
-				== NULL)
-		{;
-			printf  ("Out of memory for storing allele in temporal method!\n");
-			*errcode = -1;
-			return head;	// no change
-		};
-		head = newnode;
-	} else {
-		if (alleleK < head->mValue) {	// add to front
-			if ((newnode = MakeFreq (alleleK, samp, freq, nGeneration, generation))
-				== NULL)
-			{;
-				printf ("Out of memory for storing allele in temporal method!\n");
-				*errcode = -1;
-				return head;	// no change
-			};
-			newnode->next = head;
-			head = newnode;
-		} else {
-			ptr1 = head;
-			ptr2 = ptr1->next;
-// search for the last node ptr1 such that: ptr1->mValue <= alleleK
-			while (ptr2 != NULL) {
-				if (ptr2->mValue <= alleleK) {
-					ptr1 = ptr2;	// then ptr1->mValue <= alleleK
-					ptr2 = ptr2->next;
-				} else {
-					break;
-				}
-			}	// end of search
-
-// now, ptr1->mValue <= alleleK, either ptr1 is at the end of the list,
-// or alleleK is between mValues of ptr1 and ptr2.
-//
-			if (ptr1->mValue == alleleK) {
-			// this is common when this function is called in the next
-			// generation: alleleK is already appeared in previous generation,
-			// so only add its frequency and samples having this allele.
-			// This generation is assumed to be different from the generation
-			// that this allele was added to the list.
-				*(ptr1->freqs +generation) = freq;
-				*(ptr1->samples +generation) = samp;
-			} else {
-				if ((newnode = MakeFreq (alleleK, samp, freq, nGeneration, generation))
-					== NULL) {;
-					printf ("Out of memory for storing allele in temporal method!\n");
-					*errcode = -1;
-					return head;	// no change
-				};
-				newnode->next = ptr2;
-				ptr1->next = newnode;
-			}
-		}	// end of "if (alleleK < head->mValue) ... else "
-	}
-	return head;
+// Then the rows of alleles after it are shifted, and its frequencies
+// in other generations are 0.
+// The alleles are in ascending order by their mValue's.
+// Return 0 if OK, -1 if out of memory.
+
+	int i, lo, hi, nGen;
+	float *fptr;
+	int *iptr;
+
+	nGen = head->nGen;
+	// search for the first allele i such that: mValue[i] >= alleleK
+	lo = 0;
+	hi = head->nAlle;
+	while (lo < hi) {
+		i = (lo+hi)/2;
+		if (*(head->mValue+i) < alleleK) lo = i+1;
+		else hi = i;
+	};
+	if (lo < head->nAlle && *(head->mValue+lo) == alleleK) {
+	// this is common when this function is called in the next
+	// generation: alleleK is already appeared in previous generation,
+	// so only add its frequency in this generation.
+		*(head->freqs + lo*nGen + generation) = freq;
+		return 0;
+	};
+	if (head->nAlle == head->maxAlle) {
+		i = 2*head->maxAlle;
+		if ((iptr = (int*) realloc (head->mValue, sizeof(int)*i)) == NULL)
+			return -1;
+		head->mValue = iptr;
+		if ((fptr = (float*) realloc (head->freqs, sizeof(float)*i*nGen))
+			== NULL) return -1;
+		head->freqs = fptr;
+		head->maxAlle = i;
+	};
+	for (i=head->nAlle; i>lo; i--) *(head->mValue+i) = *(head->mValue+i-1);
+	memmove (head->freqs + (lo+1)*nGen, head->freqs + lo*nGen,
+			sizeof(float)*(head->nAlle - lo)*nGen);
+	*(head->mValue+lo) = alleleK;
+	for (i=0; i<nGen; i++) *(head->freqs + lo*nGen + i) = 0;
+	*(head->freqs + lo*nGen + generation) = freq;
+	(head->nAlle)++;
+	return 0;
 }
 
 //------------------------------------------------------------------
@@ -9014,34 +12061,37 @@ FREQPTR AddFreq (FREQPTR head, int alleleK, int samp, float freq,
 void AddFreqWide (FREQPTR *freqList, ALLEPTR *alleList, int nloci,
 				  int nfish, int *missptr, char *locUse, int nGeneration,
 				  int generation, int *errcode, char weighsmp)
-// Create list of frequencies from AlleList for one generation.
+// Add frequencies from AlleList for one generation.
 // *(alleList+p) is the list of alleles at locus (p+1)
 {
 
 	ALLEPTR ptr1;
-	FREQPTR head;
-	int alleleK;
-	int p, count;
-	float freq;
+	int p, count, k;
 	*errcode = 0;
 	for (p=0; p<nloci; p++) {
-		// "count" is the number of samples having data at locus (p+1).
-		// Note that this will come in every node of the list at locus (p+1),
-		// so it is quite a redundant and waste of storage (but it is
-		// convenient, otherwise, we will need to create a separate list)
-		// Note that when a node is added, the field samples are filled
-		// with zeros for all generations except at the current one,
-		// so it will need to be adjusted when the list is complete.
+		// "count" is the number of samples having data at locus (p+1),
+		// stored once per locus for this generation.
 		count = nfish;
 		if (weighsmp > 0) count -= (*(missptr+p));
+		if (*(alleList+p) == NULL) continue;
+		if (*(freqList+p) == NULL) {
+			for (k=0, ptr1 = *(alleList+p); ptr1 != NULL; ptr1 = ptr1->next)
+				k++;
+			if ((*(freqList+p) = MakeFreq (k, nGeneration)) == NULL) {
+				printf ("Out of memory for storing allele in temporal method!\n");
+				*errcode = -1;
+				return;
+			};
+		};
+		*((*(freqList+p))->samples + generation) = count;
 		for (ptr1 = *(alleList+p); ptr1 != NULL; ptr1 = ptr1->next)
 		{
-			alleleK = ptr1->mValue;
-			freq = ptr1->freq;
-			head = *(freqList+p);
-			*(freqList+p) = AddFreq (head, alleleK, count, freq,
-								nGeneration, generation, errcode);
-			if (*errcode != 0) return;
+			if (AddFreq (*(freqList+p), ptr1->mValue, ptr1->freq,
+						generation) != 0) {
+				printf ("Out of memory for storing allele in temporal method!\n");
+				*errcode = -1;
+				return;
+			};
 		};
 	};
 }
@@ -9055,20 +12105,8 @@ void FreqAdjnPrt (FILE *output, char moreDat, FREQPTR *freqList, int nloci,
 	int p, i, j, samp;
 	float freq;
 	FREQPTR ptr1;
-	// Adjust number of samples (as mentioned in function AddFreqWide),
-	for (i=0; i<nGeneration; i++)
-	{
-		for (p=0; p<nloci; p++)
-		{
-			samp = 0;
-			for (ptr1=*(freqList+p); ptr1!=NULL; ptr1=ptr1->next) {
-				samp = *(ptr1->samples +i);
-				if (samp > 0) break;
-			};
-			for (ptr1=*(freqList+p); ptr1!=NULL; ptr1=ptr1->next)
-				*(ptr1->samples +i) = samp;
-		};
-	};
+	// Oct 2026: number of samples is kept once per locus and generation
+	// in AddFreqWide, so no more adjustment here, only printing.
 
 	if (output == NULL || moreDat == 0) return;
 	fprintf (output, "\nTEMPORAL METHOD: From %d samples\n", nGeneration);
@@ -9085,19 +12123,22 @@ void FreqAdjnPrt (FILE *output, char moreDat, FREQPTR *freqList, int nloci,
 		fprintf (output, "%-15s", "Alleles:");
 //		fprintf (output, "Locus %d\n%-15s", p+1, "Alleles:");
 	// go over all allele mobility values for locus (p+1):
-		samp = 0;
-		for (ptr1 = *(freqList+p); ptr1 != NULL; ptr1 = ptr1->next)
-			fprintf (output, "%8d", ptr1->mValue);
+		ptr1 = *(freqList+p);
+		if (ptr1 != NULL)
+			for (j=0; j<ptr1->nAlle; j++)
+				fprintf (output, "%8d", *(ptr1->mValue+j));
 		fprintf (output, "\n");
 		for (i=0; i<nGeneration; i++)
 		{
 			fprintf (output, "Sample %3d:", i+1);
-			for (j=0, ptr1 = *(freqList+p); ptr1!=NULL; ptr1=ptr1->next, j++)
-			{
+			if (ptr1 != NULL) {
 				samp = *(ptr1->samples +i);
-				freq = *(ptr1->freqs +i);
-				if (j==0) fprintf (output, "%6d", samp);
-				fprintf (output, "%8.4f", freq);
+				for (j=0; j<ptr1->nAlle; j++)
+				{
+					freq = *(ptr1->freqs + j*(ptr1->nGen) + i);
+					if (j==0) fprintf (output, "%6d", samp);
+					fprintf (output, "%8.4f", freq);
+				};
 			};
 			fprintf (output, "\n");
 		};
@@ -9112,15 +12153,14 @@ void RemoveFreq(FREQPTR *freqList, int nloci)
 {
 
 	int p;
-	FREQPTR curr, temp;
+	FREQPTR curr;
 	for (p=0; p<nloci; p++) {
 		curr = *(freqList+p);
-		for (; curr != NULL; curr = temp) {
-			temp = curr->next;
-			free ((curr->samples));
-			free ((curr->freqs));
-			free (curr);
-		};
+		if (curr == NULL) continue;
+		free ((curr->mValue));
+		free ((curr->samples));
+		free ((curr->freqs));
+		free (curr);
 		*(freqList+p) = NULL;
     }
 
@@ -9398,6 +12438,7 @@ long JacKnifeTemp (float *fArr, float *hSampMean, float *nAlle,
 	int p, locCount;
 	float s, s2, wp, nf, diff, Neraw;
 	float wtMinusp, varF, fBar, fMinusp;
+	float *fRev = NULL;
 	long iBig;
 //	float invS = 0;
 	// when reWeigh = 1, there is a need for reweight, then *invSize
@@ -9405,6 +12446,27 @@ long JacKnifeTemp (float *fArr, float *hSampMean, float *nAlle,
 	// The weights used for having *invSize will be the ones for
 	// having overall f, with full number of loci.
 	// (overall f is not necessarily fBar calculated below)
+// Oct 2026: with reweighting, each fMinusp is a pass over all loci in
+// FvalRev. They are done first on threads into fRev (same steps as in the
+// loop below), then taken in the loop in the order of loci, so that fBar,
+// varF are as when done one after another.
+	if (reWeigh == 1) fRev = (float*) malloc(sizeof(float)*nloci);
+	if (fRev != NULL) {
+		#pragma omp parallel for schedule(dynamic, 64) \
+				private(s, s2, wp, wtMinusp, fMinusp, Neraw)
+		for (p=0; p<nloci; p++) {
+			wp = *(nAlle+p);
+			if (wp <= 0) continue;
+			s = *(hSampMean+p);
+			s2 = s*s;
+			wp *= s2;
+			wtMinusp = totWeight - wp;
+			fMinusp = (fWtot - (*(fArr+p)) * wp)/wtMinusp;
+			Neraw = NeFromFp (fMinusp, timegap);
+			*(fRev+p) = FvalRev (fMinusp, fArr, hSampMean, nAlle,
+									Neraw, nloci, timegap, p);
+		};
+	};
 	for (p=0, locCount=0, fBar=0, varF=0; p<nloci; p++) {
 		wp = *(nAlle+p);	// Pollak: ind alleles, Nei/Tajima: total alleles
 		if (wp <= 0) continue;	// this locus is not considered
@@ -9425,7 +12487,8 @@ long JacKnifeTemp (float *fArr, float *hSampMean, float *nAlle,
 		// then divide by total weights except locus (p+1) to get fMinusp:
 		fMinusp = (fWtot - (*(fArr+p)) * wp)/wtMinusp;
 		// recalculate fMinusp with new weights based on tentative Neraw
-		if (reWeigh == 1) {	// fMinusp revised without locus (p+1):
+		if (fRev != NULL) fMinusp = *(fRev+p);
+		else if (reWeigh == 1) {	// fMinusp revised without locus (p+1):
 			Neraw = NeFromFp (fMinusp, timegap);
 			fMinusp = FvalRev (fMinusp, fArr, hSampMean, nAlle,
 									Neraw, nloci, timegap, p);
@@ -9443,6 +12506,7 @@ long JacKnifeTemp (float *fArr, float *hSampMean, float *nAlle,
 	nf *= ((float)locCount-1);
 	varF *= nf;
 //printf ("fBar = %15.6f, variance = %15.8f\n", fBar, varF);
+	free (fRev);
     iBig = JackKnifeInd(fBar, varF);
 //printf ("locCount = %10d, iBig = %15d\n", locCount,  iBig);
 	return iBig;
@@ -9478,35 +12542,145 @@ void JackTempkc (float fMean, float *fArr, float invSize, float *hSampMean,
 	if (*highNe <= 0 || *highNe > infinite) *highNe = infinite;
 }
 
-
+
+//------------------------------------------------------------------
+
+void JackTempkcFp (float fprimeMean, float *fprime, float *hSampMean,
+				   float *nAlle, int nloci, float fkprimeWtot,
+				   float totWeight, float timegap, float *lowNe,
+				   float *highNe, float infinite, char method)
+// Jackknife for Pollak, Nei/Tajima using Fprime
+// method = 1 is for Pollak with reweighting in effect
+// hSampMean is array (index=locus) of harmonic mean of sample sizes
+// of two samples.
+{
+	float loLim, hiLim;
+	long iBig = JacKnifeTemp (fprime, hSampMean, nAlle, nloci,
+								fkprimeWtot, totWeight, timegap, method);
+	Confid95 (iBig, fprimeMean, &loLim, &hiLim);
+	*lowNe = NeFromFp (hiLim, timegap);
+	*highNe = NeFromFp (loLim, timegap);
+// print to console for checking
+//printf ("Using f', Deg. Freedom = %6lu,\n\tMean f' = %9.6f,\t "
+//"f'-CI: %9.6f  %9.6f\n", iBig, fprimeMean, loLim, hiLim);
+//printf ("\tCI via f' for Ne: %12.6f  %15.6f\n", *lowNe, *highNe);
+	if (*highNe <= 0 || *highNe > infinite) *highNe = infinite;
+}
+
+
+//------------------------------------------------------------------
+// Oct 2026:
+TEMPSCR MakeTempScr (int nloci, int nCrit)
+// Allocate work arrays for TemporalNeEst, return NULL if failed.
+{
+	int i;
+	float *arr;
+	TEMPSCR scr;
+	if ((scr = (TEMPSCR) malloc(sizeof(struct tempscr))) == NULL)
+		return NULL;
+	// one block for 16 arrays of nloci entries and 3 of nCrit entries
+	if ((arr = (float*) malloc(sizeof(float)*(16*nloci + 3*nCrit))) == NULL)
+	{
+		free (scr);
+		return NULL;
+	};
+	scr->hLoc = arr;
+	scr->indAlle = arr + nloci;
+	scr->nAlle = arr + 2*nloci;
+	scr->invhmonic = arr + 3*nloci;
+	scr->invcount2 = arr + 4*nloci;
+	scr->fk = arr + 5*nloci;
+	scr->fkprime = arr + 6*nloci;
+	scr->nkLoc = arr + 7*nloci;
+	scr->fc = arr + 8*nloci;
+	scr->fcprime = arr + 9*nloci;
+	scr->ncLoc = arr + 10*nloci;
+	scr->fs = arr + 11*nloci;
+	scr->fsprime = arr + 12*nloci;
+	scr->topFs = arr + 13*nloci;
+	scr->bottomFs = arr + 14*nloci;
+	scr->nsLoc = arr + 15*nloci;
+	scr->nkMean = arr + 16*nloci;
+	scr->ncMean = scr->nkMean + nCrit;
+	scr->nsMean = scr->ncMean + nCrit;
+	for (i=0; i<16*nloci + 3*nCrit; i++) *(arr+i) = 0;
+	return scr;
+}
+
+//------------------------------------------------------------------
+
+void RemoveTempScr (TEMPSCR scr)
+{
+	if (scr == NULL) return;
+	free (scr->hLoc);	// the whole block
+	free (scr);
+}
+
+//------------------------------------------------------------------
+// Oct 2026:
+TEMPRES MakeTempRes (int g1, int g2, int nCrit)
+// Allocate results for generations g1, g2, return NULL if failed.
+// All values are set to 0.
+{
+	float *arr;
+	TEMPRES res;
+	if ((res = (TEMPRES) malloc(sizeof(struct tempres))) == NULL)
+		return NULL;
+	res->nTotAlle = (long*) calloc (2*nCrit, sizeof(long));
+	arr = (float*) calloc (24*nCrit, sizeof(float));
+	if (res->nTotAlle == NULL || arr == NULL) {
+		free (res->nTotAlle);
+		free (arr);
+		free (res);
+		return NULL;
+	};
+	res->g1 = g1;
+	res->g2 = g2;
+	res->outTmp = NULL;
+	res->nIndAlle = res->nTotAlle + nCrit;
+	res->Hkmean = arr;
+	res->Hcmean = arr + nCrit;
+	res->Hsmean = arr + 2*nCrit;
+	res->fkmean = arr + 3*nCrit;
+	res->fcmean = arr + 4*nCrit;
+	res->fsmean = arr + 5*nCrit;
+	res->fkprimeMean = arr + 6*nCrit;
+	res->fcprimeMean = arr + 7*nCrit;
+	res->fsprimeAll = arr + 8*nCrit;
+	res->NeTempk = arr + 9*nCrit;
+	res->NeTempc = arr + 10*nCrit;
+	res->NeTemps = arr + 11*nCrit;
+	res->loNek = arr + 12*nCrit;
+	res->hiNek = arr + 13*nCrit;
+	res->loNec = arr + 14*nCrit;
+	res->hiNec = arr + 15*nCrit;
+	res->loNes = arr + 16*nCrit;
+	res->hiNes = arr + 17*nCrit;
+	res->jloNek = arr + 18*nCrit;
+	res->jhiNek = arr + 19*nCrit;
+	res->jloNec = arr + 20*nCrit;
+	res->jhiNec = arr + 21*nCrit;
+	res->jloNes = arr + 22*nCrit;
+	res->jhiNes = arr + 23*nCrit;
+	return res;
+}
+
 //------------------------------------------------------------------
 
-void JackTempkcFp (float fprimeMean, float *fprime, float *hSampMean,
-				   float *nAlle, int nloci, float fkprimeWtot,
-				   float totWeight, float timegap, float *lowNe,
-				   float *highNe, float infinite, char method)
-// Jackknife for Pollak, Nei/Tajima using Fprime
-// method = 1 is for Pollak with reweighting in effect
-// hSampMean is array (index=locus) of harmonic mean of sample sizes
-// of two samples.
+void RemoveTempRes (TEMPRES res)
 {
-	float loLim, hiLim;
-	long iBig = JacKnifeTemp (fprime, hSampMean, nAlle, nloci,
-								fkprimeWtot, totWeight, timegap, method);
-	Confid95 (iBig, fprimeMean, &loLim, &hiLim);
-	*lowNe = NeFromFp (hiLim, timegap);
-	*highNe = NeFromFp (loLim, timegap);
-// print to console for checking
-//printf ("Using f', Deg. Freedom = %6lu,\n\tMean f' = %9.6f,\t "
-//"f'-CI: %9.6f  %9.6f\n", iBig, fprimeMean, loLim, hiLim);
-//printf ("\tCI via f' for Ne: %12.6f  %15.6f\n", *lowNe, *highNe);
-	if (*highNe <= 0 || *highNe > infinite) *highNe = infinite;
+	if (res == NULL) return;
+	if (res->outTmp != NULL) fclose (res->outTmp);
+	free (res->nTotAlle);
+	free (res->Hkmean);	// the whole block of floats
+	free (res);
 }
 
-
 //------------------------------------------------------------------
 // Modified Dec 2016:
 // At the "for" loop at Critical values, skip when the value is PCRITX
+// Oct 2026: work arrays are taken from scr (allocated by MakeTempScr),
+// the console heading "Temporal Method" is moved to the calling function.
 
 void TemporalNeEst (FILE *outLoc, char moreDat, FREQPTR *freqList, int nloci,
 				  char *locUse, int g1, int g2, int nCrit, float critVal[],
@@ -9522,7 +12696,7 @@ void TemporalNeEst (FILE *outLoc, char moreDat, FREQPTR *freqList, int nloci,
 				  float timeline[], int census,
 //				  float timeline[], int nGeneration,
 				  char tempk, char tempc, char temps, float infinite,
-				  char weighsmp)
+				  char weighsmp, TEMPSCR scr)
 {
 // References:
 // * R.Waples's "A Generalized Approach for Estimating Effective
@@ -9540,6 +12714,8 @@ void TemporalNeEst (FILE *outLoc, char moreDat, FREQPTR *freqList, int nloci,
 // critical values critVal[nCrit]
 
 	FREQPTR ptr1;
+	int i;
+	float *f1, *f2;	// frequencies of an allele at generations g1, g2
 	float freq1, freq2, pbar, pmean, totsmf1, totsmf2, totsm, totsmbar, x,xx;
 // topFs, bottomFs are sums of numerators, denominators use in calculating Fs
 	float *topFs, *bottomFs;
@@ -9584,61 +12760,36 @@ void TemporalNeEst (FILE *outLoc, char moreDat, FREQPTR *freqList, int nloci,
 	x = timeline[g1];
 	xx = timeline[g2];
 	timegap = (x > xx)? x-xx: xx-x;
-	if (g1 + g2 == 1) {
-		printf ("\nTemporal Method ... ");
-		if (census > 0) printf ("Plan I, Census Size = %d\n", census);
-		else printf ("Plan II\n");
-	};
 // hLoc holds the harmonic means of individuals having data in 2 generations
-	hLoc = (float*) malloc (sizeof(float)*nloci);
+	hLoc = scr->hLoc;
 // indAlle holds the number of alleles minus 1
-	indAlle = (float*) malloc (sizeof(float)*nloci);
-	nAlle = (float*) malloc (sizeof(float)*nloci);
+	indAlle = scr->indAlle;
+	nAlle = scr->nAlle;
 // bring these 2 out from "if (temps==1)"
-	invhmonic = (float*) malloc (sizeof(float)*nloci);
-	invcount2 = (float*) malloc (sizeof(float)*nloci);
-// to lessen memory allocation, only allocate when necessary:
+	invhmonic = scr->invhmonic;
+	invcount2 = scr->invcount2;
 	if (DETAILTEMP == 1) {	// Since details are given in Locdata out
 		tempk = 1; tempc = 1; temps = 1;
 	};
-	if (tempk == 1) {
-		fk = (float*) malloc (sizeof(float)*nloci);
-// added Feb 2012:
-		fkprime = (float*) malloc (sizeof(float)*nloci);
-//		wfkprime = (float*) malloc (sizeof(float)*nloci);
-		nkLoc = (float*) malloc (sizeof(float)*nloci);
-		nkMean = (float*) malloc (sizeof(float)*nCrit);
-		for (n = 0; n < nCrit; n++) {
-			*(nkMean+n) = 0;
-		};
-// add Jan 2012:
-//		locWtk = (float*) malloc (sizeof(float)*nloci);
-	};
-	if (tempc == 1) {
-		fc = (float*) malloc (sizeof(float)*nloci);
-// added Feb 2012:
-		fcprime = (float*) malloc (sizeof(float)*nloci);
-		ncLoc = (float*) malloc (sizeof(float)*nloci);
-		ncMean = (float*) malloc (sizeof(float)*nCrit);
-		for (n = 0; n < nCrit; n++) {
-			*(ncMean+n) = 0;
-		};
-	};
-	if (temps == 1) {
-		fs = (float*) malloc (sizeof(float)*nloci);
-// added Dec 9, 11 - Jan 2012:
-		fsprime = (float*) malloc (sizeof(float)*nloci);
-
-		topFs = (float*) malloc (sizeof(float)*nloci);
-		bottomFs = (float*) malloc (sizeof(float)*nloci);
-		nsLoc = (float*) malloc (sizeof(float)*nloci);
-		nsMean = (float*) malloc (sizeof(float)*nCrit);
-// add Jan 2012, overall fsprime:
-// This could be in the list of param. (then declared in the calling funct.)
-//		fsprimeAll = (float*) malloc (sizeof(float)*nCrit);
-//		for (n = 0; n < nCrit; n++) {
-//			*(fsprimeAll+n) = 0;
-//		};
+// Oct 2026: arrays are in scr for all, used only as needed:
+	fk = scr->fk;
+	fkprime = scr->fkprime;
+	nkLoc = scr->nkLoc;
+	nkMean = scr->nkMean;
+	fc = scr->fc;
+	fcprime = scr->fcprime;
+	ncLoc = scr->ncLoc;
+	ncMean = scr->ncMean;
+	fs = scr->fs;
+	fsprime = scr->fsprime;
+	topFs = scr->topFs;
+	bottomFs = scr->bottomFs;
+	nsLoc = scr->nsLoc;
+	nsMean = scr->nsMean;
+	for (n = 0; n < nCrit; n++) {
+		*(nkMean+n) = 0;
+		*(ncMean+n) = 0;
+		*(nsMean+n) = 0;
 	};
 	for (n = 0; n < nCrit; n++) {
 		crit = critVal[n];
@@ -9728,12 +12879,13 @@ void TemporalNeEst (FILE *outLoc, char moreDat, FREQPTR *freqList, int nloci,
 //			};
 
 			for (ptr1 = *(freqList+p), count1 = 2*(ptr1->samples[g1]),
-				count2 = 2*(ptr1->samples[g2]), totcount = count1 + count2;
-				ptr1 != NULL; ptr1 = ptr1->next)
+				count2 = 2*(ptr1->samples[g2]), totcount = count1 + count2,
+				i = 0, f1 = ptr1->freqs + g1, f2 = ptr1->freqs + g2;
+				i < ptr1->nAlle; i++, f1 += ptr1->nGen, f2 += ptr1->nGen)
 			{
-				alle = ptr1->mValue;
-				freq1 = ptr1->freqs[g1];
-				freq2 = ptr1->freqs[g2];
+				alle = *(ptr1->mValue+i);
+				freq1 = *f1;
+				freq2 = *f2;
 				if (freq1 == 0 && freq2 == 0) continue;
 			// this allele is in neither generation. Note that the allele
 			// list consists of all alleles that appear in any generations.
@@ -10169,32 +13321,6 @@ void TemporalNeEst (FILE *outLoc, char moreDat, FREQPTR *freqList, int nloci,
 			fprintf (outLoc, "\n");
 		};
 	};
-	free (invhmonic);
-	free (invcount2);
-	if (tempk == 1) {
-		free (fk);
-		free (fkprime);
-		free (nkLoc);
-		free (nkMean);
-	};
-	if (tempc == 1) {
-		free (fc);
-		free (fcprime);
-		free (ncLoc);
-		free (ncMean);
-	};
-	if (temps == 1) {
-		free (fs);
-		free (fsprime);
-//		free (fsprimeAll);
-		free (topFs);
-		free (bottomFs);
-		free (nsLoc);
-		free (nsMean);
-	};
-	free (hLoc);
-	free (indAlle);
-	free (nAlle);
 
 }
 
@@ -10360,8 +13486,12 @@ void PrtHeader (FILE *output, char append, char *inpName, int icount, int outype
 //		fprintf (output, "Starting time: %s", ctime (&rawtime));
 	};
 	time ( &rawtime );
-	fprintf (output, "Starting time: %s", ctime (&rawtime));
-	if (outype != 0) printf ("Starting time: %s", ctime (&rawtime));
+	// Oct 2026: ctime uses one buffer for all, inputs may run concurrently
+	#pragma omp critical (ctime)
+	{
+		fprintf (output, "Starting time: %s", ctime (&rawtime));
+		if (outype != 0) printf ("Starting time: %s", ctime (&rawtime));
+	}
 
 	fprintf (output, "Input File");
 	if (icount > 0) fprintf (output, " #%d", icount);
@@ -10674,23 +13804,32 @@ void PrtLDConfid (FILE *output, int nCrit, float confidLow[],
 					char *jackOK, char bigInd)
 
 {
-	int n, k;
+	int n, k, kStat;
 	if (output == NULL) return;
 	if (*header >= 1) {	// print header the first time this function is called.
 		fprintf (output, "95%% CIs for Ne^\n");
 	};
 	if (mode == 0)
 		fprintf (output, "* Parametric              ");
+	else if (mode == 2)		// Oct 2026: sampling of locus pairs
+		fprintf (output, "* Sampling of Loc. Pairs  ");
 	else {
 	// in case no jackknife is calculated because *jackOK = 0:
-		for (n=0, k=0; n<nCrit; n++) if (*(jackOK+n) == 1) k++;
+	// Oct 2026: or 2, estimates from locus pair statistics
+		for (n=0, k=0, kStat=0; n<nCrit; n++) {
+			if (*(jackOK+n) == 1) k++;
+			if (*(jackOK+n) == 2) kStat++;
+		};
 		if (k > 0) {
 //			fprintf (output, "* JackKnife on Loci       ");
 			fprintf (output, "* JackKnife on Samples    ");
 //                            123456789012345678901234567890
 		} else {
-			fprintf (output,
-				"* CIs by Jackknife are skipped when number of polymorphic loci > %d", MAXJACKLD);
+			if (kStat > 0) fprintf (output, "* CIs by Jackknife are not"
+				" available when re-evaluating from stored pair statistics");
+			if (kStat < nCrit) fprintf (output, "%s"
+				"* CIs by Jackknife are skipped when number of polymorphic loci > %d",
+				(kStat > 0)? "\n": "", MAXJACKLD);
 			fprintf (output, "\n\n");
 			fflush (output);
 			// reassign header, so that the next call, no "95% ..." printed
@@ -10701,7 +13840,7 @@ void PrtLDConfid (FILE *output, int nCrit, float confidLow[],
 	k = 0;
 	if (bigInd == 0) {
 		for (n=0; n<nCrit; n++) {
-			if (mode == 0 || *(jackOK+n) == 1) {
+			if (mode != 1 || *(jackOK+n) == 1) {
 				if (confidLow[n] < infinite && confidLow[n] >= 0)
 					fprintf (output, "%12.1f", confidLow[n]);
 				else fprintf (output, "%12s", "Infinite");
@@ -10713,7 +13852,7 @@ void PrtLDConfid (FILE *output, int nCrit, float confidLow[],
 		};
 		fprintf (output, "\n%26s", " ");
 		for (n=0; n<nCrit; n++) {
-			if (mode == 0 || *(jackOK+n) == 1) {
+			if (mode != 1 || *(jackOK+n) == 1) {
 				if (confidHi[n] < infinite && confidHi[n] > 0)
 					fprintf (output, "%12.1f", confidHi[n]);
 				else fprintf (output, "%12s", "Infinite");
@@ -10721,7 +13860,7 @@ void PrtLDConfid (FILE *output, int nCrit, float confidLow[],
 		};
 	} else {
 		for (n=0; n<nCrit; n++) {
-			if (mode == 0 || *(jackOK+n) == 1) {
+			if (mode != 1 || *(jackOK+n) == 1) {
 				if (confidLow[n] < infinite && confidLow[n] >= 0)
 					fprintf (output, "%14.1f", confidLow[n]);
 				else fprintf (output, "%14s", "Infinite");
@@ -10733,18 +13872,22 @@ void PrtLDConfid (FILE *output, int nCrit, float confidLow[],
 		};
 		fprintf (output, "\n%26s", " ");
 		for (n=0; n<nCrit; n++) {
-			if (mode == 0 || *(jackOK+n) == 1) {
+			if (mode != 1 || *(jackOK+n) == 1) {
 				if (confidHi[n] < infinite && confidHi[n] > 0)
 					fprintf (output, "%14.1f", confidHi[n]);
 				else fprintf (output, "%14s", "Infinite");
 			};
 		};
 	};
-	if (k > 0) fprintf (output,
+	kStat = 0;
+	if (mode == 1) for (n=0; n<nCrit; n++) if (*(jackOK+n) == 2) kStat++;
+	if (kStat > 0) fprintf (output, "\n\n  CIs by Jackknife are not"
+		" available when re-evaluating from stored pair statistics");
+	if (k > kStat) fprintf (output,
 		"\n\n  CIs by Jackknife are skipped when number of polymorphic loci > %d", MAXJACKLD);
 /*
 	for (n=0; n<nCrit; n++) {
-		if (mode == 0 || *(jackOK+n) == 1) {
+		if (mode != 1 || *(jackOK+n) == 1) {
 			if (confidLow[n] < infinite && confidLow[n] >= 0)
 				fprintf (output, "%12.1f", confidLow[n]);
 			else fprintf (output, "%12s", "Infinite");
@@ -10752,7 +13895,7 @@ void PrtLDConfid (FILE *output, int nCrit, float confidLow[],
 	};
 	fprintf (output, "\n%26s", " ");
 	for (n=0; n<nCrit; n++) {
-		if (mode == 0 || *(jackOK+n) == 1) {
+		if (mode != 1 || *(jackOK+n) == 1) {
 			if (confidHi[n] < infinite && confidHi[n] >= 0)
 				fprintf (output, "%12.1f", confidHi[n]);
 			else fprintf (output, "%12s", "Infinite");
@@ -11925,7 +15068,7 @@ void PrtTempxFile (FILE *xOutput, int popRead, int popStart, char newSet,
 	*popPair = '\0';
 
 //	char method[45] = "\0";
-	method = (char*) malloc(sizeof(char)*45);
+	method = (char*) malloc(sizeof(char)*50);	// 46 chars for all 3 methods
 	*method = '\0';
 // Uncomment for testing only
 //topCrit = 2;
@@ -13221,21 +16364,1246 @@ void PrtTpTabFile (FILE *xOutput, int popRead, int popStart, char newSet,
 //	if (topCrit > 0 && topCrit < nCrit) nCrit = topCrit;
 //	else if (topCrit == 0) stCrit = nCrit - 1;
 
-	// in PrtTpValues, parameter lenGot is used only when (g1+g2 == 1)
-	PrtTpValues (xOutput, newInp, generation, timeline, popID, g1, g2,
-				stCrit, nCrit, critOut, critVal, nPlan, census, *lenTpPop,
-				nIndAlle, tempk, tempc, temps, fkmean, fcmean, fsmean,
-				fkprimeMean, fcprimeMean, fsprimeAll, NeTempk, NeTempc,
-				NeTemps, loNek, loNec, loNes, hiNek, hiNec, hiNes,
-				jloNek, jloNec, jloNes, jhiNek, jhiNec, jhiNes, param, jack,
-				infinite, lenGot, abbrev, lenPair,
-				inpName, lenInp, nloci, count, common);
+	// in PrtTpValues, parameter lenGot is used only when (g1+g2 == 1)
+	PrtTpValues (xOutput, newInp, generation, timeline, popID, g1, g2,
+				stCrit, nCrit, critOut, critVal, nPlan, census, *lenTpPop,
+				nIndAlle, tempk, tempc, temps, fkmean, fcmean, fsmean,
+				fkprimeMean, fcprimeMean, fsprimeAll, NeTempk, NeTempc,
+				NeTemps, loNek, loNec, loNes, hiNek, hiNec, hiNes,
+				jloNek, jloNec, jloNes, jhiNek, jhiNec, jhiNes, param, jack,
+				infinite, lenGot, abbrev, lenPair,
+				inpName, lenInp, nloci, count, common);
+
+	fflush (xOutput);
+}
+
+
+// --------------------------------------------------------------------------
+
+// --------------------------------------------------------------------------
+// Oct 2026: estimating one population, split from RunPop0 so that several
+// populations can be estimated at the same time (not in temporal method,
+// where populations are generations of one another).
+// --------------------------------------------------------------------------
+
+void RemovePopEst (POPEST pe)
+// Free arrays of pe (lists of alleles and samples are removed by caller)
+{
+	if (pe == NULL) return;
+	free (pe->popID);
+	free (pe->alleList);
+	free (pe->fishHead);
+	free (pe->fishTail);
+	free (pe->nMobil);
+	free (pe->missptr);
+	free (pe->minFreq);
+	free (pe->maxFreq);
+	free (pe->okLoc);
+	free (pe->wExpR2);
+	free (pe->estNe);
+	free (pe->wHarmonic);
+	free (pe->rB2WAve);
+	free (pe->r2Drift);
+	free (pe->nIndSum);
+	free (pe->jackOK);
+	free (pe->confJacklow);
+	free (pe->confJackhi);
+	free (pe->confParalow);
+	free (pe->confParahi);
+	free (pe->Jdegree);
+	free (pe->sampSE);
+	free (pe->confSamplow);
+	free (pe->confSamphi);
+	free (pe->hSamp);
+	free (pe->estHetN);
+	free (pe->hetD);
+	free (pe->loHetNe);
+	free (pe->hiHetNe);
+	free (pe->indAlleH);
+	free (pe->hetTmp);
+	free (pe->okCoan);
+	free (pe->prof);
+	free (pe);
+}
+
+//------------------------------------------------------------------
+
+POPEST MakePopEst (int nloci, int nCrit, int lenBlock, char makeFish,
+					float infinite, char profile)
+// Allocate arrays for one population, return NULL if failed.
+// Oct 2026: phases are timed if profile = 1.
+{
+	int n;
+	POPEST pe;
+	if ((pe = (POPEST) calloc (1, sizeof(struct popest))) == NULL)
+		return NULL;
+	pe->popID = (char*) malloc(sizeof(char)*lenBlock);
+	pe->alleList = (ALLEPTR*) malloc(sizeof(ALLEPTR)*nloci);
+	if (makeFish > 0) {
+		pe->fishHead = (FISHPTR*) malloc(sizeof(FISHPTR)*nloci);
+		pe->fishTail = (FISHPTR*) malloc(sizeof(FISHPTR)*nloci);
+	};
+	pe->nMobil = (int*) malloc(sizeof(int)*nloci);
+	pe->missptr = (int*) malloc(sizeof(int)*nloci);
+	pe->minFreq = (float*) malloc(sizeof(float)*nloci);
+	pe->maxFreq = (float*) malloc(sizeof(float)*nloci);
+	pe->okLoc = (char*) malloc(sizeof(char)*nloci);
+	pe->wExpR2 = (float*) malloc(sizeof(float)*nCrit);
+	pe->estNe = (float*) malloc(sizeof(float)*nCrit);
+	pe->wHarmonic = (float*) malloc(sizeof(float)*nCrit);
+	pe->rB2WAve = (float*) malloc(sizeof(float)*nCrit);
+	pe->r2Drift = (float*) malloc(sizeof(float)*nCrit);
+	pe->nIndSum = (double*) malloc(sizeof(double)*nCrit);
+	pe->jackOK = (char*) malloc(sizeof(char)*nCrit);
+	pe->confJacklow = (float*) malloc(sizeof(float)*nCrit);
+	pe->confJackhi = (float*) malloc(sizeof(float)*nCrit);
+	pe->confParalow = (float*) malloc(sizeof(float)*nCrit);
+	pe->confParahi = (float*) malloc(sizeof(float)*nCrit);
+	pe->Jdegree = (long*) malloc(sizeof(long)*nCrit);
+	pe->sampSE = (float*) malloc(sizeof(float)*nCrit);
+	pe->confSamplow = (float*) malloc(sizeof(float)*nCrit);
+	pe->confSamphi = (float*) malloc(sizeof(float)*nCrit);
+	pe->hSamp = (float*) malloc(sizeof(float)*nCrit);
+	pe->estHetN = (float*) malloc(sizeof(float)*nCrit);
+	pe->hetD = (float*) malloc(sizeof(float)*nCrit);
+	pe->loHetNe = (float*) malloc(sizeof(float)*nCrit);
+	pe->hiHetNe = (float*) malloc(sizeof(float)*nCrit);
+	pe->indAlleH = (long*) malloc(sizeof(long)*nCrit);
+	pe->hetTmp = (FILE**) malloc(sizeof(FILE*)*nCrit);
+	pe->okCoan = (char*) malloc(sizeof(char)*nloci);
+	if (profile == 1)
+		pe->prof = (PHASE) calloc (NPHASE, sizeof(struct phase));
+	if (pe->popID == NULL || pe->alleList == NULL || pe->nMobil == NULL
+		|| (makeFish > 0 && (pe->fishHead == NULL || pe->fishTail == NULL))
+		|| pe->missptr == NULL || pe->minFreq == NULL || pe->maxFreq == NULL
+		|| pe->okLoc == NULL || pe->wExpR2 == NULL || pe->estNe == NULL
+		|| pe->wHarmonic == NULL || pe->rB2WAve == NULL
+		|| pe->r2Drift == NULL || pe->nIndSum == NULL || pe->jackOK == NULL
+		|| pe->confJacklow == NULL || pe->confJackhi == NULL
+		|| pe->confParalow == NULL || pe->confParahi == NULL
+		|| pe->Jdegree == NULL || pe->hSamp == NULL || pe->estHetN == NULL
+		|| pe->sampSE == NULL || pe->confSamplow == NULL
+		|| pe->confSamphi == NULL
+		|| pe->hetD == NULL || pe->loHetNe == NULL || pe->hiHetNe == NULL
+		|| pe->indAlleH == NULL || pe->hetTmp == NULL
+		|| pe->okCoan == NULL || (profile == 1 && pe->prof == NULL)) {
+		RemovePopEst (pe);
+		return NULL;
+	};
+	*(pe->popID) = '\0';
+	pe->con = stdout;
+	for (n=0; n<nCrit; n++) {
+		*(pe->jackOK+n) = 1;
+		*(pe->confJacklow+n) = *(pe->confParalow+n) = -(float)infinite;
+		*(pe->confJackhi+n) = *(pe->confParahi+n) = (float)infinite;
+		*(pe->sampSE+n) = -1;
+	};
+	return pe;
+}
+
+//------------------------------------------------------------------
+
+void PopReport (POPEST pe, POPSET ps)
+// Oct 2026: write timing of phases of population pe to the profile file,
+// one line for each phase run, tab-separated so they can be compared
+// between runs or releases. Then reset for the next population.
+{
+	char *name[NPHASE] = {"read", "freq", "eligible", "LD", "LDpairs",
+						"LDreweigh", "LDconfid", "HetExcess", "Coancestry",
+						"Temporal", "output"};
+	int k;
+	long peak;
+	PHASE ph;
+	if (pe->prof == NULL || ps->profOut == NULL) return;
+	peak = MemInUse (1);
+	for (k=0; k<NPHASE; k++) {
+		ph = pe->prof+k;
+		if (ph->calls == 0) continue;
+		fprintf (ps->profOut, "%d\t%d\t%s\t%ld\t%.6f\t%.6f\t%llu\t%lld\t%ld\n",
+				ps->icount, pe->popRead, name[k], ph->calls, ph->wall,
+				ph->cpu, ph->pairs, ph->bytes, peak);
+	};
+	fflush (ps->profOut);
+	for (k=0; k<NPHASE; k++) memset (pe->prof+k, 0, sizeof(struct phase));
+}
+
+//------------------------------------------------------------------
+
+long OutputPos (POPSET ps)
+// Oct 2026: total position in main and tabular-format outputs, to count
+// bytes written by the profiler (outputs not seekable are not counted)
+{
+	FILE *out[4];
+	long pos, total = 0;
+	int k;
+	out[0] = ps->output;
+	out[1] = ps->shOutputLD;
+	out[2] = ps->shOutputHet;
+	out[3] = ps->shOutputCoan;
+	for (k=0; k<4; k++)
+		if (out[k] != NULL && (pos = ftell (out[k])) > 0) total += pos;
+	return total;
+}
+
+//------------------------------------------------------------------
+
+void PopCritLoop (POPEST pe, POPSET ps, FILE *outLoc, FILE **locTmp)
+// Loop of LD method over critical values for population pe, also moving
+// locus data of Het. excess at each critical value to outLoc. If locTmp is
+// not NULL, locus data at critical value n go to locTmp[n] instead.
+{
+	int n, nLocOK, lastOK;
+	char moreBurr;
+	float *critVal = ps->critVal;
+	FILE *outBurr = *(ps->outBurr);
+	char *outBurrName = ps->outBurrName;
+	char *outFile = ps->outFile;
+	FILE *locOut = outLoc;
+	PAIRSTAT stat = NULL;
+
+	if (ps->mLD == 1) stat = PairStatBegin (pe, ps);
+	for (n=0; n<ps->nCrit; n++) {// for nCrit frequency cut-off values
+	// this loop is for LD and HetExcess methods only
+		if (locTmp != NULL) locOut = *(locTmp+n);
+// print to console if not running multiple files (in all others, icount=0):
+//		if (icount == 0) {
+			if (critVal[n] == 0)
+				fprintf (pe->con, "   * For lowest freq: %5s\n", "0+");
+			else
+				fprintf (pe->con, "   * For lowest freq: %5.3f\n", critVal[n]);
+//		};
+	// Burrow outputs only to topBCrit highest crit. values
+	// If topBCrit = 0: only critical value 0 (at n = nCrit-1)
+	// If topBCrit > 0: the crit. values taken are:
+	// critVal[0], ..., critVal[m], m = min(topBCrit, nCrit) - 1.
+	// If topBCrit < 0: all
+		moreBurr = 0;
+		if ((ps->topBCrit < 0) || (ps->topBCrit-n > 0) ||
+			((ps->topBCrit == 0) && (n == ps->nCrit-1)))
+			moreBurr = pe->moreBurr0;
+// add in Nov 2014/ Jan 2015:
+		if (moreBurr == 1 && ps->sepBurOut == 1) {
+			outBurr = NULL;
+			*outBurrName = '\0';
+			if (NONAMEBUR != 1)
+				GetPrefix (ps->inpName, outBurrName, LENFILE-20, PATHCHR);
+			GetBurrName(outBurrName, pe->popRead, critVal[n]);
+			*outFile = '\0';
+			outFile = strcat (outFile, ps->outFolder);
+			if ((outBurr=fopen(strcat(outFile, outBurrName),"w"))!=NULL)
+			{
+				setvbuf (outBurr, NULL, _IOFBF, OUTBUF);
+				if (NOEXPLAIN != 1) {
+					PrtVersion (outBurr);
+					fprintf (outBurr, "Input File: %s\n\n", ps->inpName);
+					fprintf (outBurr,
+						"\nPOPULATION%6d\t(Sample Size = %d)\n",
+							pe->popRead, pe->samp);
+				}
+			} else *(ps->popBurr2) = 0;	// if cannot open, stop Burrows
+
+		}
+
+		PhaseBegin (pe->prof, PH_ELIG);
+		nLocOK = Loci_Eligible (pe->samp, pe->missptr, critVal[n],
+				pe->alleList, ps->nloci, pe->nMobil, pe->minFreq,
+				pe->maxFreq, pe->okLoc, &lastOK, ps->locUse, locOut, outBurr,
+				pe->moreDat, moreBurr, ps->sepBurOut, ps->moreCol);
+		PhaseEnd (pe->prof, PH_ELIG);
+		*(pe->jackOK+n) = (nLocOK <= MAXJACKLD)? 1: 0;
+		if (ps->mLD == 1) {
+			pe->memOut = 0;
+			PhaseBegin (pe->prof, PH_LD);
+			pe->estNe[n] = LDmethod (critVal[n], pe->alleList, pe->popRead,
+					pe->samp, pe->fishHead, pe->nMobil, pe->missptr, lastOK,
+					pe->okLoc, (pe->nIndSum+n), (pe->rB2WAve+n),
+					(pe->r2Drift+n), (pe->wHarmonic+n), (pe->wExpR2+n),
+					outBurr, locOut, pe->moreDat, moreBurr, outBurrName,
+					ps->mating, ps->infinite, ps->param, pe->jSamp,
+					(pe->jackOK+n),	// to handle if cannot do jackknife
+					(pe->confJacklow+n), (pe->confJackhi+n), (pe->Jdegree+n),
+					(pe->confParalow+n), (pe->confParahi+n), pe->weighsmp,
+					&(pe->memOut), ps->icount, ps->sepBurOut, ps->moreCol,
+					ps->BurAlePair, ps->chromoList, ps->nChromo, ps->chroGrp,
+					ps->progOut, ps->r2Out, ps->ldOpt, (pe->sampSE+n),
+					(pe->confSamplow+n), (pe->confSamphi+n), pe->prof, stat,
+					pe->con);
+			PhaseEnd (pe->prof, PH_LD);
+			if (*(pe->nIndSum+n) >= ps->infinite) pe->bigInd = 1;
+		// add in Nov 2014/ Jan 2015:
+			if (outBurr != NULL && ps->sepBurOut == 1) {
+				fprintf (pe->con,  "     Burrows coeffs are in file %s.\n",
+													outBurrName);
+				fclose (outBurr);
+				outBurr = NULL;
+			}
+		};	// end of LD method
+	// Dec 2016: no dropping only singletons in Het method:
+		if (critVal[n] > 0 && critVal[n] <= PCRITX) continue;
+		if (ps->mHet == 1)
+			HetPrtCrit (locOut, *(pe->hetTmp+n), *(pe->estHetN+n), pe->con);
+	};	// end of loop for critical values
+// Oct 2026: only populations having Burrows outputs change it, they are not
+// estimated at the same time as others (see PopWindow)
+	if (pe->moreBurr0 == 1) *(ps->outBurr) = outBurr;
+	PairStatClose (stat);
+}
+
+//------------------------------------------------------------------
+
+void TempCompute (POPEST pe, POPSET ps, FILE *con)
+// Temporal method: add allele frequencies of population pe as generation
+// ps->generation. If it ends a set of generations (ps->tpDone = 1),
+// estimate all pairs of generations into ps->tempRes, to be printed by
+// RunPop0. ps->errfreq is nonzero if out of memory. Console stream is con.
+{
+	int g1, g2, iPair, nPair;
+	int generation = ps->generation;
+	TEMPRES *tempRes, res;
+
+	ps->tempRes = NULL;
+	AddFreqWide (ps->freqList, pe->alleList, ps->nloci, pe->samp,
+				pe->missptr, ps->locUse, ps->nGeneration, generation,
+				&(ps->errfreq), pe->weighsmp);
+	if (ps->errfreq != 0 || ps->tpDone == 0) return;
+	if (generation > 0) {
+		fprintf (con, "\nTemporal Method ... ");
+		if (ps->census > 0)
+			fprintf (con, "Plan I, Census Size = %d\n", ps->census);
+		else fprintf (con, "Plan II\n");
+	};
+// Oct 2026: pairs of generations are estimated concurrently, each into its
+// own result record (locus data into a temporary file), then printed by
+// RunPop0 in the same order as before.
+	nPair = generation*(generation+1)/2;
+	tempRes = (TEMPRES*) malloc (sizeof(TEMPRES)*(nPair+1));
+	if (tempRes == NULL) ps->errfreq = -1;
+	else for (g1=0, iPair=0; g1<generation; g1++) {
+		for (g2=g1+1; g2<generation+1; g2++, iPair++) {
+			res = MakeTempRes (g1, g2, ps->nCrit);
+			if (res == NULL) ps->errfreq = -1;
+			else if (ps->outLoc != NULL && pe->moreDat == 1)
+				res->outTmp = tmpfile();
+			*(tempRes+iPair) = res;
+		};
+	};
+	if (ps->errfreq == 0) {
+		#pragma omp parallel if (nPair > 1)
+		{
+			TEMPRES resPair;
+			TEMPSCR scr = MakeTempScr (ps->nloci, ps->nCrit);
+			#pragma omp for schedule(dynamic)
+			for (iPair=0; iPair<nPair; iPair++) {
+				resPair = *(tempRes+iPair);
+				if (scr == NULL) {
+					resPair->g2 = -1;	// not estimated
+					continue;
+				};
+				TemporalNeEst (resPair->outTmp, pe->moreDat,
+						ps->freqList, ps->nloci, ps->locUse,
+						resPair->g1, resPair->g2, ps->nCrit,
+						ps->critVal, resPair->nTotAlle,
+						resPair->nIndAlle, resPair->Hkmean,
+						resPair->Hcmean, resPair->Hsmean,
+						resPair->fkmean, resPair->fcmean,
+						resPair->fsmean, resPair->fkprimeMean,
+						resPair->fcprimeMean, resPair->fsprimeAll,
+						resPair->NeTempk, resPair->NeTempc,
+						resPair->NeTemps, resPair->loNek,
+						resPair->hiNek, resPair->loNec,
+						resPair->hiNec, resPair->loNes,
+						resPair->hiNes, resPair->jloNek,
+						resPair->jhiNek, resPair->jloNec,
+						resPair->jhiNec, resPair->jloNes,
+						resPair->jhiNes, ps->param, ps->jacknife,
+						ps->timeline, ps->census, ps->tempk, ps->tempc,
+						ps->temps, ps->infinite, pe->weighsmp, scr);
+			};
+			RemoveTempScr (scr);
+		}
+		for (iPair=0; iPair<nPair; iPair++) {
+			res = *(tempRes+iPair);
+			if (res->g2 < 0) ps->errfreq = -1;
+		};
+	};
+	if (ps->errfreq != 0) {
+		fprintf (con, "Out of memory for temporal method!\n");
+		if (tempRes != NULL) {
+			for (iPair=0; iPair<nPair; iPair++)
+				RemoveTempRes (*(tempRes+iPair));
+			free (tempRes);
+		};
+		return;
+	};
+	ps->tempRes = tempRes;
+}
+
+//------------------------------------------------------------------
+
+void PopTask (POPEST pe, POPSET ps, FILE *outLoc, FILE **locTmp, FILE *con,
+			int task, int nThread)
+// Run methods on population pe (see PopCompute): task 0 for Het. excess
+// then the loop of critical values (LD), 1 for Coancestry, 2 for temporal.
+// Console text of tasks 1, 2 goes to con (task 0 prints to pe->con). If
+// nThread > 0, the method's own loops run with nThread threads.
+{
+#ifdef _OPENMP
+	if (nThread > 0) omp_set_num_threads (nThread);
+#endif
+	if (task == 0) {
+		if (ps->mHet == 1) {
+			PhaseBegin (pe->prof, PH_HET);
+			HetXcess (pe->fishHead, pe->alleList, ps->nloci, pe->samp,
+				pe->nMobil, pe->missptr, ps->locUse, pe->maxFreq, outLoc,
+				pe->moreDat, pe->hetTmp, ps->nCrit, ps->critVal, pe->hetD,
+				pe->estHetN, pe->indAlleH, pe->hSamp, pe->loHetNe,
+				pe->hiHetNe, ps->param);
+			PhaseEnd (pe->prof, PH_HET);
+		};
+		PopCritLoop (pe, ps, outLoc, locTmp);
+	} else if (task == 1) {
+		PhaseBegin (pe->prof, PH_COAN);
+		pe->coanNeb = CoanMethod (pe->fishHead, pe->alleList, pe->nMobil,
+					ps->nloci, pe->samp, pe->okCoan, &(pe->f1),
+					(locTmp == NULL)? outLoc: *(locTmp+ps->nCrit),
+					pe->moreDat, &(pe->loNbCoan), &(pe->hiNbCoan),
+					ps->jacknife, pe->missptr, &(pe->hSamCoan), con);
+		PhaseEnd (pe->prof, PH_COAN);
+	} else {
+		PhaseBegin (pe->prof, PH_TEMP);
+		TempCompute (pe, ps, con);
+		PhaseEnd (pe->prof, PH_TEMP);
+	};
+}
+
+//------------------------------------------------------------------
+
+double LDTileWork (int nOK, int nfish, char jack)
+// Oct 2026: bytes LDRunTiles holds for a band of tiles on nOK loci, as it
+// decides on its buffer (0 if it goes to LDRunPairs). The buffer is sized
+// for nBand full rows, but only the pairs of the first band are written,
+// the rows get shorter; pages not written are not in memory.
+{
+	int nTile, nBand;
+	unsigned long long winPair;
+	double pair = sizeof(struct ldpair);
+	nTile = LDTILEMEM/(4*nfish*(int) sizeof(struct fish));
+	if (nTile < LDTILEMIN || nOK <= nTile) return 0;
+	winPair = LDWINPAIR;
+	if (jack != 0 && winPair > LDWINJACK/nfish) winPair = LDWINJACK/nfish;
+	nBand = (winPair/nOK < nTile)? (int) (winPair/nOK): nTile;
+	if (nBand < LDTILEMIN) return 0;
+	winPair = (unsigned long long) nBand*(nOK-1)
+			- (unsigned long long) nBand*(nBand-1)/2;
+	if (jack != 0) pair += (double) nfish*(2*sizeof(float) + sizeof(int));
+	return winPair*pair + sizeof(int)*nOK
+			+ sizeof(unsigned long long)*(nBand+1);
+}
+
+//------------------------------------------------------------------
+
+void PopCost (POPEST pe, POPSET ps)
+// Oct 2026: dry run (argument "e:"), the cost of estimating population pe
+// is predicted on this machine, nothing is estimated. At each critical
+// value, the locus pairs LD method would go over are counted (as in
+// LDPairTotal, LDSampPairs), and up to LDCOSTPAIR of them are timed in
+// Burrows_Calcul. Memory is what the program holds now, plus work arrays
+// of LD method and its records of 5 floats per pair (see LDmethod), which
+// go to a temporary file if USETMP = 1. Coancestry is timed on one locus.
+// Methods run at the same time as in PopCompute, if there are threads.
+// Work arrays include the buffer of pairs where LD method keeps them: the
+// window of LDChromoSched, LDSampPairs if threaded, the band of tiles of
+// LDRunTiles (serial) when it goes over all pairs (see LDTileWork).
+{
+	int n, p, i, k, nCal, lastOK, nLocOK, maxNAlle, polyLoc = 0;
+	int nInd1, nInd2, nMpairs, nThread = 1, nTask, nThrLD;
+	int *locs;
+	float nSamp, rB, expR2, sp, hSamp = 0, epsilon;
+	char jack, sampled, burr;
+	unsigned long long nPair, nAll, win;
+	double t0, secPair, sec, work, ram, disk, base, coanSec = 0;
+	double popSec = 0, popRAM = 0, popDisk = 0, MB = 1048576.0;
+	LDSCR scr;
+	LDOPT ldOpt = ps->ldOpt;
+	int nfish = pe->samp;
+	int nloci = ps->nloci;
+	float *critVal = ps->critVal;
+
+	base = MemInUse (0)/1024.0;
+	if (base < 0) base = 0;
+	epsilon = (float) 8*nfish*nfish;
+	epsilon = 1/epsilon;
+	nTask = ((ps->mHet + ps->mLD > 0)? 1: 0) + ps->mNomura;
+#ifdef _OPENMP
+	nThread = omp_get_max_threads();
+#endif
+	if (nThread == 1) nTask = 1;
+	nThread -= nTask-1;		// threads left over for LD method
+	if (nThread < 1) nThread = 1;
+	// LD method takes threads on sampled pairs, or on chromosomes when
+	// Burrows coefficients are not listed
+	sampled = (ldOpt->nSample > 0 || ldOpt->anytime == 1
+				|| ldOpt->nShard > 0)? 1: 0;
+	if ((ps->chroGrp == 0 || ps->nChromo <= 1) && sampled == 0) nThread = 1;
+	popRAM = base;
+	if (ps->mLD == 1 && (locs = (int*) malloc(sizeof(int)*nloci)) != NULL) {
+		fprintf (pe->con,
+			"     Dry run: LD method on up to %d thread(s)\n", nThread);
+		fprintf (pe->con,
+			"       Crit.  Loci   Locus pairs   us/pair    Time (s)"
+				"   Temp (MB)\n");
+		for (n=0; n<ps->nCrit; n++) {
+			nLocOK = Loci_Eligible (nfish, pe->missptr, critVal[n],
+					pe->alleList, nloci, pe->nMobil, pe->minFreq,
+					pe->maxFreq, pe->okLoc, &lastOK, ps->locUse, NULL, NULL,
+					0, 0, ps->sepBurOut, ps->moreCol);
+			maxNAlle = 0;
+			for (p=0, k=0; p<=lastOK; p++) {
+				if (*(pe->okLoc+p) == 0) continue;
+				*(locs+k++) = p;
+				if (*(pe->nMobil+p) > maxNAlle) maxNAlle = *(pe->nMobil+p);
+			}
+			maxNAlle++;
+			nAll = (k > 1)? (unsigned long long) k*(k-1)/2: 0;
+			if (ps->chroGrp > 0 && ps->nChromo > 1)
+				nPair = LDPairTotal (ps->chromoList, ps->nChromo, ps->chroGrp,
+									lastOK, pe->okLoc);
+			else nPair = nAll;
+			if (ldOpt->nSample > 0 && ldOpt->anytime == 0
+				&& nPair > ldOpt->nSample) nPair = ldOpt->nSample;
+			if (ldOpt->nShard > 0 && ldOpt->shard == 0) nPair = 0;
+			else if (ldOpt->nShard > 0)
+				nPair = (nPair + ldOpt->nShard - 1)/ldOpt->nShard;
+		// time pairs of neighbouring eligible loci, spread over all loci
+			secPair = 0;
+			jack = (pe->jSamp == 1 && nLocOK <= MAXJACKLD)? 1: 0;
+			nCal = (k-1 < LDCOSTPAIR)? k-1: LDCOSTPAIR;
+			if (nCal > 0 && (scr = MakeLDScr (nfish, maxNAlle)) != NULL) {
+				t0 = WallClock ();
+				for (i=0; i<nCal; i++) {
+					p = (int) ((long long) i*(k-1)/nCal);
+					Burrows_Calcul (critVal[n], *(pe->alleList+*(locs+p)),
+						*(pe->alleList+*(locs+p+1)),
+						*(pe->fishHead+*(locs+p)),
+						*(pe->fishHead+*(locs+p+1)), *(locs+p), *(locs+p+1),
+						*(pe->nMobil+*(locs+p)), *(pe->nMobil+*(locs+p+1)),
+						nfish, &nSamp, &nInd1, &nInd2, &nMpairs, &rB,
+						pe->popRead, pe->missptr, NULL, NULL, 0, 1, &expR2,
+						pe->weighsmp, ps->sepBurOut, ps->moreCol,
+						ps->BurAlePair, jack, scr->p1Gen, scr->p2Gen,
+						scr->noDatFish, scr->countm1, scr->countm2,
+						scr->mValp1, scr->freqp1, scr->homop1, scr->mValp2,
+						scr->freqp2, scr->homop2, scr->r2AtPairX,
+						scr->JweighPair, scr->r2Count, epsilon);
+				}
+				secPair = (WallClock () - t0)/nCal;
+				RemoveLDScr (scr);
+			}
+			burr = (pe->moreBurr0 == 1 && (ps->topBCrit < 0
+				|| ps->topBCrit-n > 0 || (ps->topBCrit == 0
+				&& n == ps->nCrit-1)))? 1: 0;	// as in PopCritLoop
+			nThrLD = (sampled == 0 && burr == 1)? 1: nThread;
+			sec = nPair*secPair/nThrLD;
+		// work arrays of each thread, buffer of pairs (see above)
+			work = (double) nThrLD*(sizeof(int*)*2*nfish
+					+ sizeof(int)*(5*nfish + 2*maxNAlle) + 2*nfish
+					+ sizeof(float)*(2*nfish + 4*maxNAlle)
+					+ sizeof(unsigned long long)*nfish);
+			if (nThrLD > 1) {
+				win = (nPair < LDWINPAIR)? nPair: LDWINPAIR;
+				if (jack == 1 && win > LDWINJACK/nfish) win = LDWINJACK/nfish;
+				work += (double) win*sizeof(struct ldpair);
+				if (jack == 1)
+					work += (double) win*nfish*(2*sizeof(float) + sizeof(int));
+			} else if (sampled == 0 && (ps->chroGrp == 0 || ps->nChromo <= 1)
+				&& burr == 0)
+				work += LDTileWork (k, nfish, jack);
+			ram = base + work/MB;
+			disk = 0;
+			if (USETMP == 1) disk = (double) nPair*5*sizeof(float)/MB;
+			else ram += (double) nAll*5*sizeof(float)/MB;
+			if (critVal[n] == 0) fprintf (pe->con, "%12s", "0+");
+			else fprintf (pe->con, "%12.3f", critVal[n]);
+			fprintf (pe->con,
+				"%6d%14llu%10.2f%12.1f%12.1f\n", k, nPair, secPair*1e6,
+					sec, disk);
+			popSec += sec;
+			if (ram > popRAM) popRAM = ram;
+			if (disk > popDisk) popDisk = disk;
+		}
+		free (locs);
+	}
+	if (ps->mNomura == 1) {
+		for (p=0, k=0, i=-1; p<nloci; p++) {
+			if (*(pe->okCoan+p) == 0 || *(pe->nMobil+p) == 0) continue;
+			if (i < 0) i = p;
+			k++;
+		}
+		if (i >= 0) {
+			t0 = WallClock ();
+			CoanDiff (pe->fishHead, pe->nMobil, i, nloci, nfish, pe->okCoan,
+					&sp, NULL, 0, nfish - *(pe->missptr+i), &hSamp, &polyLoc);
+			coanSec = (WallClock () - t0)*k;
+		}
+		fprintf (pe->con,
+			"     Dry run: Coancestry on %d loci, %lld sample pairs,"
+				" %.1f s\n", k, (long long) nfish*(nfish-1)/2, coanSec);
+	}
+	if (nTask == 1) popSec += coanSec;
+	else if (coanSec > popSec) popSec = coanSec;
+	fprintf (pe->con, "     Predicted: %.1f s, peak RAM %.1f MB, temporary disk"
+			" %.1f MB\n", popSec, popRAM, popDisk);
+	ps->costSec += popSec;
+	if (popRAM > ps->costRAM) ps->costRAM = popRAM;
+	if (popDisk > ps->costDisk) ps->costDisk = popDisk;
+}
+
+//------------------------------------------------------------------
+
+void PopCompute (POPEST pe, POPSET ps, FILE *outLoc)
+// Run LD, Het. excess, Coancestry methods on population pe, results are
+// kept in pe, and temporal method if selected (results in ps). Locus data
+// go to outLoc. Nothing is printed to main output.
+// Oct 2026: the methods run at the same time if there are threads for
+// them, with LD (temporal if no LD) taking the threads left over for its
+// own loops. Locus data then go to temporary files, copied to outLoc in
+// the order of running the methods one after another. So does console
+// text of Coancestry and temporal, printed after that of LD, Het. excess.
+// Console text of pe goes to pe->con.
+{
+	int p, n, t, nTask = 0, nMethod, nLevel;
+	int task[3], nThread = 1;
+	char moreBurr;
+	int nloci = ps->nloci;
+	FILE *outBurr = *(ps->outBurr);
+	FILE **locTmp = NULL;
+	FILE *conTmp[3];
+
+	for (p=0; p<nloci; p++) if (*(pe->nMobil+p)==0) *(pe->okLoc+p)=0;
+	moreBurr = pe->moreBurr0;
+	pe->memOut = 0;
+	pe->bigInd = 0;
+	PhaseBegin (pe->prof, PH_FREQ);
+	Loc_Freq (pe->alleList, nloci, pe->samp, &(pe->hetNeb), pe->nMobil,
+			pe->missptr, ps->locUse, pe->minFreq, pe->maxFreq, outLoc,
+			ps->outLocName, pe->moreDat, pe->popRead, ps->mHet, ps->lenM,
+			ps->locList, pe->con);
+	PhaseEnd (pe->prof, PH_FREQ);
+//	change in Nov 2014/Jan 2015 with sepBurOut
+	if (outBurr != NULL && moreBurr == 1 && ps->sepBurOut == 0)
+		fprintf (outBurr, "\nPOPULATION%6d\t(Sample Size = %d)\n",
+				pe->popRead, pe->samp);
+	for (p=0; p<nloci; p++) *(pe->okCoan+p) = *(ps->locUse+p);
+// Oct 2026: in dry run, the cost is predicted in place of estimates
+	if (ps->ldOpt != NULL && ps->ldOpt->dryRun == 1) {
+		PopCost (pe, ps);
+		return;
+	}
+// the methods in the order of running them one after another; Het. excess
+// is for all critical values at once, before the loop that prints it
+	if (ps->mHet + ps->mLD > 0) task[nTask++] = 0;
+	if (ps->mNomura == 1) task[nTask++] = 1;
+	if (ps->mTemporal == 1) task[nTask++] = 2;
+	nMethod = ((ps->mHet + ps->mLD > 0)? 1: 0) + ps->mNomura
+			+ ((ps->mTemporal == 1 && ps->tpDone == 1)? 1: 0);
+#ifdef _OPENMP
+	if (!omp_in_parallel()) nThread = omp_get_max_threads();
+#endif
+	for (t=0; t<nTask; t++) conTmp[t] = (t == 0)? pe->con: NULL;
+	if (nMethod > 1 && nThread > 1) {
+		for (t=1; t<nTask; t++) if ((conTmp[t] = tmpfile()) == NULL) break;
+		if (t == nTask) locTmp = (FILE**) malloc(sizeof(FILE*)*(ps->nCrit+1));
+	};
+	if (locTmp == NULL) {
+		for (t=1; t<nTask; t++) if (conTmp[t] != NULL) fclose (conTmp[t]);
+		for (t=0; t<nTask; t++)
+			PopTask (pe, ps, outLoc, NULL, pe->con, task[t], 0);
+		return;
+	};
+	for (n=0; n<=ps->nCrit; n++)
+		*(locTmp+n) = (outLoc != NULL && pe->moreDat == 1)? tmpfile(): NULL;
+	nThread -= nTask-1;		// threads left over
+	if (nThread < 1) nThread = 1;
+	nLevel = 1;
+#ifdef _OPENMP
+	nLevel = omp_get_max_active_levels();
+	omp_set_max_active_levels (nLevel+1);
+#endif
+	#pragma omp parallel for schedule(dynamic) num_threads(nTask)
+	for (t=0; t<nTask; t++)
+		PopTask (pe, ps, outLoc, locTmp, conTmp[t], task[t],
+			((task[t] == 0 && ps->mLD == 1)
+				|| (task[t] == 2 && ps->mLD == 0))? nThread: 1);
+#ifdef _OPENMP
+	omp_set_max_active_levels (nLevel);
+#endif
+	for (n=0; n<=ps->nCrit; n++) AppendTmp (outLoc, *(locTmp+n));
+	for (t=1; t<nTask; t++) AppendTmp (pe->con, conTmp[t]);
+	free (locTmp);
+}
+//------------------------------------------------------------------
+
+void ResultHead (struct result *res, int icount, int popRead, char *popID,
+				int samp, char *method, float cutoff)
+// Oct 2026: start result res of a method at critical value cutoff, values
+// are set as not done (NAN, -1), to be filled by the caller.
+{
+	res->icount = icount;
+	res->popRead = popRead;
+	strncpy (res->popID, popID, NE2POPID-1);
+	res->popID[NE2POPID-1] = '\0';
+	res->samp = samp;
+	res->method = method;
+	res->cutoff = cutoff;
+	res->estimate = NAN;
+	res->paraLo = res->paraHi = res->jackLo = res->jackHi = NAN;
+	res->hMean = res->r2 = res->expR2 = NAN;
+	res->indAlle = -1;
+	res->jackDF = -1;
+}
+
+//------------------------------------------------------------------
+
+int PopResults (POPEST pe, POPSET ps, struct result *res)
+// Oct 2026: put results of population pe in res, which has room for
+// 2*nCrit+1 results, return the number of results.
+{
+	int n, nRes = 0;
+	struct result *rp;
+	for (n=0; n<ps->nCrit && ps->mLD == 1 && pe->memOut == 0; n++) {
+		rp = res + nRes++;
+		ResultHead (rp, ps->icount, pe->popRead, pe->popID, pe->samp, "LD",
+					ps->critVal[n]);
+		rp->estimate = *(pe->estNe+n);
+		if (ps->param == 1) {
+			rp->paraLo = *(pe->confParalow+n);
+			rp->paraHi = *(pe->confParahi+n);
+		};
+		if (pe->jSamp == 1 && *(pe->jackOK+n) == 1) {
+			rp->jackLo = *(pe->confJacklow+n);
+			rp->jackHi = *(pe->confJackhi+n);
+			rp->jackDF = *(pe->Jdegree+n);
+		};
+		rp->hMean = *(pe->wHarmonic+n);
+		rp->indAlle = *(pe->nIndSum+n);
+		rp->r2 = *(pe->rB2WAve+n);
+		rp->expR2 = *(pe->wExpR2+n);
+	};
+	for (n=0; n<ps->nCrit && ps->mHet == 1; n++) {
+		if (ps->critVal[n] > 0 && ps->critVal[n] <= PCRITX) continue;
+		rp = res + nRes++;
+		ResultHead (rp, ps->icount, pe->popRead, pe->popID, pe->samp, "Het",
+					ps->critVal[n]);
+		rp->estimate = *(pe->estHetN+n);
+		if (ps->param == 1) {
+			rp->paraLo = *(pe->loHetNe+n);
+			rp->paraHi = *(pe->hiHetNe+n);
+		};
+		rp->hMean = *(pe->hSamp+n);
+		rp->indAlle = *(pe->indAlleH+n);
+	};
+	if (ps->mNomura == 1) {
+		rp = res + nRes++;
+		ResultHead (rp, ps->icount, pe->popRead, pe->popID, pe->samp, "Coan",
+					0);
+		rp->estimate = pe->coanNeb;
+		if (ps->jacknife == 1) {
+			rp->jackLo = pe->loNbCoan;
+			rp->jackHi = pe->hiNbCoan;
+		};
+		rp->hMean = pe->hSamCoan;
+	};
+	return nRes;
+}
+
+//------------------------------------------------------------------
+
+void PopRecords (POPEST pe, POPSET ps)
+// Oct 2026: write results of population pe as records, see PrtRecord.
+// Records of a population stay together when inputs are run concurrently.
+{
+	int n, nRes;
+	struct result res[2*MAXCRIT+1];
+	nRes = PopResults (pe, ps, res);
+	#pragma omp critical (records)
+	{
+		for (n=0; n<nRes; n++) PrtRecord (ps->recOut, res+n);
+		fflush (ps->recOut->out);
+	}
+}
+
+//------------------------------------------------------------------
+
+int TempResults (struct result *res, int icount, int popRead, char *popID1,
+				char *popID2, int nCrit, float *critVal, TEMPRES tres,
+				char tempk, char tempc, char temps, char param, char jack)
+// Oct 2026: put results of temporal method on a pair of samples, with
+// names popID1, popID2, in res, which has room for 3*nCrit results, return
+// the number of results. popRead is the last population of the set of
+// samples.
+{
+	int n, k, nRes = 0;
+	char pair[2*POP_TEMP+4];
+	struct result *rp;
+	char *method[3] = {"Temporal-Pollak", "Temporal-NeiTajima",
+						"Temporal-JordeRyman"};
+	char use[3];
+	float *Ne[3], *loNe[3], *hiNe[3], *jloNe[3], *jhiNe[3], *Hmean[3];
+	use[0] = tempk;
+	use[1] = tempc;
+	use[2] = temps;
+	Ne[0] = tres->NeTempk;	Ne[1] = tres->NeTempc;	Ne[2] = tres->NeTemps;
+	loNe[0] = tres->loNek;	loNe[1] = tres->loNec;	loNe[2] = tres->loNes;
+	hiNe[0] = tres->hiNek;	hiNe[1] = tres->hiNec;	hiNe[2] = tres->hiNes;
+	jloNe[0] = tres->jloNek; jloNe[1] = tres->jloNec; jloNe[2] = tres->jloNes;
+	jhiNe[0] = tres->jhiNek; jhiNe[1] = tres->jhiNec; jhiNe[2] = tres->jhiNes;
+	Hmean[0] = tres->Hkmean; Hmean[1] = tres->Hcmean; Hmean[2] = tres->Hsmean;
+	snprintf (pair, 2*POP_TEMP+4, "%s & %s", popID1, popID2);
+	for (k=0; k<3; k++) {
+		if (use[k] != 1) continue;
+		for (n=0; n<nCrit; n++) {
+			if (critVal[n] > 0 && critVal[n] <= PCRITX) continue;
+			rp = res + nRes++;
+			ResultHead (rp, icount, popRead, pair, -1, method[k], critVal[n]);
+			rp->estimate = *(Ne[k]+n);
+			if (param == 1) {
+				rp->paraLo = *(loNe[k]+n);
+				rp->paraHi = *(hiNe[k]+n);
+			};
+			if (jack == 1) {
+				rp->jackLo = *(jloNe[k]+n);
+				rp->jackHi = *(jhiNe[k]+n);
+			};
+			rp->hMean = *(Hmean[k]+n);
+			rp->indAlle = *(tres->nIndAlle+n);
+		};
+	};
+	return nRes;
+}
+
+//------------------------------------------------------------------
+
+void TempRecords (RECOUT rec, int icount, int popRead, char *popID1,
+				char *popID2, int nCrit, float *critVal, TEMPRES tres,
+				char tempk, char tempc, char temps, char param, char jack)
+// Oct 2026: write results of temporal method on a pair of samples as
+// records, see TempResults, PrtRecord.
+{
+	int n, nRes;
+	struct result res[3*MAXCRIT];
+	nRes = TempResults (res, icount, popRead, popID1, popID2, nCrit,
+						critVal, tres, tempk, tempc, temps, param, jack);
+	#pragma omp critical (records)
+	{
+		for (n=0; n<nRes; n++) PrtRecord (rec, res+n);
+		fflush (rec->out);
+	}
+}
+
+//------------------------------------------------------------------
+
+void PopPrint (POPEST pe, POPSET ps)
+// Print results of population pe to main output and tabular-format outputs
+{
+	int n, m;
+	char header;
+	time_t rawtime;
+	FILE *output = ps->output;
+	int nCrit = ps->nCrit;
+	float *critVal = ps->critVal;
+	float infinite = ps->infinite;
+
+	if (ps->ldOpt != NULL && ps->ldOpt->dryRun == 1) return;	// see PopCost
+	if (pe->bigInd == 1) ps->bigInd = 1;
+	PrtPop (output, pe->popRead, pe->popID, pe->samp, ps->mLD, ps->mHet,
+			ps->mNomura, ps->mating, ps->nloci, pe->nMobil, ps->locUse,
+			ps->specP);
+	if (ps->mHet+ps->mLD > 0)
+		PrtFreq (output, ps->mLD, critVal, nCrit, '-', '-');
+	if (ps->mLD == 1 && pe->memOut == 0) {
+		PrtLDResults (output, nCrit, pe->wHarmonic, pe->nIndSum,
+					pe->rB2WAve, pe->wExpR2, pe->estNe, infinite, ps->bigInd);
+
+// To inform that recalculating Ne when missing data is suppressed:
+		if (RESETNE == 0 && pe->weighsmp > 0) fprintf(output,
+		"(No attempt to adjust r^2 and Ne for missing data.)\n");
+
+		header = ps->param+pe->jSamp;
+	// Oct 2026: CIs from sampling locus pairs, if sampled at some crit.
+		for (n=0, m=0; n<nCrit; n++) if (*(pe->sampSE+n) >= 0) m = 1;
+		header += m;
+		if (ps->param==1)
+			PrtLDConfid (output, nCrit, pe->confParalow, pe->confParahi,
+						infinite, 0, &header, pe->jackOK, ps->bigInd);
+	// if previous call proceeded, header will become false
+		if (pe->jSamp==1)
+			PrtLDConfid (output, nCrit, pe->confJacklow, pe->confJackhi,
+						infinite, 1, &header, pe->jackOK, ps->bigInd);
+		if (m == 1) {
+			for (n=0; n<nCrit; n++) if (*(pe->sampSE+n) < 0)
+				*(pe->confSamplow+n) = *(pe->confSamphi+n) = *(pe->estNe+n);
+			PrtLDConfid (output, nCrit, pe->confSamplow, pe->confSamphi,
+						infinite, 2, &header, pe->jackOK, ps->bigInd);
+		};
+		if (ps->tabX==0) PrtLDxFile (ps->inpName, ps->shOutputLD, pe->samp,
+				pe->wHarmonic, pe->popRead, ps->popStart, pe->popID, critVal,
+				nCrit, pe->nIndSum, pe->rB2WAve, pe->wExpR2, pe->estNe,
+				ps->param, ps->jacknife, infinite, pe->confParalow,
+				pe->confParahi, pe->confJacklow, pe->confJackhi, pe->Jdegree,
+				pe->jackOK, ps->mating, ps->topCrit, ps->nLocUsed, ps->icount,
+				ps->common);
+		else PrtLDTabFile (ps->inpName, ps->shOutputLD, pe->samp,
+				pe->wHarmonic, pe->popRead, ps->popStart, pe->popID, critVal,
+				nCrit, pe->nIndSum, pe->rB2WAve, pe->wExpR2, pe->estNe,
+				ps->param, ps->jacknife, infinite, pe->confParalow,
+				pe->confParahi, pe->confJacklow, pe->confJackhi, pe->jackOK,
+				ps->mating, ps->topCrit, ps->nLocUsed, ps->icount, ps->common,
+				pe->Jdegree);
+	};	// end of printing LD results
+	// print to main output, Neb from Het Ex. and Coancestry,
+	// From Het Ex method, based on lowest freq. req.
+
+	if (ps->mHet == 1) {
+		PrtHetNe (output, pe->hetD, pe->estHetN, pe->loHetNe, pe->hiHetNe,
+				pe->hSamp, ps->param, nCrit, critVal, pe->indAlleH, infinite);
+		if (ps->tabX==0) PrtHetxFile (ps->inpName, ps->shOutputHet,
+				pe->popRead, ps->popStart, pe->popID, critVal, nCrit,
+				pe->indAlleH, pe->hetD, pe->estHetN, ps->param, infinite,
+				pe->loHetNe, pe->hiHetNe, pe->samp, pe->hSamp, ps->topCrit,
+				ps->nLocUsed, ps->icount, ps->common);
+		else PrtHetTabFile (ps->inpName, ps->shOutputHet,
+				pe->popRead, ps->popStart, pe->popID, critVal, nCrit,
+				pe->indAlleH, pe->hetD, pe->estHetN, ps->param, infinite,
+				pe->loHetNe, pe->hiHetNe, pe->samp, pe->hSamp, ps->topCrit,
+				ps->nLocUsed, ps->icount, ps->common);
+	};
+
+	if (ps->mNomura == 1) {
+		n = (ps->mHet+ps->mLD > 0)? nCrit: 1;
+		m = (ps->mHet+ps->mLD > 0 && critVal[nCrit-1] == 0)? 0: 1;
+		PrtNomuraNe (output, pe->f1, pe->coanNeb, n, m, pe->loNbCoan,
+					pe->hiNbCoan, ps->jacknife, pe->hSamCoan);
+		if (ps->tabX==0) PrtCoanxFile (ps->inpName, ps->shOutputCoan,
+					pe->popRead, ps->popStart, pe->popID, pe->f1,
+					pe->coanNeb, ps->jacknife, infinite, pe->loNbCoan,
+					pe->hiNbCoan, pe->samp, pe->hSamCoan, ps->nLocUsed,
+					ps->icount, ps->common);
+		else PrtCoanTabFile (ps->inpName, ps->shOutputCoan,
+					pe->popRead, ps->popStart, pe->popID, pe->f1,
+					pe->coanNeb, ps->jacknife, infinite, pe->loNbCoan,
+					pe->hiNbCoan, pe->samp, pe->hSamCoan, ps->nLocUsed,
+					ps->icount, ps->common);
+	};
+	n = 26 + 12*nCrit;	// draw a line of asterisks at the end:
+	if (ps->bigInd == 1) n += 2*nCrit;
+	if (ps->mHet+ps->mLD > 0) PrtLines (output, n, '*');
+// show the time after finishing Nomura or LD with big data:
+	if (pe->showTime == 1) {
+		time ( &rawtime );
+		#pragma omp critical (ctime)
+		fprintf (output, "\nTime: %s\n", ctime (&rawtime));
+		fflush (output);
+	};
+// Oct 2026: locus data and Burrows outputs are flushed here, once for
+// each population, so at most the population being run is lost if the
+// program stops.
+	if (ps->outLoc != NULL) fflush (ps->outLoc);
+	if (*(ps->outBurr) != NULL) fflush (*(ps->outBurr));
+	if (ps->recOut != NULL) PopRecords (pe, ps);
+}
+
+//------------------------------------------------------------------
+
+void PopWindow (POPEST *popSlot, int nWait, POPSET ps)
+// Estimate populations in popSlot[0], ..., popSlot[nWait-1] concurrently,
+// then print them in this order, and remove their lists. Their console
+// text, kept in temporary files pe->con since they were read, is copied
+// to stdout in the same order, so it is as if they were run one by one.
+{
+	int i;
+	long pos = 0;
+	POPEST pe;
+	#pragma omp parallel for schedule(dynamic) num_threads(nWait) if(nWait > 1)
+	for (i=0; i<nWait; i++)
+		PopCompute (*(popSlot+i), ps, (*(popSlot+i))->locTmp);
+	for (i=0; i<nWait; i++) {
+		pe = *(popSlot+i);
+		if (pe->con != stdout) AppendTmp (stdout, pe->con);
+		pe->con = stdout;
+		PhaseBegin (pe->prof, PH_PRINT);
+		if (pe->prof != NULL) pos = OutputPos (ps);
+		AppendTmp (ps->outLoc, pe->locTmp);
+		pe->locTmp = NULL;
+		PopPrint (pe, ps);
+		if (pe->prof != NULL) (pe->prof+PH_PRINT)->bytes += OutputPos (ps) - pos;
+		PhaseEnd (pe->prof, PH_PRINT);
+		PopReport (pe, ps);
+		RemoveAlle (pe->alleList, ps->nloci);
+		if (pe->fishHead != NULL) RemoveFish (pe->fishHead, ps->nloci);
+	};
+}
+
+//-------------------------------------------------------------------------
+
+void DataFree (DATASET set)
+{
+	int k;
+	if (set == NULL) return;
+	for (k=0; k<set->nPop; k++) free (*(set->popID+k));
+	free (set->popID);
+	free (set->name);
+	free (set->locUse);
+	free (set->next);
+	free (set->geno);
+	free (set->err);
+	free (set->genErr);
+	free (set);
+}
+
+//-------------------------------------------------------------------------
+
+void DataTrim (DATACACHE cache, size_t maxBytes)
+// Oct 2026: free parsed inputs kept in cache whose files have changed,
+// then the least recently used until the rest take at most maxBytes (0 to
+// free all). Called by the server between jobs, when none is being read.
+{
+	DATASET set, *at, *old;
+	for (at = &(cache->head); *at != NULL; ) {
+		set = *at;
+		if (set->stale == 1 || maxBytes == 0) {
+			*at = set->link;
+			cache->bytes -= set->bytes;
+			DataFree (set);
+		} else at = &(set->link);
+	};
+	while (cache->bytes > maxBytes && cache->head != NULL) {
+		old = &(cache->head);
+		for (at = &(cache->head); *at != NULL; at = &((*at)->link))
+			if ((*at)->used < (*old)->used) old = at;
+		set = *old;
+		*old = set->link;
+		cache->bytes -= set->bytes;
+		DataFree (set);
+	};
+}
+
+//-------------------------------------------------------------------------
+
+char DataSame (DATASET a, DATASET b)
+// Oct 2026: return 1 if a and b are parsed from the same file unchanged,
+// for the same loci, 0 if not.
+{
+	if (a->dev != b->dev || a->ino != b->ino || a->mtime != b->mtime
+		|| a->size != b->size || strcmp (a->name, b->name) != 0) return 0;
+	if (a->start != b->start || a->nloci != b->nloci || a->lenM != b->lenM
+		|| a->format != b->format) return 0;
+	return (memcmp (a->locUse, b->locUse, a->nloci) == 0)? 1: 0;
+}
+
+//-------------------------------------------------------------------------
+
+DATAREAD DataOpen (DATACACHE cache, char *name, FILE *input, int nloci,
+				int lenM, char format, char *locUse)
+// Oct 2026: start reading input file name (opened as input, which is at
+// the first population) for RunPop0: from the genotypes kept in cache if
+// the file has not changed since they were parsed for the same loci, else
+// from the file, recording them to be kept (see DataClose).
+// Return NULL if there is no cache (not server mode), or out of memory.
+{
+	struct stat st;
+	DATAREAD rd;
+	DATASET set, key;
+	if (cache == NULL || fstat (fileno (input), &st) != 0) return NULL;
+	if ((rd = (DATAREAD) malloc(sizeof(struct dataread))) == NULL)
+		return NULL;
+	if ((key = (DATASET) calloc(1, sizeof(struct dataset))) == NULL
+		|| (key->name = (char*) malloc(strlen (name)+1)) == NULL
+		|| (key->locUse = (char*) malloc(nloci)) == NULL) {
+		DataFree (key);
+		free (rd);
+		return NULL;
+	};
+	strcpy (key->name, name);
+	memcpy (key->locUse, locUse, nloci);
+	key->dev = st.st_dev;
+	key->ino = st.st_ino;
+	key->mtime = MTIMENS (st);
+	key->size = st.st_size;
+	key->start = ftell (input);
+	key->nloci = nloci;
+	key->lenM = lenM;
+	key->format = format;
+	rd->cache = cache;
+	rd->atNext = rd->atPop = rd->atSamp = 0;
+	#pragma omp critical (dataset)
+	{
+		for (set = cache->head; set != NULL; set = set->link) {
+			if (set->stale == 1 || set->dev != key->dev
+				|| set->ino != key->ino || strcmp (set->name, name) != 0)
+				continue;
+			if (set->mtime != key->mtime || set->size != key->size)
+				set->stale = 1;
+			else if (DataSame (set, key) == 1) break;
+		};
+		if (set != NULL) {
+			set->used = cache->job;
+			cache->nKept++;
+		} else cache->nRead++;
+	}
+	rd->replay = (set != NULL)? 1: 0;
+	if (set != NULL) DataFree (key);
+	rd->set = (set != NULL)? set: key;
+	return rd;
+}
+
+//-------------------------------------------------------------------------
 
-	fflush (xOutput);
+void DataDrop (DATAREAD rd)
+// Oct 2026: stop recording the genotypes read from file (see DataOpen).
+{
+	DataFree (rd->set);
+	rd->set = NULL;
 }
 
+//-------------------------------------------------------------------------
 
-// --------------------------------------------------------------------------
+void DataClose (DATAREAD rd)
+// Oct 2026: end reading for RunPop0 (see DataOpen). Genotypes recorded
+// are kept if the file was read to the end, and the same are not kept
+// already (by an input run at the same time).
+{
+	DATACACHE cache;
+	DATASET set, old;
+	if (rd == NULL) return;
+	cache = rd->cache;
+	set = rd->set;
+	if (set != NULL && rd->replay == 0) {
+		if (set->nNext > 0 && *(set->next+set->nNext-1) == -1) {
+			set->used = cache->job;
+			#pragma omp critical (dataset)
+			{
+				for (old = cache->head; old != NULL; old = old->link)
+					if (old->stale == 0 && DataSame (old, set) == 1) break;
+				if (old == NULL) {
+					set->link = cache->head;
+					cache->head = set;
+					cache->bytes += set->bytes;
+					set = NULL;
+				};
+			}
+		};
+		DataFree (set);
+	};
+	free (rd);
+}
+
+//-------------------------------------------------------------------------
+
+int DataPopID (DATAREAD rd, FILE *input, char format, char *popID,
+				int maxlen)
+// Oct 2026: DatPopID (format FSTAT) or GenPopID on input, or as recorded
+// in rd if not NULL (see DataOpen).
+{
+	DATASET set = (rd == NULL)? NULL: rd->set;
+	int next, n;
+	void *p;
+	if (set != NULL && rd->replay == 1) {
+		if (rd->atNext >= set->nNext) return -1;
+		next = *(set->next + rd->atNext++);
+		if (next == 1) strcpy (popID, *(set->popID + rd->atPop++));
+		return next;
+	};
+	if (format == FSTAT) next = DatPopID (input, popID, maxlen);
+	else next = GenPopID (input, "pop", popID, maxlen);
+	if (set == NULL) return next;
+	if (set->nNext == set->maxNext) {
+		n = 2*set->maxNext + 64;
+		if ((p = realloc (set->next, n)) == NULL) {
+			DataDrop (rd);
+			return next;
+		};
+		set->next = (signed char*) p;
+		set->maxNext = n;
+	};
+	*(set->next + set->nNext++) = next;
+	set->bytes++;
+	if (next != 1) return next;
+	if (set->nPop == set->maxPop) {
+		n = 2*set->maxPop + 16;
+		if ((p = realloc (set->popID, sizeof(char*)*n)) == NULL) {
+			DataDrop (rd);
+			return next;
+		};
+		set->popID = (char**) p;
+		set->maxPop = n;
+	};
+	n = strlen (popID) + 1;
+	if ((p = malloc(n)) == NULL) {
+		DataDrop (rd);
+		return next;
+	};
+	memcpy (p, popID, n);
+	*(set->popID + set->nPop++) = (char*) p;
+	set->bytes += n + sizeof(char*);
+	return next;
+}
+
+//-------------------------------------------------------------------------
+
+int DataSample (DATAREAD rd, FILE *input, int nloci, int *sampData,
+				int lenM, int *samp, int maxlen, int *nSampErr,
+				int *currErr, char genErr[], int *firstErr, char *locUse,
+				FILE *con)
+// Oct 2026: GetSample on input, or as recorded in rd if not NULL (see
+// DataOpen). A sample ending too soon, or having a genotype too wide or
+// not in digits, stops the run of the input (see PrtError), then the
+// genotypes are not kept; nor are they if they take over DATACACHEMB MB.
+{
+	DATASET set = (rd == NULL)? NULL: rd->set;
+	int err, k, n;
+	size_t len = sizeof(int)*2*nloci;
+	void *p;
+	if (set != NULL && rd->replay == 1) {
+		k = rd->atSamp++;
+		memcpy (sampData, set->geno + (size_t) 2*nloci*k, len);
+		err = *(set->err + 3*k);
+		*currErr = *(set->err + 3*k+1);
+		*firstErr = *(set->err + 3*k+2);
+		memcpy (genErr, set->genErr + (size_t) GENLEN*k, GENLEN);
+		(*samp)++;
+		if (*currErr > 0) (*nSampErr)++;
+		return err;
+	};
+	err = GetSample (input, nloci, sampData, lenM, samp, maxlen, nSampErr,
+					currErr, genErr, firstErr, locUse, con);
+	if (set == NULL) return err;
+	if (err < 0 || err/nloci >= 3) {
+		DataDrop (rd);
+		return err;
+	};
+	if (set->nSamp == set->maxSamp) {
+		n = 2*set->maxSamp + 16;
+		if ((p = realloc (set->geno, len*n)) != NULL) set->geno = (int*) p;
+		if (p != NULL && (p = realloc (set->err, sizeof(int)*3*n)) != NULL)
+			set->err = (int*) p;
+		if (p != NULL && (p = realloc (set->genErr, GENLEN*n)) != NULL)
+			set->genErr = (char*) p;
+		if (p == NULL) {
+			DataDrop (rd);
+			return err;
+		};
+		set->maxSamp = n;
+	};
+	k = set->nSamp++;
+	memcpy (set->geno + (size_t) 2*nloci*k, sampData, len);
+	*(set->err + 3*k) = err;
+	*(set->err + 3*k+1) = *currErr;
+	*(set->err + 3*k+2) = *firstErr;
+	memcpy (set->genErr + (size_t) GENLEN*k, genErr, GENLEN);
+	set->bytes += len + sizeof(int)*3 + GENLEN;
+	if (set->bytes > ((size_t) DATACACHEMB << 20)) DataDrop (rd);
+	return err;
+}
 
 // --------------------------------------------------------------------------
 // RunPop
@@ -13259,7 +17627,18 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 			char common, char tabX,
 // add parameters in Apr 2015:
 			char sepBurOut, char moreCol, char BurAlePair,
-			struct chromosome *chromoList, int nChromo, int chroGrp)
+			struct chromosome *chromoList, int nChromo, int chroGrp,
+// Oct 2026: tpHead is NULL, except for input run by RunBatch with common
+// output, to locate the header in temporal tabular-format output.
+			long *tpHead,
+// Oct 2026: progress of LD method is written to progOut if not NULL,
+// timing of phases for each population to profOut (see PopReport),
+// r^2 at locus pairs to r2Out (see R2Add), results to recOut (see PrtRecord),
+// LD method with options ldOpt (see LDSampPairs), NULL for defaults.
+// Oct 2026: populations and genotypes are read through data (see
+// DataOpen), NULL to read them from input.
+			FILE *progOut, FILE *profOut, R2STORE r2Out, RECOUT recOut,
+			LDOPT ldOpt, DATAREAD data)
 // Return values
 // * 0: things are OK, everything else is error.
 // * 1,2: serious error in genotype data: either nondigits are present or
@@ -13274,7 +17653,6 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 // to distinguish if this function is called in doing multiple files
 {
 
-	time_t rawtime;
 // to store all mobility values and their occurences
 	ALLEPTR *alleList;
 // to store the number of different mobility values,
@@ -13290,17 +17668,17 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 // to determine among loci not deleted from input, which one will
 // satisfy criteria for consideration
 	char *okLoc;
-	int nLocOK;
-// calculation of exp r2, estimated Ne,  harmonic mean,
-// r^2 from Burrows coeffs, indep. of alleles
-	float *wExpR2, *estNe, *wHarmonic, *rB2WAve, *r2Drift;
-	char bigInd = 0;	// to notify if # ind alle. too big, to adjust output
+// Oct 2026: results of LD, Het. excess and Coancestry methods are in
+// records POPEST, one for each population being estimated (see PopCompute)
+	POPEST pe, *popSlot;
+	int nSlot, nWait = 0;	// number of records, populations waiting
+	char queued = 0;		// if the population just read is waiting
+	int nThread = 1;
+	long pos = 0;			// input or output position, for profiling
+	struct popset popSet;
 	int *sampData;
-// confidence intervals:
-	float *confJacklow, *confJackhi, *confParalow, *confParahi;
 // pop names:
 	char *popID, *newID;
-	char *jackOK;
 	char weighsmp;
 	// added in june 2016 for jackknife on sample, to notice if the number
 	// of individuals in a population sample is less than MINSAMP,
@@ -13310,9 +17688,8 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 	// ok for others
 	char jSamp;
 
-	char moreDat, moreBurr, moreBurr0;	// to determine which population
+	char moreDat, moreBurr0;	// to determine which population
 		// that outputs to auxiliary files outLoc, outBurr will stop.
-	char header;
 	char genErr[GENLEN];
 	int firstErr;	// for the first locus with missing data;
 //-------------------------------------------------------------------
@@ -13320,21 +17697,6 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 	char *outFile = (char *) malloc(PATHFILE * sizeof(char));
 	*outFile = '\0';
 //-------------------------------------------------------------------
-
-// Coancestry:
-	float loNbCoan, hiNbCoan;
-//-------------------------------------------------------------------
-// To deal with heterozygote excess method
-	float hetNeb;
-	float *hSamp;
-	float *hetD, *estHetN;
-//	float *jloHetNe, *jhiHetNe;
-	float *loHetNe, *hiHetNe;
-	long *indAlleH;
-// To deal with Coancestry method:
-	float f1, coanNeb;
-	float hSamCoan;
-//-------------------------------------------------------------------
 // To deal with temporal method:
 	FREQPTR *freqList;
 	long *nTotAlle, *nIndAlle;
@@ -13345,6 +17707,10 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 	float *fkmean, *fcmean, *fsmean;
 	float *fkprimeMean, *fcprimeMean, *fsprimeAll;
 	int g1, g2;
+// Oct 2026: results of all pairs of generations, the arrays above point
+// to those of a result record when printing
+	TEMPRES *tempRes, res;
+	int iPair;
 	int errfreq = 0;
 // these will be set acording to input tempClue:
 	char tempk = 1, tempc = 1, temps = 1;
@@ -13361,6 +17727,9 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 	int seq = 0;
 	int nPoptemp = 0, nPairTmp = 0;
 
+// Oct 2026: for temporal tabular-format output
+	FILE *tpOut, *tpScr;
+	int smPair;
 // add July 2013
 	int lenTpPop = 25;	// to accomodate 2 population names, each with 10
 						// chars, and a string "/.../"
@@ -13368,13 +17737,12 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 	int popRun = 0;
 	int p, m, n, samp, ind;
 	int isize, size;	// use for missptr array
-	int lastOK, next, popRead, err;
+	int next, popRead, err;
 	int nErr;		// count total missing data
 	int nSampErr;	// count number of samples having missing data
 	int noGen;		// count number of genotype missing in a sample
 	int errCode = 0;
 	FILE *missDat = NULL;
-	int memOut = 0;
 	int nLocUsed;	// for upper bound of locus numbering
 	char makeFish;	// to determine if fishList is to be created
 	if (input == NULL) return 4;	// no input file, don't do a thing
@@ -13423,65 +17791,54 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 		return -1;
 	};
 	size = nloci;
-//	size = (size*(size+1))/2;
-	if ((missptr = (int*) malloc(sizeof(int)*size)) == NULL) {
-//	if ((missptr = (int*) malloc(sizeof(long)*size)) == NULL) {
-		free (sampData);
-		printf ("Out of memory for missing data array!\n");
-		return -1;
-	};
-	if ((nMobil = (int*) malloc(sizeof(int)*nloci)) == NULL) {
-		free (sampData);
-		free (missptr);
-		printf ("Out of memory for array to count alleles!\n");
-		return -1;
-	};
-	if ((minFreq = (float*) malloc(sizeof(float)*nloci)) == NULL) {
-		free (sampData);
-		free (missptr);
-		free (nMobil);
-		printf ("Out of memory for min freq array!\n");
-		return -1;
-	};
-	if ((maxFreq = (float*) malloc(sizeof(float)*nloci)) == NULL) {
-		free (sampData);
-		free (missptr);
-		free (nMobil);
-		free (minFreq);
-		printf ("Out of memory for max freq array!\n");
-		return -1;
-	};
-	if ((okLoc = (char*) malloc(sizeof(char)*nloci)) == NULL) {
+	// set = 1 to fill in list of fish, 0 if list is unneeded
+	makeFish = (mLD > 0 || mNomura > 0 || (mHet > 0 && nCrit > 1))? 1: 0;
+// Oct 2026: with argument "b:n" and more than one thread, populations are
+// estimated nSlot at a time (n, up to the threads; all threads if n = 0),
+// except for temporal method (populations are generations there), and in
+// dry run, where populations are timed one at a time. Each of them holds
+// its genotypes until estimated, so memory grows with nSlot.
+#ifdef _OPENMP
+	nThread = omp_in_parallel()? 1: omp_get_max_threads();
+#endif
+	nSlot = 1;
+	if (ldOpt != NULL && ldOpt->nPopRun != 1 && ldOpt->dryRun == 0
+		&& mTemporal == 0 && nThread > 1)
+		nSlot = (ldOpt->nPopRun > 0 && ldOpt->nPopRun < nThread)?
+				ldOpt->nPopRun: nThread;
+	if ((popSlot = (POPEST*) malloc(sizeof(POPEST)*nSlot)) == NULL) {
 		free (sampData);
-		free (missptr);
-		free (nMobil);
-		free (minFreq);
-		free (maxFreq);
-		printf ("Out of memory for evaluating loci array!\n");
+		printf ("Out of memory for population data!\n");
 		return -1;
 	};
-	if ((alleList = (ALLEPTR*) malloc(sizeof(ALLEPTR)*nloci)) == NULL) {
+	for (n=0; n<nSlot; n++)
+		if ((*(popSlot+n) = MakePopEst (nloci, nCrit, lenBlock, makeFish,
+							infinite, (profOut != NULL)? 1: 0)) == NULL) break;
+	if (n == 0) {
 		free (sampData);
-		free (missptr);
-		free (nMobil);
-		free (minFreq);
-		free (maxFreq);
-		free (okLoc);
-		printf ("Out of memory to reserve alleles!\n");
+		free (popSlot);
+		printf ("Out of memory for population data!\n");
 		return -1;
 	};
+	nSlot = n;	// fewer if memory runs out
+// arrays of the population being read:
+	pe = *popSlot;
+	alleList = pe->alleList;
+	fishHead = pe->fishHead;
+	fishTail = pe->fishTail;
+	nMobil = pe->nMobil;
+	missptr = pe->missptr;
+	minFreq = pe->minFreq;
+	maxFreq = pe->maxFreq;
+	okLoc = pe->okLoc;
 
 //----------- for temporal method
 	if (mTemporal == 1) {
 		if ((freqList = (FREQPTR*) calloc(nloci, sizeof(FREQPTR))) == NULL)
 		{
 			free (sampData);
-			free (missptr);
-			free (nMobil);
-			free (minFreq);
-			free (maxFreq);
-			free (okLoc);
-			free (alleList);
+			for (n=0; n<nSlot; n++) RemovePopEst (*(popSlot+n));
+			free (popSlot);
 			printf  ("Out of memory to reserve alleles!\n");
 			return -1;
 		};
@@ -13527,100 +17884,14 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 			tempsx *= temps;
 		}
 	};
-	// set = 1 to fill in list of fish, 0 if list is unneeded
-	makeFish = (mLD > 0 || mNomura > 0 || (mHet > 0 && nCrit > 1))? 1: 0;
-	if (makeFish > 0) {
-		if ((fishHead = (FISHPTR*) malloc(sizeof(FISHPTR)*nloci)) == NULL) {
-//	if ((fishHead = (FISHPTR*) calloc(nloci, sizeof(FISHPTR))) == NULL) {	//7
-			free (sampData);
-			free (missptr);
-			free (nMobil);
-			free (minFreq);
-			free (maxFreq);
-			free (okLoc);
-			free (alleList);
-			if (mTemporal == 1) free (freqList);
-			printf ("Out of memory for sample list!\n");
-			return -1;
-		};
-		if ((fishTail = (FISHPTR*) malloc(sizeof(FISHPTR)*nloci)) == NULL) {
-//	if ((fishTail = (FISHPTR*) calloc(nloci, sizeof(FISHPTR))) == NULL) {	//8
-			free (sampData);
-			free (missptr);
-			free (nMobil);
-			free (minFreq);
-			free (maxFreq);
-			free (okLoc);
-			free (alleList);
-			if (mTemporal == 1) free (freqList);
-			free (fishHead);
-			printf ("Out of memory for sample list!\n");
-			return -1;
-		};
-	};
-
 //---------------------------------------------------------------
 // lenBlock = LEN_BLOCK is small, so those are not likely to fail
 	popID = (char*) malloc(sizeof(char)*lenBlock);
 	newID = (char*) malloc(sizeof(char)*lenBlock);
 	*popID = '\0';
-// nCrit is small, those are not likely to fail:
-	wExpR2 = (float*) malloc(sizeof(float)*nCrit);
-	estNe = (float*) malloc(sizeof(float)*nCrit);
-	wHarmonic = (float*) malloc(sizeof(float)*nCrit);
-	rB2WAve = (float*) malloc(sizeof(float)*nCrit);
-	r2Drift = (float*) malloc(sizeof(float)*nCrit);
-	double *nIndSum = (double*) malloc(sizeof(double)*nCrit);
-	jackOK = (char*) malloc(sizeof(char)*nCrit);
-	for (n=0; n<nCrit; *(jackOK+n)=1, n++);
-// for het excess method
-	hSamp = (float*) malloc(sizeof(float)*nCrit);
-	estHetN = (float*) malloc(sizeof(float)*nCrit);
-	hetD = (float*) malloc(sizeof(float)*nCrit);
-	loHetNe = (float*) malloc(sizeof(float)*nCrit);
-	hiHetNe = (float*) malloc(sizeof(float)*nCrit);
-//	jloHetNe = (float*) malloc(sizeof(float)*nCrit);
-//	jhiHetNe = (float*) malloc(sizeof(float)*nCrit);
-	indAlleH = (long*) malloc(sizeof(long)*nCrit);
-// for Temporal method:
-	nTotAlle = (long*) malloc(sizeof(long)*nCrit);
-	nIndAlle = (long*) malloc(sizeof(long)*nCrit);
-	NeTempk = (float*) malloc(sizeof(float)*nCrit);
-	NeTempc = (float*) malloc(sizeof(float)*nCrit);
-	NeTemps = (float*) malloc(sizeof(float)*nCrit);
-
-	loNek = (float*) malloc(sizeof(float)*nCrit);
-	hiNek = (float*) malloc(sizeof(float)*nCrit);
-	loNec = (float*) malloc(sizeof(float)*nCrit);
-	hiNec = (float*) malloc(sizeof(float)*nCrit);
-	loNes = (float*) malloc(sizeof(float)*nCrit);
-	hiNes = (float*) malloc(sizeof(float)*nCrit);
-
-	jloNek = (float*) malloc(sizeof(float)*nCrit);
-	jhiNek = (float*) malloc(sizeof(float)*nCrit);
-	jloNec = (float*) malloc(sizeof(float)*nCrit);
-	jhiNec = (float*) malloc(sizeof(float)*nCrit);
-	jloNes = (float*) malloc(sizeof(float)*nCrit);
-	jhiNes = (float*) malloc(sizeof(float)*nCrit);
-
-	Hkmean = (float*) malloc(sizeof(float)*nCrit);
-	Hcmean = (float*) malloc(sizeof(float)*nCrit);
-	Hsmean = (float*) malloc(sizeof(float)*nCrit);
-	fkmean = (float*) malloc(sizeof(float)*nCrit);
-	fcmean = (float*) malloc(sizeof(float)*nCrit);
-	fsmean = (float*) malloc(sizeof(float)*nCrit);
-	fkprimeMean = (float*) malloc(sizeof(float)*nCrit);
-	fcprimeMean = (float*) malloc(sizeof(float)*nCrit);
-	fsprimeAll = (float*) malloc(sizeof(float)*nCrit);
-// for Jacknife and Parametric confidence intervals
-	confJacklow = (float*) malloc(sizeof(float)*nCrit);
-	confJackhi = (float*) malloc(sizeof(float)*nCrit);
-	confParalow = (float*) malloc(sizeof(float)*nCrit);
-	confParahi = (float*) malloc(sizeof(float)*nCrit);
-// add in Aug 2016 for storing degree of freedom in Jackknife
-	long *Jdegree = (long*) malloc(sizeof(long)*nCrit);
-	for (n=0; n<nCrit; *(confJacklow+n)=*(confParalow+n)=-(float)infinite,
-					*(confJackhi+n)=*(confParahi+n)=(float)infinite, n++);
+	*newID = '\0';
+// Oct 2026: arrays for LD, Het. excess and Coancestry methods are in POPEST
+// records, allocated by MakePopEst.
 // Jan 2017, to deal with spec Pcrit (rejecting singleton alleles)
 // This part is added so that we know if this spec Pcrit exists and
 // then can print explanation for the symbol used to identify this
@@ -13632,6 +17903,60 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 			break;
 		}
 	}
+	popSet.inpName = inpName;
+	popSet.outFolder = outFolder;
+	popSet.outFile = outFile;
+	popSet.locList = locList;
+	popSet.output = output;
+	popSet.shOutputLD = shOutputLD;
+	popSet.shOutputHet = shOutputHet;
+	popSet.shOutputCoan = shOutputCoan;
+	popSet.outLoc = outLoc;
+	popSet.outLocName = outLocName;
+	popSet.outBurr = &outBurr;
+	popSet.outBurrName = outBurrName;
+	popSet.popBurr2 = &popBurr2;
+	popSet.topBCrit = topBCrit;
+	popSet.popStart = popStart;
+	popSet.nloci = nloci;
+	popSet.lenM = lenM;
+	popSet.nCrit = nCrit;
+	popSet.critVal = critVal;
+	popSet.param = param;
+	popSet.jacknife = jacknife;
+	popSet.mating = mating;
+	popSet.locUse = locUse;
+	popSet.infinite = infinite;
+	popSet.mLD = mLD;
+	popSet.mHet = mHet;
+	popSet.mNomura = mNomura;
+	popSet.icount = icount;
+	popSet.sepBurOut = sepBurOut;
+	popSet.moreCol = moreCol;
+	popSet.BurAlePair = BurAlePair;
+	popSet.chromoList = chromoList;
+	popSet.nChromo = nChromo;
+	popSet.chroGrp = chroGrp;
+	popSet.specP = specP;
+	popSet.tabX = tabX;
+	popSet.common = common;
+	popSet.topCrit = topCrit;
+	popSet.nLocUsed = nLocUsed;
+	popSet.bigInd = 0;	// to notify if # ind alle. too big, to adjust output
+	popSet.progOut = progOut;
+	popSet.profOut = profOut;
+	popSet.r2Out = r2Out;
+	popSet.recOut = recOut;
+	popSet.ldOpt = ldOpt;
+	popSet.costSec = popSet.costRAM = popSet.costDisk = 0;
+	popSet.mTemporal = mTemporal;
+	popSet.tempk = tempk;
+	popSet.tempc = tempc;
+	popSet.temps = temps;
+	popSet.freqList = freqList;
+	popSet.timeline = timeline;
+	popSet.tpDone = 0;
+	popSet.errfreq = 0;
 
 // temporarily add for checking:
 //char opened = 0;
@@ -13643,8 +17968,7 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 	nErr = 0;
 	for (; next != -1 && popRead <= popEnd; ) {
 		strcpy (popID, newID);
-		if (format == FSTAT) next = DatPopID (input, newID, lenBlock);
-		else next = GenPopID (input, "pop", newID, lenBlock);
+		next = DataPopID (data, input, format, newID, lenBlock);
 		if (next != 0) {
 			// either go to next pop (next = 1) or end of file (next = -1),
 			// so all data of this pop were read, need to do calculations.
@@ -13654,180 +17978,24 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 			nErr = 0;
 			if (popRead >= popStart) {
 //			if (next == -1 || popRead >= popStart) {
-				printf ("-> Total samples = %d", samp);
-				if (weighsmp > 0) printf (", with data missing");
-				printf ("\n");
+				fprintf (pe->con, "-> Total samples = %d", samp);
+				if (weighsmp > 0) fprintf (pe->con, ", with data missing");
+				fprintf (pe->con, "\n");
 				// add in June 2016 for jSamp
 				jSamp = (jacknife == 1 && samp >= MINSAMP)? 1: 0;
-				PrtPop (output, popRead, popID, samp, mLD, mHet, mNomura, mating,
-						nloci, nMobil, locUse, specP);
-				if (mHet+mLD > 0) PrtFreq (output, mLD, critVal, nCrit, '-', '-');
-				for (p=0; p<nloci; p++) if (*(nMobil+p)==0) *(okLoc+p)=0;
 				moreDat = (popRead >= popLoc1 && popRead <= popLoc2)? 1: 0;
 				moreBurr0 = (popRead >= popBurr1 && popRead <= popBurr2)? 1: 0;
-				moreBurr = moreBurr0;
-				Loc_Freq (alleList, nloci, samp, &hetNeb, nMobil, missptr,
-						locUse, minFreq, maxFreq, outLoc, outLocName,
-						moreDat, popRead, mHet, lenM, locList);
-//	change in Nov 2014/Jan 2015 with sepBurOut
-				if (outBurr != NULL && moreBurr == 1 && sepBurOut == 0)
-					fprintf (outBurr,
-					"\nPOPULATION%6d\t(Sample Size = %d)\n", popRead, samp);
-				for (n=0; n<nCrit; n++) {// for nCrit frequency cut-off values
-				// this loop is for LD and HetExcess methods only
-					if (mHet + mLD == 0) break;
-// print to console if not running multiple files (in all others, icount=0):
-//					if (icount == 0) {
-						if (critVal[n] == 0)
-							printf ("   * For lowest freq: %5s\n", "0+");
-						else
-							printf ("   * For lowest freq: %5.3f\n", critVal[n]);
-//					};
-				// Burrow outputs only to topBCrit highest crit. values
-				// If topBCrit = 0: only critical value 0 (at n = nCrit-1)
-				// If topBCrit > 0: the crit. values taken are:
-				// critVal[0], ..., critVal[m], m = min(topBCrit, nCrit) - 1.
-				// If topBCrit < 0: all
-					moreBurr = 0;
-					if ((topBCrit < 0) || (topBCrit-n > 0) ||
-						((topBCrit == 0) && (n == nCrit-1)))
-						moreBurr = moreBurr0;
-// add in Nov 2014/ Jan 2015:
-					if (moreBurr == 1 && sepBurOut == 1) {
-						outBurr = NULL;
-						*outBurrName = '\0';
-						if (NONAMEBUR != 1)
-							GetPrefix (inpName, outBurrName, LENFILE-20, PATHCHR);
-						GetBurrName(outBurrName, popRead, critVal[n]);
-						*outFile = '\0';
-						outFile = strcat (outFile, outFolder);
-						if ((outBurr=fopen(strcat(outFile, outBurrName),"w"))!=NULL)
-						{
-							if (NOEXPLAIN != 1) {
-								PrtVersion (outBurr);
-								fprintf (outBurr, "Input File: %s\n\n", inpName);
-								fprintf (outBurr,
-									"\nPOPULATION%6d\t(Sample Size = %d)\n",
-										popRead, samp);
-							}
-						} else popBurr2 = 0;	// if cannot open, stop Burrows
-
-					}
-
-					nLocOK = Loci_Eligible (samp, missptr, critVal[n],
-							alleList, nloci, nMobil, minFreq, maxFreq,
-							okLoc, &lastOK, locUse, outLoc, outBurr,
-							moreDat, moreBurr, sepBurOut, moreCol);
-					*(jackOK+n) = (nLocOK <= MAXJACKLD)? 1: 0;
-					if (mLD == 1) {
-						memOut = 0;
-						estNe[n] = LDmethod (critVal[n], alleList, popRead,
-								samp, fishHead, nMobil, missptr, lastOK, okLoc,
-								(nIndSum+n), (rB2WAve+n), (r2Drift+n), (wHarmonic+n),
-								(wExpR2+n), outBurr, outLoc, moreDat, moreBurr,
-								outBurrName, mating, infinite, param, jSamp,
-								(jackOK+n),	// to handle if cannot do jackknife
-								(confJacklow+n), (confJackhi+n), (Jdegree+n),
-								(confParalow+n), (confParahi+n), weighsmp,
-								&memOut, icount, sepBurOut, moreCol, BurAlePair,
-// temporarily add for checking with checkR2:
-//&opened,
-								chromoList, nChromo, chroGrp);
-						if (*(nIndSum+n) >= infinite) bigInd = 1;
-					// add in Nov 2014/ Jan 2015:
-						if (outBurr != NULL && sepBurOut == 1) {
-							printf ( "     Burrows coeffs are in file %s.\n",
-																outBurrName);
-							fclose (outBurr);
-							outBurr = NULL;
-						}
-					};	// end of LD method
-				// Dec 2016: no dropping only singletons in Het method:
-					if (critVal[n] > 0 && critVal[n] <= PCRITX) continue;
-					if (mHet == 1)
-						HetXcess (fishHead, alleList, nloci, samp, nMobil, missptr,
-							okLoc, outLoc, moreDat, critVal[n], (hetD+n),
-							(estHetN+n), (indAlleH+n), (hSamp+n), (loHetNe+n),
-							(hiHetNe+n), param);
-				};	// end of loop for critical values
-// temporarily add for checking:
-//if (opened != 0) opened = popRead+1;
-
-				if (mLD == 1 && memOut == 0) {
-					PrtLDResults (output, nCrit, wHarmonic, nIndSum,
-								rB2WAve, wExpR2, estNe, infinite, bigInd);
-
-// To inform that recalculating Ne when missing data is suppressed:
-					if (RESETNE == 0 && weighsmp > 0) fprintf(output,
-					"(No attempt to adjust r^2 and Ne for missing data.)\n");
-
-//					header = param+jacknife;
-					header = param+jSamp;
-					if (param==1)
-						PrtLDConfid (output, nCrit, confParalow,
-									confParahi, infinite, 0, &header, jackOK, bigInd);
-				// if previous call proceeded, header will become false
-//					if (jacknife==1)
-					if (jSamp==1)
-						PrtLDConfid (output, nCrit, confJacklow,
-									confJackhi, infinite, 1, &header, jackOK, bigInd);
-					if (tabX==0) PrtLDxFile (inpName, shOutputLD, samp, wHarmonic,
-							popRead, popStart, popID, critVal, nCrit, nIndSum,
-							rB2WAve, wExpR2, estNe, param, jacknife,
-							infinite, confParalow, confParahi, confJacklow,
-							confJackhi, Jdegree, jackOK, mating, topCrit, nLocUsed, icount, common);
-					else PrtLDTabFile (inpName, shOutputLD, samp, wHarmonic,
-							popRead, popStart, popID, critVal, nCrit, nIndSum,
-							rB2WAve, wExpR2, estNe, param, jacknife,
-							infinite, confParalow, confParahi, confJacklow,
-							confJackhi, jackOK, mating, topCrit, nLocUsed, icount,
-							common, Jdegree);
-				};	// end of printing LD results
-				// print to main output, Neb from Het Ex. and Coancestry,
-				// From Het Ex method, based on lowest freq. req.
-
-				if (mHet == 1) {
-					PrtHetNe (output, hetD, estHetN, loHetNe, hiHetNe, hSamp,
-								param, nCrit, critVal, indAlleH, infinite);
-					if (tabX==0) PrtHetxFile (inpName, shOutputHet, popRead,
-								popStart, popID, critVal, nCrit, indAlleH, hetD,
-								estHetN, param, infinite, loHetNe, hiHetNe,
-								samp, hSamp, topCrit, nLocUsed, icount, common);
-					else PrtHetTabFile (inpName, shOutputHet, popRead,
-								popStart, popID, critVal, nCrit, indAlleH, hetD,
-								estHetN, param, infinite, loHetNe, hiHetNe,
-								samp, hSamp, topCrit, nLocUsed, icount, common);
-				};
-
-				for (p=0; p<nloci; p++) *(okLoc+p) = *(locUse+p);
-				if (mNomura == 1) {
-					coanNeb = CoanMethod (fishHead, alleList, nMobil,
-								nloci, samp, okLoc, &f1, outLoc, moreDat,
-								&loNbCoan, &hiNbCoan, jacknife, missptr, &hSamCoan);
-					n = (mHet+mLD > 0)? nCrit: 1;
-					m = (mHet+mLD > 0 && critVal[nCrit-1] == 0)? 0: 1;
-					PrtNomuraNe (output, f1, coanNeb, n, m, loNbCoan, hiNbCoan,
-								jacknife, hSamCoan);
-					if (tabX==0) PrtCoanxFile (inpName, shOutputCoan, popRead,
-								popStart, popID, f1, coanNeb, jacknife,
-								infinite, loNbCoan, hiNbCoan, samp, hSamCoan,
-								nLocUsed, icount, common);
-					else PrtCoanTabFile (inpName, shOutputCoan, popRead,
-								popStart, popID, f1, coanNeb, jacknife,
-								infinite, loNbCoan, hiNbCoan, samp, hSamCoan,
-								nLocUsed, icount, common);
-				};
-				n = 26 + 12*nCrit;	// draw a line of asterisks at the end:
-				if (bigInd == 1) n += 2*nCrit;
-				if (mHet+mLD > 0) PrtLines (output, n, '*');
+				pe->popRead = popRead;
+				pe->samp = samp;
+				strcpy (pe->popID, popID);
+				pe->weighsmp = weighsmp;
+				pe->jSamp = jSamp;
+				pe->moreDat = moreDat;
+				pe->moreBurr0 = moreBurr0;
 // show the time after finishing Nomura or LD with big data:
-				if (((mLD > 0 && (nloci > 4000 || samp >= 10000)) ||
+				pe->showTime = (((mLD > 0 && (nloci > 4000 || samp >= 10000)) ||
 					(mNomura > 0 && (nloci*samp >= 10000)))
-					&& (next != -1) && (popRead < popEnd)) {
-					time ( &rawtime );
-					fprintf (output, "\nTime: %s\n", ctime (&rawtime));
-					fflush (output);
-				};
+					&& (next != -1) && (popRead < popEnd))? 1: 0;
 // for temporal method ----------------------------------------------------
 				if (mTemporal == 1) {
 					if (generation == 0) nPoptemp++;
@@ -13882,32 +18050,86 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 					m = (n > POP_TEMP)? n - POP_TEMP: 0;
 					strcpy (popIDtemp [generation], popID+m);
 					*(popSize + generation) = samp;
-					AddFreqWide (freqList, alleList, nloci, samp, missptr,
-								locUse, nGeneration, generation, &errfreq, weighsmp);
+					popSet.generation = generation;
+					popSet.nGeneration = nGeneration;
+					popSet.census = census;
+					popSet.tpDone = ((generation == nGeneration-1) || (next == -1)
+							|| (popRead == popEnd))? 1: 0;
+				};
+// Oct 2026: populations wait until nSlot of them are read, then they are
+// estimated at the same time and printed in order (PopWindow), except
+// those having Burrows outputs, run here after those waiting; console
+// text of this one kept so far is then printed.
+				if (nSlot > 1 && moreBurr0 == 0) {
+					pe->locTmp = (outLoc != NULL)? tmpfile(): NULL;
+					nWait++;
+					if (nWait == nSlot) {
+						PopWindow (popSlot, nWait, &popSet);
+						nWait = 0;
+					};
+					queued = 1;
+				} else {
+					if (nWait > 0) {	// those before are done first
+						PopWindow (popSlot, nWait, &popSet);
+						*(popSlot+nWait) = *popSlot;
+						*popSlot = pe;
+						nWait = 0;
+					};
+					if (pe->con != stdout) AppendTmp (stdout, pe->con);
+					pe->con = stdout;
+					PopCompute (pe, &popSet, outLoc);
+					PhaseBegin (pe->prof, PH_PRINT);
+					if (pe->prof != NULL) pos = OutputPos (&popSet);
+					PopPrint (pe, &popSet);
+					if (pe->prof != NULL)
+						(pe->prof+PH_PRINT)->bytes += OutputPos (&popSet) - pos;
+					PhaseEnd (pe->prof, PH_PRINT);
+					PopReport (pe, &popSet);
+				};
+// for temporal method: print pairs of generations ----------------------
+				if (mTemporal == 1) {
+					errfreq = popSet.errfreq;
 					if (errfreq != 0) return errfreq;
-					if ((generation == nGeneration-1) || (next == -1)
-							|| (popRead == popEnd))
+					if (popSet.tpDone == 1)
 					{
 						FreqAdjnPrt (outLoc, moreDat, freqList, nloci,
 										generation+1, locUse);
-						for (g1=0; g1<generation; g1++) {
-							for (g2=g1+1; g2<generation+1; g2++) {
+// Oct 2026: pairs of generations were estimated by TempCompute, each into
+// its own result record, printed here in the same order as before.
+						tempRes = popSet.tempRes;
+						for (g1=0, iPair=0; g1<generation; g1++) {
+							for (g2=g1+1; g2<generation+1; g2++, iPair++) {
+								res = *(tempRes+iPair);
+								nTotAlle = res->nTotAlle;
+								nIndAlle = res->nIndAlle;
+								Hkmean = res->Hkmean;
+								Hcmean = res->Hcmean;
+								Hsmean = res->Hsmean;
+								fkmean = res->fkmean;
+								fcmean = res->fcmean;
+								fsmean = res->fsmean;
+								fkprimeMean = res->fkprimeMean;
+								fcprimeMean = res->fcprimeMean;
+								fsprimeAll = res->fsprimeAll;
+								NeTempk = res->NeTempk;
+								NeTempc = res->NeTempc;
+								NeTemps = res->NeTemps;
+								loNek = res->loNek;
+								hiNek = res->hiNek;
+								loNec = res->loNec;
+								hiNec = res->hiNec;
+								loNes = res->loNes;
+								hiNes = res->hiNes;
+								jloNek = res->jloNek;
+								jhiNek = res->jhiNek;
+								jloNec = res->jloNec;
+								jhiNec = res->jhiNec;
+								jloNes = res->jloNes;
+								jhiNes = res->jhiNes;
 								(*totPairTmp)++;
 								nPairTmp++;
-//								if (g2 == 1 && icount == 0)
-//									printf ("\nTemporal Method ...\n");
-								TemporalNeEst (outLoc, moreDat, freqList, nloci,
-										locUse, g1, g2, nCrit, critVal,
-										nTotAlle, nIndAlle,
-										Hkmean, Hcmean, Hsmean,
-										fkmean, fcmean, fsmean,
-										fkprimeMean, fcprimeMean, fsprimeAll,
-										NeTempk, NeTempc, NeTemps,
-										loNek, hiNek, loNec, hiNec,
-										loNes, hiNes, jloNek, jhiNek, jloNec,
-										jhiNec, jloNes, jhiNes, param,
-										jacknife, timeline, census,
-										tempk, tempc, temps, infinite, weighsmp);
+								AppendTmp (outLoc, res->outTmp);
+								res->outTmp = NULL;
 								PrtTemporal (output, nCrit, critVal,
 										g1, g2, generation+1, timeline,
 										nTotAlle, nIndAlle, Hkmean, Hcmean,
@@ -13918,38 +18140,65 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 										jloNek, jloNec, jloNes, jhiNek, jhiNec,
 										jhiNes, param, jacknife, infinite,
 										tempk, tempc, temps, popIDtemp, popSize, census);
-								if (tabX==0) PrtTempxFile (shOutputTemp, popRead, popStart,	//3
-										newSet, lastSet, critVal, nCrit, g1, g2,//6
-										generation+1, timeline, nIndAlle,	//3
-										Hkmean, Hcmean, Hsmean,		//3
-										fkmean, fcmean, fsmean,		//3
-										fkprimeMean, fcprimeMean, fsprimeAll,//3
-										NeTempk, NeTempc, NeTemps,	//3
-										loNek, loNec, loNes,		//3
-										hiNek, hiNec, hiNes,		//3, 30 so far
-										jloNek, jloNec, jloNes,		//3
-										jhiNek, jhiNec, jhiNes,		//3
-										param, jacknife,			//2
-										infinite, tempkx, tempcx, tempsx,	//3
-										popIDtemp, topCrit, nPlan, census,	//3, 44 so far
-										inpName, nLocUsed, icount, *totPairTmp, common);
-								else PrtTpTabFile (shOutputTemp, popRead, popStart,	//3
-										newSet, lastSet, critVal, nCrit, g1, g2,//6
-										generation+1, nGeneration, timeline, nIndAlle,	//4
-										Hkmean, Hcmean, Hsmean,		//3
-										fkmean, fcmean, fsmean,		//3
-										fkprimeMean, fcprimeMean, fsprimeAll,//3
-										NeTempk, NeTempc, NeTemps,	//3
-										loNek, loNec, loNes,		//3
-										hiNek, hiNec, hiNes,		//3, 30 so far
-										jloNek, jloNec, jloNes,		//3
-										jhiNek, jhiNec, jhiNes,		//3
-										param, jacknife,			//2
-										infinite, tempkx, tempcx, tempsx,	//3
-										popIDtemp, topCrit, nPlan, census,	//3, 44 so far
-										inpName, nLocUsed, icount, *totPairTmp, common, &lenTpPop);
+								if (recOut != NULL)
+									TempRecords (recOut, icount, popRead,
+										popIDtemp[g1], popIDtemp[g2], nCrit,
+										critVal, res, tempk, tempc, temps,
+										param, jacknife);
+								// Oct 2026: when this input is one of files run by RunBatch, with output
+								// common to all, the header at its first sample pair is needed only if
+								// earlier files have no sample pairs. The row is printed again alone to
+								// a scratch file, to locate the header: tpHead[0] to tpHead[1].
+								tpOut = shOutputTemp;
+								smPair = *totPairTmp;
+								tpScr = NULL;
+								if (tpHead != NULL && smPair == 1 && shOutputTemp != NULL) {
+									tpHead[0] = ftell (shOutputTemp);
+									tpScr = tmpfile ();
+								};
+								for ( ; ; ) {
+									if (tabX==0) PrtTempxFile (tpOut, popRead, popStart,	//3
+											newSet, lastSet, critVal, nCrit, g1, g2,//6
+											generation+1, timeline, nIndAlle,	//3
+											Hkmean, Hcmean, Hsmean,		//3
+											fkmean, fcmean, fsmean,		//3
+											fkprimeMean, fcprimeMean, fsprimeAll,//3
+											NeTempk, NeTempc, NeTemps,	//3
+											loNek, loNec, loNes,		//3
+											hiNek, hiNec, hiNes,		//3, 30 so far
+											jloNek, jloNec, jloNes,		//3
+											jhiNek, jhiNec, jhiNes,		//3
+											param, jacknife,			//2
+											infinite, tempkx, tempcx, tempsx,	//3
+											popIDtemp, topCrit, nPlan, census,	//3, 44 so far
+											inpName, nLocUsed, icount, smPair, common);
+									else PrtTpTabFile (tpOut, popRead, popStart,	//3
+											newSet, lastSet, critVal, nCrit, g1, g2,//6
+											generation+1, nGeneration, timeline, nIndAlle,	//4
+											Hkmean, Hcmean, Hsmean,		//3
+											fkmean, fcmean, fsmean,		//3
+											fkprimeMean, fcprimeMean, fsprimeAll,//3
+											NeTempk, NeTempc, NeTemps,	//3
+											loNek, loNec, loNes,		//3
+											hiNek, hiNec, hiNes,		//3, 30 so far
+											jloNek, jloNec, jloNes,		//3
+											jhiNek, jhiNec, jhiNes,		//3
+											param, jacknife,			//2
+											infinite, tempkx, tempcx, tempsx,	//3
+											popIDtemp, topCrit, nPlan, census,	//3, 44 so far
+											inpName, nLocUsed, icount, smPair, common, &lenTpPop);
+									if (tpScr == NULL || tpOut == tpScr) break;
+									tpOut = tpScr;
+									smPair = 2;
+								};
+								if (tpScr != NULL) {
+									tpHead[1] = ftell (shOutputTemp) - ftell (tpScr);
+									fclose (tpScr);
+								};
+								RemoveTempRes (res);
 							};
 						};
+						free (tempRes);
 						if ((next==-1 || popRead==popEnd) && (common == 0))
 							PrtTempPop (shOutputTemp, generation, nGeneration,
 										nPoptemp, popRun+1, nPairTmp, timeline);
@@ -13965,8 +18214,10 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 					printf ("Burrows coefficients for LD method are written to file %s.\n",
 							outBurrName);
 
-				RemoveAlle (alleList, nloci);
-				if (makeFish > 0) RemoveFish (fishHead, nloci);
+				if (queued == 0) {
+					RemoveAlle (alleList, nloci);
+					if (makeFish > 0) RemoveFish (fishHead, nloci);
+				};
 				popRun++;	// actual number of pops run
 				(*totPop)++;
 // comment this out if fishHead is not reallocated after each population
@@ -13989,6 +18240,18 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 				return -1;
 			};
 //*/
+			if (queued == 1) {	// arrays for next population
+				pe = *(popSlot+nWait);
+				alleList = pe->alleList;
+				fishHead = pe->fishHead;
+				fishTail = pe->fishTail;
+				nMobil = pe->nMobil;
+				missptr = pe->missptr;
+				minFreq = pe->minFreq;
+				maxFreq = pe->maxFreq;
+				okLoc = pe->okLoc;
+				queued = 0;
+			};
 			// reinitialize: next = 1, so it's new pop
 			for (isize=0; isize<size; isize++) *(missptr+isize)=0;
 			for (p=0; p<nloci; p++){
@@ -14008,8 +18271,12 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 			ind = 0;
 			popRead++;	// this is then the pop number of the pop just done
 			if (popRead > popEnd) break;	// just passed pop "popEnd"
+		// Oct 2026: console text of a population that may wait (see
+		// PopWindow) is kept until it is estimated
+			if (popRead >= popStart && nSlot > 1
+				&& (pe->con = tmpfile ()) == NULL) pe->con = stdout;
 			if (popRead >= popStart)
-				printf ("\nPopulation%6d [%s]\n", popRead, newID);
+				fprintf (pe->con, "\nPopulation%6d [%s]\n", popRead, newID);
 		};
 		if (next == -1) break;	// end of file, done.
 		// now, next = 0 or 1. If = 1, we start the first sample.
@@ -14017,8 +18284,12 @@ int RunPop0 (int icount, char *inpName, FILE *input, char append, FILE *output,
 		// use ind for counting number of samples read, samp is used
 		// for counting the number of samples used (since some samples
 		// read later will be discarded if there is option limiting #sample)
-		err = GetSample (input, nloci, sampData, lenM, &ind, lenBlock,
-						&nSampErr, &noGen, genErr, &firstErr, locUse);
+		PhaseBegin (pe->prof, PH_READ);
+		if (pe->prof != NULL) pos = ftell (input);
+		err = DataSample (data, input, nloci, sampData, lenM, &ind, lenBlock,
+						&nSampErr, &noGen, genErr, &firstErr, locUse, pe->con);
+		if (pe->prof != NULL) (pe->prof+PH_READ)->bytes += ftell (input) - pos;
+		PhaseEnd (pe->prof, PH_READ);
 		samp = ind;
 		if (samp > maxSamp) {	// this sample and subsequent ones
 			samp = maxSamp;		// are read but not put in the list,
@@ -14047,6 +18318,15 @@ for (p=0; p<nloci; p++){
 		// open missing data file when the first error occurs.
 		if (*missFileName !='\0' && nSampErr == 1 && missDat == NULL)
 			missDat = PrtMisHead (missFileName, inpName, popRead, newID);
+		// Oct 2026: populations waiting are printed before an error message
+		// from PrtError (from err and noGen, as in PrtError, PrtMisDat)
+		if (nWait > 0 && (err == -1 || (err > 0 && noGen > 0
+			&& err/nloci != 1))) {
+			PopWindow (popSlot, nWait, &popSet);
+			*(popSlot+nWait) = *popSlot;
+			*popSlot = pe;
+			nWait = 0;
+		};
 		// quit when sample contains a genotype too wide or has non-digit:
 		if ((errCode = PrtError (output, missDat, nloci, nSampErr, popRead,
 				samp, popID, err, noGen, genErr, firstErr)) > 0) break;
@@ -14092,89 +18372,39 @@ for (p=0; p<nloci; p++){
 
 		};
 */
+		PhaseBegin (pe->prof, PH_FREQ);
 		if ((AddAlleWide (alleList, nloci, sampData, nMobil, missptr,
 			maxMobilVal, popRead, samp) != 0) ||
 			AddFishWide(fishHead, fishTail, nloci, sampData, locUse, makeFish) == 0)
 		{
+			PhaseEnd (pe->prof, PH_FREQ);
+			if (nWait > 0) PopWindow (popSlot, nWait, &popSet);
+			nWait = 0;
 			fprintf (output, "\n\nOut of memory at population %s, sample %d.\n",
 					popID, samp);
 			errCode = -1;
 			fflush (output);
 			break;
 		};
+		PhaseEnd (pe->prof, PH_FREQ);
 	};
+	if (nWait > 0) PopWindow (popSlot, nWait, &popSet);
+	if (pe->con != stdout) AppendTmp (stdout, pe->con);	// one not estimated
+	pe->con = stdout;
 	if (popRun == 0) {
 		fprintf (output, "No population is run!\n");
 		printf ("No population is run!\n");
-	};
+	} else if (ldOpt != NULL && ldOpt->dryRun == 1)
+		printf ("\nDry run, all populations: %.1f s, peak RAM %.1f MB,"
+				" temporary disk %.1f MB\n", popSet.costSec, popSet.costRAM,
+				popSet.costDisk);
 // variables in all methods:
-	if (makeFish > 0) {
-		free (fishHead);	//1
-		free (fishTail);	//2
-	};
-	free (alleList);	//3
-	free (sampData);	//4
-	free (missptr);		//5
-	free (nMobil);		//6
-	free (minFreq);		//7
-	free (maxFreq);		//8
-	free (okLoc);		//9
-	free (popID);		//10
-	free (newID);		//11
-	free (wExpR2);		//12
-// for LD method
-	free (estNe);		//13
-	free (wHarmonic);	//14
-	free (rB2WAve);	//15
-	free (r2Drift);	//15
-	free (nIndSum);		//16
-	free (jackOK);		//17
-
-	free (confJacklow);	//18
-	free (confJackhi);	//19
-	free (confParalow);	//20
-	free (confParahi);	//21
-	free (Jdegree);
-	if (mTemporal == 1) free (freqList);	//22
-// for HetExcess method
-	free (hSamp);		//23
-	free (estHetN);		//23
-	free (hetD);		//24
-	free (loHetNe);		//25
-	free (hiHetNe);		//26
-//	free (jloHetNe);	//27
-//	free (jhiHetNe);	//28
-	free (indAlleH);	//29
-// for temporal method
-	free (nTotAlle);	//30
-	free (nIndAlle);	//31
-	free (NeTempk);		//32
-	free (NeTempc);		//33
-	free (NeTemps);		//34
-
-	free (loNek);		//35
-	free (hiNek);		//36
-	free (loNec);		//37
-	free (hiNec);		//38
-	free (loNes);		//39
-	free (hiNes);		//40
-	free (jloNek);		//41
-	free (jhiNek);		//42
-	free (jloNec);		//43
-	free (jhiNec);		//44
-	free (jloNes);		//45
-	free (jhiNes);		//46
-
-	free (Hkmean);		//47
-	free (Hcmean);		//48
-	free (Hsmean);		//49
-	free (fkmean);		//50
-	free (fcmean);		//51
-	free (fsmean);		//52
-	free (fkprimeMean);		//53
-	free (fcprimeMean);		//54
-	free (fsprimeAll);		//55
-
+	for (n=0; n<nSlot; n++) RemovePopEst (*(popSlot+n));
+	free (popSlot);
+	free (sampData);
+	free (popID);
+	free (newID);
+	if (mTemporal == 1) free (freqList);
 	if (mTemporal == 1) {
 		free (popSize);
 		for (n=0; n<MAXGENERATION; n++)
@@ -14192,11 +18422,18 @@ for (p=0; p<nloci; p++){
 
 //------------------------------------------------------------------
 
-void PrintEndTime (FILE *output, time_t rawtime) {
+// Oct 2026: PrtEndTime prints, PrintEndTime also closes output
+void PrtEndTime (FILE *output, time_t rawtime) {
 	if (output == NULL) return;
+	#pragma omp critical (ctime)
 	fprintf (output, "\nEnding time: %s", ctime (&rawtime));
 	PrtLines (output, 37, '-');
 	fprintf (output, "\n");
+};
+
+void PrintEndTime (FILE *output, time_t rawtime) {
+	if (output == NULL) return;
+	PrtEndTime (output, rawtime);
 	fclose (output);
 	output = NULL;
 };
@@ -14370,12 +18607,20 @@ int RunPop (int icount, char *inpName, FILE *input, char append,  FILE *output,
 //			int nGeneration, float timeline[], FILE *info)
 			// add parameters in Apr 2015:
 			char sepBurOut, char moreCol, char BurAlePair,
-			struct chromosome *chromoList, int nChromo, int chroGrp, int unknown)
+			struct chromosome *chromoList, int nChromo, int chroGrp, int unknown,
+// Oct 2026: job is NULL, except when this input is run by RunBatch
+			BATCHJOB job,
+// Oct 2026: progress file of LD method, see LDProgress, and file for
+// timing of phases, see PopReport, store of r^2, see R2Add, records of
+// results, see PrtRecord, and options of LD method, see LDSampPairs
+			FILE *progOut, FILE *profOut, R2STORE r2Out, RECOUT recOut,
+			LDOPT ldOpt)
 {
 	int err;
 	time_t rawtime;
 	char *prefix;
 	int i, j, k, m;
+	DATAREAD data;	// Oct 2026: for the server, see DataOpen
 	if (output == NULL || input == NULL) return 0;
 	PrtHeader (output, append, inpName, icount, 1);
 // Add Apr 2015:
@@ -14425,6 +18670,8 @@ int RunPop (int icount, char *inpName, FILE *input, char append,  FILE *output,
 		};
 	};
 
+	data = DataOpen ((ldOpt != NULL)? ldOpt->data: NULL, inpName, input,
+					nloci, lenM, format, locUse);
 	err = RunPop0 (icount, inpName, input, append, output, outFolder, locList,
 				outLoc, outLocName, outBurr, outBurrName,
 				shOutputLD, shOutputHet, shOutputCoan, shOutputTemp,
@@ -14438,13 +18685,25 @@ int RunPop (int icount, char *inpName, FILE *input, char append,  FILE *output,
 //				mTemporal, nGeneration, timeline, info);
 	// add parameters in Apr 2015:
 				sepBurOut, moreCol, BurAlePair,
-				chromoList, nChromo, chroGrp);
+				chromoList, nChromo, chroGrp,
+				(job != NULL && common != 0)? job->tpHead: NULL, progOut,
+				profOut, r2Out, recOut, ldOpt, data);
+	DataClose (data);
 	fclose (input);
 	if (outLoc != NULL) fclose (outLoc);
 	if (outBurr != NULL) fclose (outBurr);
 	time ( &rawtime );
 	// when there are more to write to output files, then return, not close:
 	if (common != 0) return err;
+	// outputs are temporary files of RunBatch, to be copied, not closed
+	if (job != NULL) {
+		PrtEndTime (output, rawtime);
+		PrtEndTime (shOutputLD, rawtime);
+		PrtEndTime (shOutputHet, rawtime);
+		PrtEndTime (shOutputCoan, rawtime);
+		PrtEndTime (shOutputTemp, rawtime);
+		return err;
+	};
 	PrintEndTime (output, rawtime);
 	PrintEndTime (shOutputLD, rawtime);
 	PrintEndTime (shOutputHet, rawtime);
@@ -14489,7 +18748,213 @@ void SetDefault (int *maxSamp, char *param, char *nonparam, char *mLD,
 }
 
 //------------------------------------------------------------------
-int RunMultiFiles (char *mFileName, char mOpt)
+//------------------------------------------------------------------
+// Oct 2026: Running input files of RunMultiFiles, RunMultiCommon
+// concurrently, when "j:n" (n > 1) is given at the command line.
+// Those functions read the list of input files as before, but each input
+// is put in a BATCHJOB instead of being run. RunBatch then runs n inputs
+// at a time; outputs of an input go to temporary files, which are copied
+// to the output files in the order of the list, so the output files are
+// the same as those when inputs are run one after another (except times).
+// Console messages from inputs run at the same time are mixed.
+//------------------------------------------------------------------
+
+BATCHJOB AddJob (BATCHJOB *head, BATCHJOB *tail)
+// Add a new job at the end of list, return NULL if out of memory.
+{
+	BATCHJOB job;
+	if ((job = (BATCHJOB) calloc (1, sizeof(struct batchjob))) == NULL)
+		return NULL;
+	if (*head == NULL) *head = job;
+	else (*tail)->next = job;
+	*tail = job;
+	return job;
+}
+
+//------------------------------------------------------------------
+
+void SetJob (BATCHJOB job, int icount, char *inpName, FILE *input,
+			int popStart, int popEnd, int maxSamp, int nloci, int lenM,
+			int maxMobilVal, int nCrit, float critVal[], char format,
+			char param, char nonparam, char *locUse, char mating,
+			char mLD, char mHet, char mNomura, char mTemporal,
+			int nGeneration, float timeline[], int tempClue, int tempxClue,
+			char byRange, int topCrit, int nPlan, int census, char tabX)
+// Record what RunPop needs for this input. Input is closed, to be opened
+// again at RunJob; locUse now belongs to job.
+{
+	int k;
+	job->icount = icount;
+	*(job->inpName) = '\0';
+	strcat (job->inpName, inpName);
+	job->inpPos = ftell (input);
+	fclose (input);
+	job->popStart = popStart;
+	job->popEnd = popEnd;
+	job->maxSamp = maxSamp;
+	job->nloci = nloci;
+	job->lenM = lenM;
+	job->maxMobilVal = maxMobilVal;
+	job->nCrit = nCrit;
+	for (k = 0; k < MAXCRIT; k++) job->critVal[k] = critVal[k];
+	job->format = format;
+	job->param = param;
+	job->nonparam = nonparam;
+	job->locUse = locUse;
+	job->mating = mating;
+	job->mLD = mLD;
+	job->mHet = mHet;
+	job->mNomura = mNomura;
+	job->mTemporal = mTemporal;
+	job->nGeneration = nGeneration;
+	for (k = 0; k <= MAXGENERATION; k++) job->timeline[k] = timeline[k];
+	job->tempClue = tempClue;
+	job->tempxClue = tempxClue;
+	job->byRange = byRange;
+	job->topCrit = topCrit;
+	job->nPlan = nPlan;
+	job->census = census;
+	job->tabX = tabX;
+}
+
+//------------------------------------------------------------------
+
+void RunJob (BATCHJOB job, char common, FILE **shared, FILE *progOut,
+			FILE *profOut, R2STORE r2Out, RECOUT recOut,
+			LDOPT ldOpt)
+// Run RunPop on the input of job, outputs to temporary files. If common
+// = 1, outputs are those in array shared, otherwise those named in job.
+{
+	int k;
+	FILE *input;
+	job->err = -1;
+	for (k = 0; k < 5; k++) {
+		job->outTmp[k] = NULL;
+		if ((common == 0 && *(job->outName[k]) != '\0')
+			|| (common != 0 && *(shared+k) != NULL))
+			job->outTmp[k] = tmpfile ();
+	};
+	if (job->outTmp[0] == NULL) {
+		printf ("\nCannot create temporary output for input %d\n",
+				job->icount);
+		return;
+	};
+	if ((input = fopen (job->inpName, "r")) == NULL) {
+		printf ("\nERROR:\n");
+		perror (job->inpName);
+		return;
+	};
+	fseek (input, job->inpPos, SEEK_SET);
+	job->err = RunPop (job->icount, job->inpName, input, job->append,
+				job->outTmp[0],
+				NULL,	// for outFolder, not needed since no Burrows file
+				NULL,	// locList
+				NULL, "\0", NULL, "\0",	// no outLoc, outBurr files
+				job->outTmp[1], job->outTmp[2], job->outTmp[3],
+				job->outTmp[4], 0, 0, 0, 0, 0, job->popStart, job->popEnd,
+				job->maxSamp, job->nloci, job->lenM, job->maxMobilVal,
+				job->nCrit, job->critVal, job->format, job->param,
+				job->nonparam, job->locUse, job->mating,
+				"\0",	// empty for missFileName: no missing data file created
+				INFINITE, LEN_BLOCK, job->mLD, job->mHet, job->mNomura,
+				job->mTemporal, job->nGeneration, job->timeline, NULL, 0,
+				0, job->tempClue, job->tempxClue, job->byRange,
+				job->topCrit, job->nPlan, job->census, &(job->totPop),
+				&(job->totPairTmp), common, job->tabX,
+				0, 0, 0, NULL, 0, 0, 0, job, progOut, profOut, r2Out, recOut,
+				ldOpt);
+}
+
+//------------------------------------------------------------------
+
+void MergeJob (BATCHJOB job, char common, FILE **shared,
+				int *totPop, int *totPairTmp)
+// Copy outputs of job to output files. This is called in the order of
+// the list, after the job is run (or not run, if job->icount = 0).
+// When not common, output files are opened here as RunMultiFiles did, so
+// output files of inputs not run are still created (or emptied).
+// *totPop, *totPairTmp are those of inputs before this job.
+{
+	int k;
+	FILE *output;
+	for (k = 0; k < 5; k++) {
+		if (common != 0) output = *(shared+k);
+		else {
+			if (*(job->outName[k]) == '\0') continue;
+			if (job->append == 1) output = fopen (job->outName[k], "a");
+			else output = fopen (job->outName[k], "w");
+			if (output == NULL)
+				printf ("\nCannot open file %s for output\n", job->outName[k]);
+		};
+	// header of common temporal output only at the first sample pair:
+		if (k == 4 && common != 0 && *totPairTmp > 0)
+			AppendTmpCut (output, job->outTmp[k], job->tpHead[0],
+						job->tpHead[1]);
+		else AppendTmp (output, job->outTmp[k]);
+		job->outTmp[k] = NULL;
+		if (common == 0 && output != NULL) fclose (output);
+	};
+	if (job->icount > 0 && job->err == 0)
+		printf("Finish running input %d.\n", job->icount);
+	*totPop += job->totPop;
+	*totPairTmp += job->totPairTmp;
+}
+
+//------------------------------------------------------------------
+
+void RunBatch (BATCHJOB jobList, int nJob, char common, FILE **shared,
+				int *totPop, int *totPairTmp, FILE *progOut, FILE *profOut,
+				R2STORE r2Out, RECOUT recOut,
+				LDOPT ldOpt)
+// Run jobs in jobList, nJob at a time (all threads if nJob <= 0), then
+// free the list. Outputs of a job are copied to output files when jobs
+// before it are done: a job done ahead of its turn is only marked done,
+// its outputs are copied by the worker that finishes the job before it,
+// so no worker waits for the jobs before its own to start the next one.
+{
+	int i, nList, next = 0;
+	char *done;
+	BATCHJOB job, *jobs;
+	for (nList = 0, job = jobList; job != NULL; job = job->next) nList++;
+	jobs = (BATCHJOB*) malloc (sizeof(BATCHJOB)*(nList+1));
+	done = (char*) calloc (nList+1, sizeof(char));
+	if (jobs != NULL && done != NULL) {
+		for (i = 0, job = jobList; job != NULL; job = job->next, i++)
+			*(jobs+i) = job;
+#ifdef _OPENMP
+		if (nJob <= 0) nJob = omp_get_max_threads();
+#endif
+		if (nJob <= 0) nJob = 1;
+		#pragma omp parallel for schedule(dynamic) num_threads(nJob)
+		for (i = 0; i < nList; i++) {
+			if ((*(jobs+i))->icount > 0) RunJob (*(jobs+i), common, shared,
+						progOut, profOut, r2Out, recOut, ldOpt);
+			#pragma omp critical (mergejob)
+			{
+				*(done+i) = 1;
+				for ( ; next < nList && *(done+next) == 1; next++)
+					MergeJob (*(jobs+next), common, shared, totPop,
+							totPairTmp);
+			}
+		};
+	} else printf ("Out of memory for running input files!\n");
+	free (jobs);
+	free (done);
+	while (jobList != NULL) {
+		job = jobList;
+		jobList = job->next;
+		free (job->locUse);
+		free (job);
+	};
+}
+
+
+//------------------------------------------------------------------
+
+
+int RunMultiFiles (char *mFileName, char mOpt, int nJob, FILE *progOut,
+					FILE *profOut, R2STORE r2Out, RECOUT recOut,
+					LDOPT ldOpt)
 // Read file mFileName to run RunPop multiple times, Each run requires
 // 3 lines:
 //	* first line: input file name
@@ -14498,6 +18963,10 @@ int RunMultiFiles (char *mFileName, char mOpt)
 //	* third line: an "Y" for next run, else to end.
 // Return the number of successful runs.
 // If input file name is empty, quit.
+// Oct 2026: if nJob != 1, inputs are run by RunBatch, nJob at a time.
+// Progress of LD method is written to progOut if not NULL, timing of
+// phases to profOut, r^2 at locus pairs to r2Out, records of results to
+// recOut if not NULL. LD method has options ldOpt if not NULL.
 {
 	#define LOCRANGE 100	// max endpoints of locus ranges to be used
 	#define MAXLOCI 1000000		// maximum number of loci to be used
@@ -14545,6 +19014,8 @@ int RunMultiFiles (char *mFileName, char mOpt)
 	char *inpName = (char*) malloc (sizeof(char)*PATHFILE);
 	char *outName = (char*) malloc (sizeof(char)*PATHFILE);
 	char *outNameMore = (char*) malloc (sizeof(char)*PATHFILE);
+	char batch = (nJob != 1)? 1: 0;
+	BATCHJOB jobList = NULL, jobLast = NULL, job = NULL;
 	mating = 0;
 //	locDrop = (char*) malloc(sizeof(char)*100);
 	if ((mInpFile = fopen (mFileName, "r")) == NULL) {
@@ -14754,14 +19225,22 @@ int RunMultiFiles (char *mFileName, char mOpt)
 	// append if same output name: CASE SENSITIVE (since Unix cares!)
 // changed Feb 15 2013:
 		if (append == 0) append = (strcmp(outName, outNameMore) == 0)? 1: 0;
-		if (append == 1) {
+		job = NULL;
+		if (batch == 1) {
+		// output files are opened when outputs of this input are copied
+			output = NULL;
+			if ((job = AddJob (&jobList, &jobLast)) != NULL) {
+				strcat (job->outName[0], outName);
+				job->append = append;
+			};
+		} else if (append == 1) {
 			output = fopen (outName, "a");	// append if the same output
 		} else {
 			output = fopen (outName, "w");
 		}
 		*outNameMore = '\0';
 		strcat (outNameMore, outName);
-		if (output == NULL) {
+		if (output == NULL && job == NULL) {
 			printf ("\nCannot open file %s for output\n", outName);
 			continue;
 		}
@@ -14783,7 +19262,7 @@ int RunMultiFiles (char *mFileName, char mOpt)
 		if (format == GENPOP) {	// GENEPOP format
 			if ((nloci = GetnLoci (input, LEN_BLOCK, &lenM)) <= 0) {
 				fclose (input);
-				fclose (output);
+				if (output != NULL) fclose (output);
 				printf ("Error in input file [%s]\n", inpName);
 				if (tolower(fgetc (mInpFile)) != 'y') break;
 				for (; (c=fgetc(mInpFile)) != EOF && c!='\n';);
@@ -14822,7 +19301,7 @@ int RunMultiFiles (char *mFileName, char mOpt)
 
 		if (GetLocUsed (input, nloci, locUse, nloci-nlocDel, NULL) != 0) {
 			fclose (input);
-			fclose (output);
+			if (output != NULL) fclose (output);
 			if (tolower(fgetc (mInpFile)) != 'y') break;
 			for (; (c=fgetc(mInpFile)) != EOF && c!='\n';);
 			free (locUse);
@@ -14837,7 +19316,9 @@ int RunMultiFiles (char *mFileName, char mOpt)
 		strcat (prefix, outName);
 		if (xOutLD == 1) {
 			GetXoutName (outName, prefix, PATHFILE, XFILSUFLD, PATHCHR);
-			if (append == 1)
+			if (job != NULL)
+				strcat (job->outName[1], outName);
+			else if (append == 1)
 				shOutputLD = fopen (outName, "a");
 			else
 				shOutputLD = fopen (outName, "w");
@@ -14846,7 +19327,9 @@ int RunMultiFiles (char *mFileName, char mOpt)
 		};
 		if (xOutHet == 1) {
 			GetXoutName (outName, prefix, PATHFILE, XFILSUFHET, PATHCHR);
-			if (append == 1)
+			if (job != NULL)
+				strcat (job->outName[2], outName);
+			else if (append == 1)
 				shOutputHet = fopen (outName, "a");
 			else
 				shOutputHet = fopen (outName, "w");
@@ -14855,7 +19338,9 @@ int RunMultiFiles (char *mFileName, char mOpt)
 		};
 		if (xOutCoan == 1) {
 			GetXoutName (outName, prefix, PATHFILE, XFILSUFCOAN, PATHCHR);
-			if (append == 1)
+			if (job != NULL)
+				strcat (job->outName[3], outName);
+			else if (append == 1)
 				shOutputCoan = fopen (outName, "a");
 			else
 				shOutputCoan = fopen (outName, "w");
@@ -14864,13 +19349,23 @@ int RunMultiFiles (char *mFileName, char mOpt)
 		};
 		if (xOutTemp == 1) {
 			GetXoutName (outName, prefix, PATHFILE, XFILSUFTEMP, PATHCHR);
-			if (append == 1)
+			if (job != NULL)
+				strcat (job->outName[4], outName);
+			else if (append == 1)
 				shOutputTemp = fopen (outName, "a");
 			else
 				shOutputTemp = fopen (outName, "w");
 			printf ("Tabular-format Temporal Output: [%s]", outName);
 			if (append == 1) printf (" (Append)"); printf ("\n");
 		};
+		if (job != NULL) {
+			SetJob (job, ++count, inpName, input, popStart, popEnd, maxSamp,
+					nloci, lenM, maxMobilVal, nCrit, critVal, format, param,
+					nonparam, locUse, mating, mLD, mHet, mNomura, mTemporal,
+					nGeneration, timeline, tempClue, tempxClue, byRange,
+					topCrit, nPlan, census, tabX);
+			locUse = NULL;	// to be freed with job
+		} else
 		if (RunPop (++count, inpName, input, append, output,
 				NULL,	// this is for Burrows file, so set NULL
 				NULL,	// locList
@@ -14889,7 +19384,9 @@ int RunMultiFiles (char *mFileName, char mOpt)
 				// next 0 is for no getting age from a linked list for timeline
 				census, &totPop, &totPairTmp, 0, tabX,
 				// for generations, then 0 for "NOT" common
-				0, 0, 0, NULL, 0, 0, 0) == 0) // add parameters Apr 2015
+				0, 0, 0, NULL, 0, 0, 0, NULL, progOut, profOut, r2Out, recOut,
+				ldOpt) == 0)
+				// add parameters Apr 2015
 			printf("Finish running input %d.\n", count);
 		free (locUse);
 // these are already closed in RunPop
@@ -14902,6 +19399,9 @@ int RunMultiFiles (char *mFileName, char mOpt)
 	};
 
 	fclose (mInpFile);
+	if (batch == 1)
+		RunBatch (jobList, nJob, 0, NULL, &totPop, &totPairTmp, progOut,
+					profOut, r2Out, recOut, ldOpt);
 	return count;
 
 }
@@ -15013,7 +19513,9 @@ int RunDirect (char misFilSuf[])
 					// next-to-last 0 for "Not" common
 					// last 0 for no tab in tabular-format output (redundant)
 					// Apr 2015: parameters added
-					0, 0, 0, NULL, 0, 0, 0)!= 0) return nRun;
+					0, 0, 0, NULL, 0, 0, 0, NULL, NULL, NULL, NULL, NULL,
+					NULL)!= 0)
+			return nRun;
 		nRun++;
 // temporarily exit (i.e., only run one input file, then exit the program):
 //		break;
@@ -15049,18 +19551,33 @@ int RunDirect (char misFilSuf[])
 // April 2015: add functions RmChromo, GetChromo, and ChromoInp
 //--------------------------------------------------------------------------
 
-void RmChromo(struct chromosome *chromoList)
+void RmChromo(struct chromosome *chromoList, int nChromo)
+// Oct 2026: nChromo chromosomes (was taken as sizeof(chromoList)), their
+// positions and distance windows
 {
 
 	int p;
-	int n = sizeof(chromoList);
-	for (p=0; p<n; p++) {
+	for (p=0; p<nChromo; p++) {
 		free (chromoList[p].locus);
+		free (chromoList[p].pos);
+		free (chromoList[p].pairLo);
+		free (chromoList[p].pairHi);
 	}
 	free(chromoList);
 
 }
 
+//--------------------------------------------------------------------------
+
+int LocPosCmp (const void *a, const void *b)
+// Oct 2026: for qsort, loci in order of positions, then of input
+{
+	struct locpos *x = (struct locpos*) a;
+	struct locpos *y = (struct locpos*) b;
+	if (x->pos != y->pos) return (x->pos < y->pos)? -1: 1;
+	return (x->locus < y->locus)? -1: (x->locus > y->locus)? 1: 0;
+}
+
 // --------------------------------------------------------------------------
 
 struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
@@ -15068,6 +19585,9 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 // Read file input, which contains chromosome names and their loci.
 // Assuming on each line, the first two strings are the names of a chromosome
 // and of a locus contained in that chromosome.
+// Oct 2026: a third string on the line, if any, is the position of the locus
+// on the chromosome (base pairs). If all loci of a chromosome have positions,
+// they are put in the order of positions (see ChromoWindow).
 // From the list locList containing locus names and locus numberings, compare
 // the names read from input file and the names on the list, to determine
 // chromosomes, and their loci contained in.
@@ -15132,6 +19652,14 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 	char *chromo = (char*) malloc(sizeof(char)*LEN_LOCUS);
 	char *chromo0 = (char*) malloc(sizeof(char)*LEN_LOCUS);
 	char *locus = (char*) malloc(sizeof(char)*LEN_LOCUS);
+	// Oct 2026: positions of loci on locList, -1 if not given
+	char *posStr = (char*) malloc(sizeof(char)*LEN_LOCUS);
+	long *posAt = (long*) malloc(sizeof(long)*nlocUsed);
+	struct locpos *lp = (struct locpos*)
+						malloc(sizeof(struct locpos)*nlocUsed);
+	long pos;
+	char *endPtr;
+	for (n=0; n<nlocUsed; n++) *(posAt+n) = -1;
 	// this array is to notify which locus is done, so don't have to search
 	int *done = (int*) malloc(sizeof(int)*nlocUsed);
 	for (n=0; n<nlocUsed; n++) *(done+n) = -1;
@@ -15160,8 +19688,18 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 		// the second string "locus" is supposed to be the name of a locus
 		if (GetToken(chroInp, locus, LEN_LOCUS, BLANKS, CHARSKIP, &c, &n) == 0)
 			break;
+		// Oct 2026: the third string, if any, as position (base pairs)
+		pos = -1;
+		p = 1;
+		if (c != '\n') {
+			if (GetToken(chroInp, posStr, LEN_LOCUS, BLANKS, CHARSKIP,
+						&c, &n) > 0) {
+				pos = strtol (posStr, &endPtr, 10);
+				if (*endPtr != '\0' || pos < 0) pos = -1;
+			} else if (c == '\n') p = 0;	// the line is done
+		}
 		// finish the line:
-		for (; (c=fgetc(chroInp)) == EOF || c !='\n';);
+		if (p == 1) for (; (c=fgetc(chroInp)) == EOF || c !='\n';);
 		// the next loop is to find a locus in locList that has the name
 		// as the second string, then assign field chromo of that locus to be
 		// the first string. Once a locus is assigned this field, it will not
@@ -15183,6 +19721,7 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 				strcpy(locList[n].chromo, chromo);	// register chromosome
 				strcpy((chroAtLoc[n].name), chromo);	//  for this locus
 				done[n] = locList[n].num;	// locList[n] is done!
+				*(posAt+n) = pos;
 				if (strcmp(chromo0, chromo) == 0) {	// same as previous one
 					(curr->nloci)++;
 					break;	// save time, don't need to search the list
@@ -15241,9 +19780,23 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 			for (p=0; p<nlocUsed; p++) {
 				if (strcmp(chroAtLoc[p].name, chromoList[n].name) == 0) {
 					(chromoList[n].locus)[c] = done[p];
+					lp[c].locus = done[p];
+					lp[c].pos = *(posAt+p);
 					c++;
 				}
 			}
+			// Oct 2026: loci in order of positions if all are given
+			chromoList[n].pos = NULL;
+			chromoList[n].pairLo = chromoList[n].pairHi = NULL;
+			for (p=0; p<c && lp[p].pos >= 0; p++);
+			if (p == c && c > 0 &&
+				(chromoList[n].pos = (long*) malloc(sizeof(long)*c)) != NULL) {
+				qsort (lp, c, sizeof(struct locpos), LocPosCmp);
+				for (p=0; p<c; p++) {
+					(chromoList[n].locus)[p] = lp[p].locus;
+					(chromoList[n].pos)[p] = lp[p].pos;
+				}
+			}
 			curr = curr->next;
 			n++;
 		}
@@ -15256,6 +19809,8 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 			// just in case there is a chromosome named '9...9', add an 'X'
 			if (len < LEN_LOCUS) (chromoList[n].name)[len] = 'X';
 			chromoList[n].locus = (int*) malloc(sizeof(int)*m);
+			chromoList[n].pos = NULL;
+			chromoList[n].pairLo = chromoList[n].pairHi = NULL;
 			c = 0;
 			for (p=0; p<nlocUsed; p++) {
 				if (done[p] == -1) {
@@ -15268,6 +19823,9 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 	}
 	free(chroAtLoc);
 	free(done);
+	free (posStr);
+	free (posAt);
+	free (lp);
 	// dispose chroTemp:
 	prev = chroTemp;
 	for (; prev != NULL; prev = curr) {
@@ -15279,10 +19837,64 @@ struct chromosome* GetChromo (FILE *chroInp, int nlocUsed,
 	return chromoList;
 }
 
+//--------------------------------------------------------------------------
+
+void ChromoWindow (struct chromosome *chromoList, int nChromo, long minDist,
+					long maxDist)
+// Oct 2026: pair loci within a chromosome only when their distance is at
+// least minDist and at most maxDist (0 for no bound). As loci are in order
+// of positions, locus k is paired with loci pairLo[k], ..., (pairHi[k]-1),
+// so that only those pairs are gone over. All pairs are taken in
+// chromosomes without positions.
+{
+	int m, k, n, lo, hi, noPos = 0;
+	long *pos;
+	if (minDist <= 0 && maxDist <= 0) return;
+	printf ("Locus pairs within chromosomes at distance (bp) %ld to ",
+			(minDist > 0)? minDist: 0);
+	if (maxDist > 0) printf ("%ld\n", maxDist);
+	else printf ("no limit\n");
+	for (m = 0; m < nChromo; m++) {
+		pos = chromoList[m].pos;
+		n = chromoList[m].nloci;
+		if (pos == NULL) {
+			noPos++;
+			continue;
+		}
+		chromoList[m].pairLo = (int*) malloc(sizeof(int)*n);
+		chromoList[m].pairHi = (int*) malloc(sizeof(int)*n);
+		if (chromoList[m].pairLo == NULL || chromoList[m].pairHi == NULL) {
+			free (chromoList[m].pairLo);
+			free (chromoList[m].pairHi);
+			chromoList[m].pairLo = chromoList[m].pairHi = NULL;
+			noPos++;
+			continue;
+		}
+		for (k = 0, lo = 0, hi = 0; k < n; k++) {
+			if (lo <= k) lo = k+1;
+			if (minDist > 0)
+				while (lo < n && *(pos+lo) - *(pos+k) < minDist) lo++;
+			if (hi < lo) hi = lo;
+			if (maxDist > 0)
+				while (hi < n && *(pos+hi) - *(pos+k) <= maxDist) hi++;
+			else hi = n;
+			(chromoList[m].pairLo)[k] = lo;
+			(chromoList[m].pairHi)[k] = hi;
+		}
+	}
+	if (noPos > 0) printf ("%d chromosome(s) without positions of all loci:"
+					" all pairs of their loci are taken\n", noPos);
+}
+
 
 //------------------------------------------------------------------
 int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
-				char hasOpt, char rem, char *FileOne, char *FileTwo)
+				char hasOpt, char rem, char *FileOne, char *FileTwo,
+				FILE *progOut, FILE *profOut, R2STORE r2Out, RECOUT recOut,
+				LDOPT ldOpt)
+// Oct 2026: progress of LD method is written to progOut if not NULL,
+// timing of phases to profOut, r^2 at locus pairs to r2Out, records of
+// results to recOut if not NULL. LD method has options ldOpt if not NULL.
 {
 
 	int maxSamp, nCrit, nGeneration;
@@ -15374,6 +19986,15 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 			remove (FileOne);
 			if (hasOpt == 1) remove (FileTwo);
 		};
+	// Oct 2026: all is freed, for server mode
+		free (ageSeq);
+		free (chrofileName);
+		free (inpName);
+		free (inpFolder);
+		free (outName);
+		free (outFolder);
+		free (outFile);
+		free (outFile0);
 		return 0;
 	};
 	// close the file before remove
@@ -15398,6 +20019,17 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 	n = mLD + mHet + mNomura + mTemporal;
 	if (n <= 0) {
 		printf ("No method to run\n");
+	// Oct 2026: all is freed, for server mode
+		fclose (input);
+		free (locUse);
+		free (ageSeq);
+		free (chrofileName);
+		free (inpName);
+		free (inpFolder);
+		free (outName);
+		free (outFolder);
+		free (outFile);
+		free (outFile0);
 		return 0;
 	};
 	PrtMethod (n, mLD, mHet, mNomura, mTemporal);
@@ -15439,7 +20071,19 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 	}
 	if (GetLocUsed (input, nloci, locUse, nlocUse, locList) != 0) {
 		printf ("Error when trying to collect locus names\n");
-		exit(1);
+		fclose (input);
+	// Oct 2026: not exit, for server mode, so all is freed
+		free (locList);
+		free (locUse);
+		free (ageSeq);
+		free (chrofileName);
+		free (inpName);
+		free (inpFolder);
+		free (outName);
+		free (outFolder);
+		free (outFile);
+		free (outFile0);
+		return 0;
 	}
 // Added April 2015:
 	// only need to work on file chroInp on chromosomes if chroGrp = 1 or 2,
@@ -15449,6 +20093,10 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 		chroInp = GetInp (inpFolder, chrofileName);
 		chromoList = GetChromo (chroInp, nlocUse, locList, &nChromo, &unknown);
 		fclose(chroInp);
+	// Oct 2026: distance window of locus pairs within chromosomes
+		if (chromoList != NULL && chroGrp == 1 && ldOpt != NULL)
+			ChromoWindow (chromoList, nChromo, ldOpt->minDist,
+						ldOpt->maxDist);
 	}
 	free (chrofileName);
 
@@ -15460,10 +20108,34 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 	outFile = strcat (outFile, outFolder);
 	outFile = strcat (outFile, outName);
 	if (append > 0) mode[0] = 'a';
-	if ((output=fopen (outFile, mode)) == NULL) {
+// Oct 2026: dry run, output files are not touched (see PopCost); the
+// temporal method is not predicted.
+	if (ldOpt != NULL && ldOpt->dryRun == 1) {
+		xOutLD = xOutHet = xOutCoan = xOutTemp = 0;
+		misDat = 0;
+		if (mTemporal == 1)
+			printf ("Dry run: temporal method is left out\n");
+		mTemporal = 0;
+		output = tmpfile ();
+	} else output = fopen (outFile, mode);
+	if (output == NULL) {
 		printf ("Output file cannot be opened! Program aborted.\n");
-		exit (EXIT_FAILURE);
-	} else {
+		fclose (input);
+	// Oct 2026: not exit, for server mode, so all is freed
+		if (chromoList != NULL) RmChromo (chromoList, nChromo);
+		free (locList);
+		free (locUse);
+		free (ageSeq);
+		free (inpName);
+		free (inpFolder);
+		free (outName);
+		free (outFolder);
+		free (outFile);
+		free (outFile0);
+		return 0;
+	} else if (ldOpt != NULL && ldOpt->dryRun == 1)
+		printf ("Dry run: cost is predicted, no outputs are written\n");
+	else {
 		printf ("Outputs are written to file %s", outName);
 		if (append > 0) printf (" (append)\n");
 		printf ("\n");
@@ -15556,6 +20228,7 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 	if (popBurr2 < popBurr1) popBurr2 = 0;
 	if (popBurr1 > popEnd) popBurr2 = 0;
 	if (popBurr2 > popEnd) popBurr2 = popEnd;
+	if (ldOpt != NULL && ldOpt->dryRun == 1) popLoc2 = 0;
 	if (popLoc2 > 0)
 // open Freq. data file if the range of populations for Freq. data overlaps
 // with the one in analysis (which is from popStart to popEnd <= nPop).
@@ -15565,6 +20238,7 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 		*outFile = '\0';
 		outFile = strcat (outFile, outFolder);
 		if ((outLoc = fopen (strcat(outFile, outLocName), "w")) != NULL) {
+			setvbuf (outLoc, NULL, _IOFBF, OUTBUF);
 			PrtVersion (outLoc);
 			fprintf (outLoc, "Input File: %s\n\n", inpName);
 		} else popLoc2 = 0;
@@ -15573,11 +20247,13 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 	// add condition, so that Burrows file will not be created here, but
 	// in RunPop0 for separate Burrows file when sepBurOut = 1
 //	if (popBurr2 > 0)
-	if (popBurr2 > 0 && sepBurOut == 0)
+	if (popBurr2 > 0 && sepBurOut == 0
+		&& (ldOpt == NULL || ldOpt->dryRun == 0))
 	{
 		*outFile = '\0';
 		outFile = strcat (outFile, outFolder);
 		if ((outBurr = fopen (strcat(outFile, outBurrName), "w")) != NULL) {
+			setvbuf (outBurr, NULL, _IOFBF, OUTBUF);
 //			if (NOEXPLAIN != 1) {
 			if (sepBurOut != 1) {
 				PrtVersion (outBurr);
@@ -15618,7 +20294,8 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 				&totPop, &totPairTmp, 0, tabX,
 				// add parameters Apr 2015
 				sepBurOut, moreCol, BurAlePair,
-				chromoList, nChromo, chroGrp, unknown);
+				chromoList, nChromo, chroGrp, unknown, NULL, progOut, profOut,
+				r2Out, recOut, ldOpt);
 
 	// close the file before remove
 //	fclose (info);
@@ -15634,7 +20311,7 @@ int RunOption (char misFilSuf[], char LocSuf[], char BurSuf[],
 	free (outFile0);
 // Apr 2015:
 	if (locList != NULL) free (locList);
-	if (chromoList != NULL) RmChromo (chromoList);
+	if (chromoList != NULL) RmChromo (chromoList, nChromo);
 	return 1;
 }
 
@@ -15695,7 +20372,9 @@ void PrtLimitCommon (FILE *output, char byRange, int *locRanges, int nRanges,
 
 
 //--------------------------------------------------------------------------
-int RunMultiCommon (char *mFileName)
+int RunMultiCommon (char *mFileName, int nJob, FILE *progOut, FILE *profOut,
+				R2STORE r2Out, RECOUT recOut,
+				LDOPT ldOpt)
 // Run multiple input files having the same options:
 // ("applicable" means that the line exists only if needed!)
 // 1. Method(s)
@@ -15714,6 +20393,10 @@ int RunMultiCommon (char *mFileName)
 //
 // Return the number of successful runs.
 // If input file name is empty, quit.
+// Oct 2026: if nJob != 1, inputs are run by RunBatch, nJob at a time.
+// Progress of LD method is written to progOut if not NULL, timing of
+// phases to profOut, r^2 at locus pairs to r2Out, records of results to
+// recOut if not NULL. LD method has options ldOpt if not NULL.
 {
 	#define LOCRANGE 100	// max endpoints of locus ranges to be used
 	#define MAXLOCI 1000000		// maximum number of loci to be used
@@ -15749,6 +20432,8 @@ int RunMultiCommon (char *mFileName)
 	char tabX;
 	int *xClues;
 	char byRange = 1;
+	FILE *shared[5];
+	BATCHJOB jobList = NULL, jobLast = NULL, job;
 //	char prefix[LENFILE] = "\0";
 //	char prefix[PATHFILE] = "\0";
 	FILE *input = NULL;
@@ -16087,6 +20772,21 @@ int RunMultiCommon (char *mFileName)
 		};
 //---------------------------------------------------------------------------
 
+		if (nJob != 1) {
+			if ((job = AddJob (&jobList, &jobLast)) == NULL) {
+				printf ("Out of memory for input %d!\n", count+1);
+				fclose (input);
+				free (locUse);
+				continue;
+			};
+			job->append = append;
+			SetJob (job, ++count, inpName, input, popStart, popEnd, maxSamp,
+					nloci, lenM, maxMobilVal, nCrit, critVal, format, param,
+					nonparam, locUse, mating, mLD, mHet, mNomura, mTemporal,
+					nGeneration, timeline, tempClue, tempxClue, byRange,
+					topCrit, nPlan, census, tabX);
+			continue;	// locUse to be freed with job
+		};
 		if (RunPop (++count, inpName, input, append, output,
 				NULL,	// for outFolder, not needed since no Burrows file
 				NULL,	// locList
@@ -16105,7 +20805,9 @@ int RunMultiCommon (char *mFileName)
 				// NULL, 0: no list for Generations
 				// 0 in front of tempClue is for no getting age (no list!)
 				// last 1 is for running multiple files with common setting
-				 0, 0, 0, NULL, 0, 0, 0) == 0)	// last param added Apr 2015
+				 0, 0, 0, NULL, 0, 0, 0, NULL, progOut, profOut, r2Out, recOut,
+				 ldOpt) == 0)
+				// last param added Apr 2015
 			printf("Finish running input %d.\n", count);
 		free (locUse);
 // these are already closed in RunPop
@@ -16113,6 +20815,15 @@ int RunMultiCommon (char *mFileName)
 //		fclose (output);
 	};
 //	free (locRanges);
+	if (jobList != NULL) {
+		shared[0] = output;
+		shared[1] = shOutputLD;
+		shared[2] = shOutputHet;
+		shared[3] = shOutputCoan;
+		shared[4] = shOutputTemp;
+		RunBatch (jobList, nJob, 1, shared, &totPop, &totPairTmp, progOut,
+					profOut, r2Out, recOut, ldOpt);
+	};
 	time ( &rawtime );
 	PrintEndTime (output, rawtime);
 
@@ -16137,3 +20848,163 @@ int RunMultiCommon (char *mFileName)
 }
 
 //------------------------------------------------------------------
+
+void Ne2TempName (char *name, char **popID, int g)
+// Oct 2026: name of population g in temporal results of Ne2Estimate, the
+// last POP_TEMP chars as in RunPop0, its number if it has no name.
+{
+	int n;
+	if (popID != NULL && *(popID+g) != NULL)
+		snprintf (name, NE2POPID, "%s", *(popID+g));
+	else snprintf (name, NE2POPID, "%d", g+1);
+	n = strlen (name);
+	if (n > POP_TEMP) memmove (name, name+n-POP_TEMP, POP_TEMP+1);
+}
+
+//------------------------------------------------------------------
+
+int Ne2Estimate (struct ne2opt *opt, int nloci, int nPop, int *samp,
+				int *geno, char **popID, struct result *res, int maxRes)
+// Oct 2026: library entry (see ne2.h). Populations in memory are estimated
+// as RunPop0 does for populations read from input, by PopCompute, without
+// any output files; results are collected by PopResults, TempResults.
+// Return the number of results, -1 if out of memory, -2 if not valid.
+{
+	int n, k, p, g1, g2, iPair, nRes = 0, nTemp;
+	int maxMobilVal = 0, lenM, zero = 0, err = 0;
+	long nInd = 0, i;
+	char makeFish, name[2][NE2POPID];
+	int *sample;
+	FILE *nullFILE = NULL;
+	struct popset popSet;
+	struct result tmp[3*MAXCRIT];
+	POPEST pe;
+	float critVal[MAXCRIT];
+
+	if (opt == NULL || samp == NULL || geno == NULL || nloci <= 0
+		|| nPop <= 0 || opt->nCrit <= 0 || opt->nCrit > MAXCRIT
+		|| opt->critVal == NULL) return -2;
+	for (n=0; n<opt->nCrit; n++) {
+		critVal[n] = *(opt->critVal+n);
+		if (critVal[n] < 0 || critVal[n] >= 0.5) return -2;
+		if (n > 0 && critVal[n] >= critVal[n-1]) return -2;
+	};
+	if (opt->mTemporal == 1 && (nPop < 2 || nPop > MAXGENERATION
+		|| opt->timeline == NULL)) return -2;
+	for (k=0; k<nPop; k++) {
+		if (*(samp+k) <= 0) return -2;
+		if (opt->mTemporal == 1 && k > 0
+			&& *(opt->timeline+k) <= *(opt->timeline+k-1)) return -2;
+		nInd += *(samp+k);
+	};
+	for (i=0; i<2*nloci*nInd; i++)
+		if (*(geno+i) > maxMobilVal) maxMobilVal = *(geno+i);
+	for (lenM=1, n=maxMobilVal; n>=10; n/=10) lenM++;
+	makeFish = (opt->mLD > 0 || opt->mNomura > 0
+				|| (opt->mHet > 0 && opt->nCrit > 1))? 1: 0;
+
+	memset (&popSet, 0, sizeof(struct popset));
+	popSet.outBurr = &nullFILE;
+	popSet.popBurr2 = &zero;
+	popSet.nloci = nloci;
+	popSet.lenM = lenM;
+	popSet.nCrit = opt->nCrit;
+	popSet.critVal = critVal;
+	popSet.param = opt->param;
+	popSet.jacknife = opt->jacknife;
+	popSet.mating = opt->mating;
+	popSet.infinite = INFINITE;
+	popSet.mLD = opt->mLD;
+	popSet.mHet = opt->mHet;
+	popSet.mNomura = opt->mNomura;
+	popSet.mTemporal = opt->mTemporal;
+	popSet.tempk = opt->tempk;
+	popSet.tempc = opt->tempc;
+	popSet.temps = opt->temps;
+	popSet.census = opt->census;
+	popSet.timeline = opt->timeline;
+	popSet.nGeneration = nPop;
+	for (n=0; n<opt->nCrit; n++)
+		if (critVal[n] > 0 && critVal[n] <= PCRITX) popSet.specP = 1;
+	popSet.locUse = (char*) malloc(sizeof(char)*nloci);
+	pe = MakePopEst (nloci, opt->nCrit, NE2POPID, makeFish, INFINITE, 0);
+	if (opt->mTemporal == 1)
+		popSet.freqList = (FREQPTR*) calloc(nloci, sizeof(FREQPTR));
+	if (popSet.locUse == NULL || pe == NULL
+		|| (opt->mTemporal == 1 && popSet.freqList == NULL)) {
+		free (popSet.locUse);
+		RemovePopEst (pe);
+		free (popSet.freqList);
+		return -1;
+	};
+	for (p=0; p<nloci; p++) *(popSet.locUse+p) = 1;
+
+	for (k=0, sample=geno; k<nPop && err == 0; k++) {
+		for (p=0; p<nloci; p++) {
+			*(pe->alleList+p) = NULL;
+			*(pe->okLoc+p) = 1;
+			*(pe->nMobil+p) = 0;
+			*(pe->missptr+p) = 0;
+			*(pe->minFreq+p) = 0;
+			*(pe->maxFreq+p) = 0;
+			if (makeFish > 0) {
+				*(pe->fishHead+p) = NULL;
+				*(pe->fishTail+p) = NULL;
+			};
+		};
+		pe->weighsmp = 0;
+		for (n=0; n<*(samp+k) && err == 0; n++, sample+=2*nloci) {
+			for (p=0; p<2*nloci; p++) if (sample[p] <= 0) pe->weighsmp = 1;
+			if ((AddAlleWide (pe->alleList, nloci, sample, pe->nMobil,
+				pe->missptr, maxMobilVal, k+1, n+1) != 0) ||
+				AddFishWide(pe->fishHead, pe->fishTail, nloci, sample,
+							popSet.locUse, makeFish) == 0) err = -1;
+		};
+		pe->popRead = k+1;
+		pe->samp = *(samp+k);
+		if (popID != NULL && *(popID+k) != NULL)
+			snprintf (pe->popID, NE2POPID, "%s", *(popID+k));
+		else snprintf (pe->popID, NE2POPID, "%d", k+1);
+		pe->jSamp = (opt->jacknife == 1 && pe->samp >= MINSAMP)? 1: 0;
+		pe->moreDat = 0;
+		pe->moreBurr0 = 0;
+		pe->showTime = 0;
+		popSet.generation = k;
+		popSet.tpDone = (k == nPop-1)? 1: 0;
+		if (err == 0) {
+			PopCompute (pe, &popSet, NULL);
+			n = PopResults (pe, &popSet, tmp);
+			for (i=0; i<n; i++, nRes++)
+				if (nRes < maxRes) *(res+nRes) = *(tmp+i);
+		};
+		if (opt->mTemporal == 1 && popSet.errfreq != 0) err = -1;
+		if (popSet.tempRes != NULL) {
+			for (g1=0, iPair=0; g1<k; g1++) {
+				for (g2=g1+1; g2<k+1; g2++, iPair++) {
+					Ne2TempName (name[0], popID, g1);
+					Ne2TempName (name[1], popID, g2);
+					nTemp = TempResults (tmp, 0, k+1, name[0], name[1],
+							opt->nCrit, critVal, *(popSet.tempRes+iPair),
+							opt->tempk, opt->tempc, opt->temps, opt->param,
+							opt->jacknife);
+					for (i=0; i<nTemp; i++, nRes++)
+						if (nRes < maxRes) *(res+nRes) = *(tmp+i);
+					RemoveTempRes (*(popSet.tempRes+iPair));
+				};
+			};
+			free (popSet.tempRes);
+			popSet.tempRes = NULL;
+		};
+		RemoveAlle (pe->alleList, nloci);
+		if (makeFish > 0) RemoveFish (pe->fishHead, nloci);
+	};
+	if (opt->mTemporal == 1) {
+		RemoveFreq (popSet.freqList, nloci);
+		free (popSet.freqList);
+	};
+	RemovePopEst (pe);
+	free (popSet.locUse);
+	return (err == 0)? nRes: err;
+}
+
+//------------------------------------------------------------------
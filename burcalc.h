@@ -0,0 +1,756 @@
+// burcalc.h
+// Oct 2026: Burrows_Calcul, LD method at a locus pair, as a template
+// compiled once for each variant by Ne2x.c, which defines before
+// including this file:
+//	BC_NAME	name of the variant
+//	BC_JACK	1 for jackknife on samples (argument jack != 0), else 0
+//	BC_MISS	1 if samples can miss data at the pair (weighsmp != 0), else 0
+//	BC_OUT	1 if Burrows coefficients can be written (outBurr != NULL,
+//			moreBurr = 1), else 0
+// Those are constants, so the compiler drops the parts of the loops they
+// turn off (the arguments they stand for are not tested there). A variant
+// must be called only where its flags hold, see BurCalcPick.
+
+// Modified Dec 2016:
+// Add a local variable cutoffRev to be parameter of IndAlle2, and reset
+// cutoff = cutoffRev. When Burrows_Calcul is called again for another
+// locus pair, cutoff as parameter of Burrows_Calcul is still the old one.
+void BC_NAME (float cutoff, ALLEPTR allep1, ALLEPTR allep2,
+                FISHPTR popLoc1, FISHPTR popLoc2, int p1, int p2,
+                int nMp1, int nMp2, int nfish, float *nSamp,
+                int *nInd1, int *nInd2, int *nMpairs, float *rB,
+                int currPop, int *missptr, FILE *outBurr,
+                char *outBurrName, char moreBurr, char BurrPause,
+                float *expR2, char weighsmp,
+// add in Nov 2014/ Jan 2015/ Mar 2015:
+                char sepBurOut, char moreCol, char BurAlePair,
+// add Mar 2016:
+// unidented variables are for checking, remove them together with those in
+// LDRunPairs, Pair_Analysis, LDMethod, etc., later:
+// for checking with checkR2
+//char *opened,
+                char jack, int **p1Gen, int **p2Gen, int *noDatFish,
+                char *countm1, char *countm2,
+                int *mValp1, float *freqp1, float *homop1,
+                int *mValp2, float *freqp2, float *homop2,
+                float *r2AtPairX,
+// temporarily add for checking with checkR2:
+//double *r2JackTot,
+                float *JweighPair,
+                unsigned long long *r2Count, float epsilon)
+
+// calculate Burrows coefficients for a pair of loci (p1, p2).
+// nMp1, nMp2: number of alleles at loci p1, p2
+// added in Sept 2011 parameter BurrPause
+// weighsmp to denote if the population has missing data
+// epsilon is a small number, used to check some rational number should be 0
+
+// r2AtPairX is array of r^2 calculated at this locus pair, for each sample
+// set where one sample is removed from S. Name such sample set as S# or Sk
+// (when sample k is removed); there are "nfish" such sets.
+// So r2AtPairX[k] = average of r^2 over all allele pairs at locus pair
+// (p1, p2) for sample set Sk.
+//
+// r2JackTot contains the sum of r^2 up to this locus pair (p1, p2), for
+// each sample set S#.
+//
+// JweighPair contains product of independent alleles at each S#;
+// this is used for calculating weighted average of r^2 in each S#.
+// r2Count is the number of r^2 evaluated for each sample set S#. Some sample
+// set S# may not have r^2 calculated (ineligible for Burrows calculations)
+{
+
+	int i, j, k, nEff1, nEff2;
+	int m1, m2;
+	char writeBur;
+	float f1, f2, x, xy;
+	float varp1;
+	float dBur, rBur, rBur2;
+	float rMean, dBurMean, r2Mean;   // for averages of rBur and dBur, r2Mean
+	// *rB = r2Mean is the output for average of rBur2 (square of rBur)
+	// Added in Nov 2014 for min freq at loci p1, p2:
+	float fminp1, fminp2;
+// add cutoffRev in Dec 2016, for reassigning cutoff value:
+	float cutoffRev;
+
+	IndAlle2 (p1Gen, p2Gen, noDatFish, popLoc1, popLoc2, cutoff, nfish,
+			allep1, allep2, nMp1, nMp2, &nEff1, mValp1, &nEff2, mValp2,
+			nSamp, freqp1, homop1, freqp2, homop2, nInd1, nInd2,
+			weighsmp, &fminp1, &fminp2, &cutoffRev);
+// Dec 2016: the rest use cutoff, so we don't want to go to change them,
+// just set cutoff to be this reassignment when cutoff is a special value
+// for dropping singletons (old cutoff is still unchanged when this exits):
+	cutoff = cutoffRev;
+
+// nInd1, nInd2 are the number of alleles having freq > cutoff
+// when measured against samples having data at both loci p1, p2.
+// However, if there are no freq <= cutoff, nIndJ will be the number
+// of alleles at locus J, less 1 (since the sum of freq = 1, only nIndJ
+// values of freq are needed in this case, the one left is then known).
+// They are defined as numbers of independent alleles at loci p1, p2
+// taken against samples having data at both lci.
+// nEff1 and nEff2 are the number of alleles in loci p1, p2 whose
+// freqs are between cutoff and < 1. Allele having frequency (1-cutoff) and
+// above is not counted. Those alleles (counted nEff1, nEff2) are used in
+// calculating Burrows coeffs. We have nInd1 <= nEff1, nInd2 <= nEff2.
+
+// nInd1 < nEff1: no allele being dropped (no allele having freq < cutoff)
+// Similarly for nInd2 < nEff2.
+
+// Added in Jan 2016:
+	float rowSum;
+	char rSkip1, rSkip2, rSkip, dSkip;
+// Add in March 2016:
+	float pSum, pSumx, rBur2x, f1x, f2x, var1, var2;
+	char reject;
+	char rSet;
+	float frac, frac2, dBurx;
+
+/* **********************************************************************
+   The following can be proved mathematically.
+   (dBur, rBur are Burrows disequilibrium and correlation, rBur2 = (rBur)^2.)
+   (1) nInd1 < nEff1 and nInd2 < nEff2 (no allele dropped).
+        Then dBurMean = 0.
+    a. If nEff1 = 2 (=> nInd1 = 1), there are only 2 alleles A1, A2
+       at locus p1, then the Burrows coefficients dBur, rBur for
+       the two pairs of loci (A1,B), (A2,B) are equal in absolute value
+       and of opposite signs for any allele B at the other locus.
+       Similarly for nEff2 = 2.
+    b. If both nEff1 = 2 and nEff2 = 2 (each locus has 2 alleles),
+       then average of rBur2 (square of rBur), which is one of returned
+       value *rB, is any rBur2 at one of the 4 pairs.
+   (2) nInd1 < nEff1 and nInd2 = nEff2, no allele dropped at locus
+    p1 but some are dropped at locus p2.
+        Then dBurMean = 0 (averaged over all eligible locus pairs).
+        If also nEff1 = 2, then we have a similar result as in (1)a.
+        It follows that rMean = 0.
+        Similar results are for nInd1 = nEff1 and nInd2 < nEff2.
+
+*/
+// **********************************************************************
+
+// nMpairs is the number of allele pairs at locus pair (p1, p2) at which
+// Burrows coefficients are calculated; nInd1*nInd2 is number of ind. alleles
+	*nMpairs = nEff1 * nEff2;
+
+	*rB = 0;
+	*expR2 = ExpR2Samp(*nSamp);
+// added in Sept 2011 to prevent division by zero:
+	if (*nMpairs <= 0) return;
+
+// write to Burrows file, add BurrPause in Sept 2011, BurAlePair in Apr 2015:
+	writeBur = (outBurr != NULL && moreBurr == 1 && BurrPause == 0)? 1: 0;
+	if (BC_OUT && writeBur == 1  && BurAlePair == 1)
+	{
+		if (sepBurOut == 0) {
+			fprintf (outBurr, "\n      Pop.    Loc._Pairs   Allele_Pairs    P1"
+			"    P2    Burrows->D       r         r^2\n");
+		fprintf (outBurr, "   ");
+        PrtLines (outBurr, 85, '-');
+//  	} else {
+//          fprintf (outBurr, "\nLoc._Pairs   Allele_Pairs    P1"
+//          "    P2    Burrows->D       r         r^2\n");
+		}
+	}
+
+	rMean= 0.0; dBurMean= 0.0, r2Mean = 0.0;
+	// rSkip# = 1 if exactly 2 alleles at the locus, and no allele dropped.
+	// Either rSkip1 = 1 or rSkip2 = 1 will imply that the sum of
+	// coefficients rBur across all pairs of loci is zero
+	rSkip1 = ((*nInd1<nEff1) && (nEff1==2))? 1: 0;
+	rSkip2 = ((*nInd2<nEff2) && (nEff2==2))? 1: 0;
+	rSkip = rSkip1 + rSkip2;
+	// rSkip > 0 implies that the sum of rBur will be zero.
+	dSkip = ((*nInd1<nEff1) || (*nInd2<nEff2))? 1: 0;
+	// dSkip > 0 implies that the sum of dBur will be zero;
+	// rSkip > 0 implies that dSkip > 0.
+	// Thus, if rSkip > 0, sum of dBur and sum of rBur will be zero,
+	// no need to keep track their sums for their averages dBurMean, rMean
+
+	frac = 1.0/(*nSamp - 1); // *nSamp > 1 is known
+	frac2 = frac/2.0;
+
+	dBurMean = 0;
+	rMean = 0;
+	if (rSkip == 2) {    // each locus has 2 alleles, none is dropped
+		m1 = *mValp1;
+		f1 = *freqp1;
+		varp1 =  f1 * (float) (1.0 - 2*f1) + (*homop1);
+		m2 = *mValp2;
+		f2 = *freqp2;
+		float t =  f2 * (float) (1.0 - 2*f2) + (*homop2);
+		if ((varp1 < epsilon) || (t < epsilon)) { // => varp1 = 0 or t = 0
+			dBur = 0;   // varp1 = 0 or t = 0: heterozygote throughout with
+			rBur = 0;   // m1 at loc p1, or with m2 at loc p2
+			rBur2 = 0;
+// for jackknife on samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+        // for any sample removed, same thing applies to the remaining:
+        // r^2 = 0 for each sample set with one removed,
+        // only the number of r^2 evaluated is increased
+			if (BC_JACK) {
+				for (k = 0; k< nfish; k++) {
+					r2Count[k]++;
+					r2AtPairX[k] = 0;
+					JweighPair[k] = 1;
+				}
+			}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+		} else {    // in this case, we have *nSamp >= 2 (otherwise, only one
+    // sample having data at 2 loci, implying it is heterozygote (varp1=t=0)
+			AlleInSamp (nfish, m1, p1Gen, noDatFish, countm1);
+			AlleInSamp (nfish, m2, p2Gen, noDatFish, countm2);
+			Burrows_Delta (f1, f2, varp1, t, *nSamp, nfish,
+				 &dBur, &rBur, &rBur2, &pSum, countm1, countm2);
+	// The rest of this "else" are for jackknife on Samples
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+			if (BC_JACK) {
+				for (k = 0; k < nfish; k++) {
+        // for each sample (k+1) removed, let's call the rest as Sk
+        // This loop calculates r^2 at each sample set Sk
+					if (BC_MISS && noDatFish[k] > 0) {		// sample (k+1)th has no data
+						r2AtPairX[k] = rBur2;	// same r^2 when removing it
+// temporarily add for checking with checkR2:
+//r2JackTot[k] += rBur2;
+						r2Count[k]++;
+						JweighPair[k] = 1;
+					} else {
+						reject = Rejected(cutoff, *nSamp,f1,countm1[k], &f1x)
+							+ Rejected (cutoff, *nSamp,f2, countm2[k], &f2x);
+				// if reject = 0: both alleles are accepted
+						if (reject == 0) {
+							rSet = r2Default (*nSamp, frac, f1x, *homop1,
+									countm1[k], f2x, *homop2, countm2[k],
+									&var1, &var2, epsilon);
+				// rSet = 0 when var1 or var2 = 0, then r^2 = 0 on Sk
+							if (rSet != 0) {
+								dBurx = pSum - countm1[k]*countm2[k];
+								dBurx *= frac2;
+								dBurx -= (2*f1x*f2x);   // Burrows for Sk
+								if (*nSamp > 2.5)   // i.e., is at least 3
+						// adjust Burrows disequilibrium by a factor
+								dBurx = dBurx *((*nSamp-1)/(*nSamp-2));
+								rBur2x = (dBurx*dBurx)/(var1*var2);
+								if (rBur2x > 1.0) rBur2x = 1.0; // pull back!
+								r2AtPairX[k] = rBur2x;
+// temporarily add for checking with checkR2:
+//r2JackTot [k] += rBur2x;    // r^2 for Sk
+// Oct 2026: r^2 = 0 on Sk (a variance 0, as in the case of more alleles
+// below), it was the value left from the previous locus pair, so that the
+// jackknife CIs depended on the order of loci (see tests/ldjack)
+							} else r2AtPairX[k] = 0;
+							r2Count[k]++;
+							JweighPair[k] = 1;
+						} else {	// this pair of loci is rejected in Sk
+							JweighPair[k] = 0;
+							r2AtPairX[k] = 0;
+						} // end of "if (reject == 0) ... else"
+				// if reject != 0, no r^2 on Sk, r2Count[k] not increased
+					}   // end of "if (BC_MISS && noDatFish[k] > 0) ... else ..."
+				}   // end of "for (k = 0; k< nfish; k++)"
+			}   // end of "if (BC_JACK)"
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+		}   // end of "if ((varp1 < epsilon) || (t < epsilon)) ... else ..."
+		*rB = rBur2;
+// write to auxiliary file here
+		if (BC_OUT && writeBur == 1) {
+// This next line is for testing purpose only, comment out later
+//fprintf (outBurr, "Short cut\n");
+			if (BurAlePair == 1)
+			{
+				for(i = 0; i < 2; i++) {
+					if (i == 1) {   // Note: at i = 1, the loop j just ends
+				// with i = 0, j = 1. The dBur, rBur change signs by the
+				// code in next loop, which are then the values at allele
+				// pair corresponding to i = 1,j = 0 (starting next loop)
+						m1 = *(mValp1+1); m2 = *mValp2;
+						f1 = *(freqp1+1); f2 = *freqp2;
+					}
+					for (j = 0; j < 2; j++) {
+						if (j == 1) {
+							m2 = *(mValp2+1); f2 = *(freqp2+1);
+							dBur = -dBur; rBur = -rBur;
+						}
+						if (sepBurOut == 0) fprintf (outBurr,
+							"%9d%8d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
+							currPop, p1+1, p2+1, m1, m2, f1, f2, dBur,
+							rBur, rBur2);
+						else fprintf (outBurr,
+							"%3d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
+							p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
+					}
+				}
+				if (sepBurOut == 0) {
+					fprintf (outBurr, "   ");
+        			PrtLines (outBurr, 85, '-');
+					fprintf (outBurr, "   Number of Allele Pairs:%8d,      "
+							"Means:  %15.3e%12.3e%12.3e\n",
+							*nMpairs, dBurMean, rMean, *rB);
+// added, but can be removed (Aug 2016) ----------------------------------
+					float w1 = 1.0;
+					float w2 = (*nSamp)*(*nSamp);
+					if (weighsmp > 0)
+						fprintf (outBurr, "%49cIndp. = (1, 1), Size =%5.0f,"
+									" Wt:%7.0f\n", ' ', *nSamp, w1*w2);
+					else
+						fprintf (outBurr, "%78cWt:%7.0f\n", ' ', w1);
+// -----------------------------------------------------------------------
+				}
+			} else {
+				if (moreCol == 0)
+					fprintf (outBurr, "%6d %6d %7.4f %7.4f %8d %14.5e %14.5e\n",
+							p1+1, p2+1, fminp1, fminp2, (int) *nSamp, *rB,
+							(*rB)-(*expR2));
+				else fprintf (outBurr,  "%6d %6d %7.4f %7.4f %5d%5d "
+							"%7d%7d %13.4e %13.4e %13.4e %13.4e\n",
+							p1+1, p2+1, fminp1, fminp2, *nInd1, *nInd2,
+							*nMpairs, (int) *nSamp, dBurMean, rMean,
+							*rB, (*rB)-(*expR2));
+			}
+		} // end of "if (writeBur == 1)"
+		return;
+	}
+
+// Added in Jan 2016:
+//	float *y = (float*) malloc(sizeof(float)*nEff2); // changed y to array
+	float *varp2 = (float*) malloc(sizeof(float)*nEff2);
+	float *colSum = (float*) malloc(sizeof(float)* nEff2);
+	float *rRow = (float*) malloc(sizeof(float)*nEff2);
+	float *r2Row = (float*) malloc(sizeof(float)*nEff2);
+
+// for jackknife on Samples
+// In the comments, we use the symbol S for the whole set of samples,
+// Sk for the sample set S with one sample removed (assuming sample (k+1)th)
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+	int c;
+	float *f1xAt = NULL, *f2xAt = NULL;
+// to keep track of r^2 at all Sk, for a pair of alleles
+	float *r2xAt = NULL;
+// to count number of eligible alleles at each Sk
+	int *m1Acc = NULL, *m2Acc = NULL;
+// to determine if current allele pairs are rejected at Sk
+	char *m1Rej = NULL, *m2Rej = NULL;
+	char gotr2x;
+// for the sum of frequencies of eligible alleles at Sk
+	float *f1xSum = NULL, *f2xSum = NULL;
+
+// Oct 2026: allocated only in variants with jackknife (BC_JACK = 1)
+	if (BC_JACK) {
+		f1xAt = (float*) malloc(sizeof(float)*nfish);
+		f2xAt = (float*) malloc(sizeof(float)*nfish);
+		r2xAt = (float*) malloc(sizeof(float)*nfish);
+		m1Acc = (int*) malloc(sizeof(int)*nfish);
+		m2Acc = (int*) malloc(sizeof(int)*nfish);
+		m1Rej = (char*) malloc(sizeof(char)*nfish);
+		m2Rej = (char*) malloc(sizeof(char)*nfish);
+		f1xSum = (float*) malloc(sizeof(float)*nfish);
+		f2xSum = (float*) malloc(sizeof(float)*nfish);
+		for (k = 0; k < nfish; k++) {
+			f1xAt[k] = 0;
+			f2xAt[k] = 0;
+			r2xAt[k] = 0;
+			m1Acc[k] = 0;
+			m2Acc[k] = 0;
+			m1Rej[k] = 0;
+			m2Rej[k] = 0;
+			f1xSum[k] = 0;
+			f2xSum[k] = 0;
+			r2AtPairX[k] = 0;
+		}
+	}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+	for (j = 0; j < nEff2; j++) {
+		f2 = *(freqp2+j);   // frequency of allele (j+1)th at locus p2.
+		varp2[j] = f2 * (float) (1.0 - 2*f2) + *(homop2+j); // for variance
+                        // related to allele (j+1)th at locus p2
+		colSum[j] = 0;              // related to allele (j+1)th at locus p2
+		rRow[j] = 0;    // colSum, rRow, r2Row for holding values calculated
+		r2Row[j] = 0;
+// for jackknife on Samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+// Determine m2Acc[k] = number of alleles at locus p2 that are accepted at Sk
+		if (BC_JACK) {
+			if (varp2[j] < epsilon) {   // locus p2 is het. with allele (j+1)th,
+	// so allele (j+1)th is eligible at locus p2 (freq = 0.5) in all Sk.
+				for (k = 0; k < nfish; k++) m2Acc[k]++;
+			} else {
+				m2 = *(mValp2+j);   // m2 is allele (j+1)th
+				for (k = 0; k < nfish; k++) {
+					if (BC_MISS && noDatFish[k] > 0) m2Acc[k]++;
+					else {
+						c = Count(p2Gen[k], m2);
+						if (Rejected(cutoff, *nSamp, f2, c, (f2xAt+k)) == 0) {
+							m2Acc[k]++;
+							f2xSum[k] += f2xAt[k];
+						}
+					}
+				}
+			}
+		}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+	}
+
+// In the next loop, for each i, rRow[.] is a vector of rBur-values corresp.
+// to i, at various j (in loop of j). It contains rBur(i,j) for various j.
+// The values in this array are only needed for storing at i = 0 in the case
+// 1 = nInd1 < nEff1 = 2.  When going to the next i = 1 in the loop, those
+// values in rRow (stored rBur values at i = 0 for various j) are reused.
+// In such case, then for each j, rBur(1,j) = -rBur(0,j). Thus, at each j,
+// just set rBur(1,j) = -rRow[j].
+// Simlarly for r2Row (storing values of rBur2).
+
+// colSum[j] stores the sum of dBur-values at column j, up to row i = nInd1-1.
+// This will be used at row i = nInd1, which can only happen if nInd1 < nEff1.
+// When this happens (at i = nInd1), the dBur at this i, for any column j,
+// is the negative of the sum of all previous dBur values under the same j.
+// That sum was stored as colSum[j].
+//
+// On the other hand, rowSum is the sum of dBur at row i, up to j = (nInd2-1).
+// This will be used at each i, and only at j = nInd2 (this can only happen
+// if nInd2 < nEff2). The value of dBur at (i, nInd2) is negative of the sum
+// of all dBur at the same i, of all j < nInd2. That sum is rowSum.
+	for (i = 0; i < nEff1; i++) {
+		m1 = *(mValp1+i);
+		f1 = *(freqp1+i);       // frequency of allele m1 at locus p1.
+		varp1 =  f1 * (float) (1.0 - 2*f1) + *(homop1+i);   // represent variance
+                                                // related to allele m1
+		if (varp1 < epsilon) {  // this means variance related to m1 is zero;
+		// so, all samples are heterozygotes with one allele being m1.
+			dBur = 0; rBur = 0; rBur2 = 0;
+// write to auxiliary file here
+			if (BC_OUT && writeBur == 1 && BurAlePair == 1)
+			{
+				for (j = 0; j < nEff2; j++) {
+					m2 = *(mValp2+j);
+					f2 = *(freqp2+j);   // frequency of allele m2 at locus p2.
+					if (sepBurOut == 0) fprintf (outBurr,
+						"%9d%8d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
+						currPop, p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
+					else fprintf (outBurr,
+						"%3d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
+						p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
+				}
+			}
+        // The next "for" loop is for jackknife on Samples.
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+        // The same thing will happen when a sample is removed (whether
+        // that sample has data at both loci or not): all samples in Sk
+        // are heterozygotes with one allele being m1 (allele m1 in Sk
+        // has freq 1/2); so r^2 = 0 for each Sk when m1 is paired
+        // with any eligible allele at locus p2).
+
+        // r2AtPairX[k] = (sum of r^2 over all allele pairs in Sk) unchanged
+			if (BC_JACK) {
+				for (k = 0; k < nfish; k++) {
+//          r2xAt[k] = 0;   // r^2 set = 0 for any pairing with m1
+				// this allele m1 is eligible in all Sk:
+					m1Rej[k] = 0;
+					m1Acc[k]++;
+				}
+			}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+
+
+		} else {    // of "(varp1 < epsilon)" => varp1 (related to m1) > 0.
+		// obtain countm1[k] = number of copies of allele m1 at each sample k
+			AlleInSamp (nfish, m1, p1Gen, noDatFish, countm1);
+// for jackknite on Sample
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+// must check if this allele m1 is existed and accepted in each Sk
+			if (BC_JACK) {
+				for (k = 0; k < nfish; k++) {
+					if (BC_MISS && noDatFish[k] > 0) {
+						m1Rej[k] = 0;
+						m1Acc[k]++;
+					} else {
+						m1Rej[k] = Rejected(cutoff, *nSamp, f1, countm1[k],
+										(f1xAt+k));
+						if (m1Rej[k] == 0) {
+							m1Acc[k]++;
+							f1xSum[k] += f1xAt[k];
+						}
+					}
+				}
+			}
+// As i goes through the "for" loop, m1Acc[k] is the total number of eligible
+// alleles in the sample set Sk (sample set after a sample k is deleted).
+// The number of alleles accepted in Sk was found before this "for" loop.
+// Therefore, the number of pairs accepted in Sk is m1Acc[k] * m2Acc[k]
+// after this "for i = " loop is through.
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+			rowSum = 0;
+			for (j = 0; j < nEff2; j++) {
+				m2 = *(mValp2+j);
+				f2 = *(freqp2+j);   // frequency of allele m2 at locus p2.
+				gotr2x = 0;
+				if (varp2[j] < epsilon) {   // varp2[j] = 0, variance at m2
+			// all samples are heterozygotes at locus p2 with one allele = m2
+					dBur = 0; rBur = 0; rBur2 = 0;
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+				// for jackknife on samples:
+				// For all k, r^2 at Sk = 0,  r2AtPairX[k] is unchanged
+				// This allele m2 is accepted in all Sk
+					if (BC_JACK) {
+						for (k = 0; k < nfish; k++) m2Rej[k] = 0;
+					}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+
+				} else {    // both varp1 and varp2[j] > 0 (rel. to m1, m2)
+		// obtain countm2[k] = number of copies of allele m2 at each sample k
+					AlleInSamp (nfish, m2, p2Gen, noDatFish, countm2);
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+				// jackknife on samples: check eligibility of m2 in each Sk
+					if (BC_JACK) {
+						for (k = 0; k < nfish; k++) {
+							if (BC_MISS && noDatFish[k] > 0) m2Rej[k] = 0;
+							else m2Rej[k] = Rejected(cutoff, *nSamp, f2,
+											countm2[k], (f2xAt+k));
+						}
+					}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+
+// Always have nInd1 <= nEff1. Then nInd1 < nEff1 <=> no allele dropped at
+// locus p1. The next "if" statement is to deal with this case.
+// First, dBur for the last i (which is nInd1), at any j, will be the negative
+// of the sum of all dBur at previous i (of the same j), which is colSum[j].
+// Moreover, if also nEff1 = 2 (or nInd1 = 1), then rBur at i = nInd1 = 1 and
+// at any j will be the negative of rBur at i = 0 and the same j (= rRow[j])
+					if (i == *nInd1) {  // only if *nInd1<nEff1, i=nEff1-1
+						dBur = - colSum[j];
+						if (nEff1 == 2) {
+							rBur = - rRow[j];
+							rBur2 = r2Row[j];
+						} else {
+							xy = varp1 * varp2[j];  // this must be > 0
+							rBur = dBur/sqrt(xy);
+							rBur2 = rBur * rBur;
+							if (rBur2 > 1.0) rBur2 = 1.0;
+						}
+// for Jackknife on samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+// At allele m1 of locus p1, we know if m1 is rejected or eligible under Sk
+// for each sample (k+1)th removed, from the value m1Rej[k] evaluated earlier
+// at the start of "else" of "if (varp1 < epsilon)". When m2 is not rejected
+// under Sk, r^2 will be calculated.
+// When allele pair (m1, m2) is eligible under Sk, and i = *nInd1 = 1, then
+// the previous m1 (corresponding to i=0) is also eligible at locus p1,
+// we actually have r^2 at this pair (m1, m2) being the same as r^2 at
+// (prev m1, m2). However, to be able to use this previous r^2-value, we will
+// need to store it in a 2-dimensional array (one for m2, the other for k,
+// to store r^2 with the first allele being fixed).
+// Without such array, we will need to calculate r^2 for each Sk
+// (when "nEff1 == 2"), based on the Burrows disequilibrium dBur for the
+// whole sample set S, instead of grabbing previous values in each Sk.
+// So, we will need to use the following value as in the case "else" above:
+						if (BC_JACK) {
+							if (j == *nInd2 && j == 1) {
+								gotr2x = 1;
+								for (k = 0; k < nfish; k++) {
+// Note: In this "j=1" case, when allele m1, m2 are eligible in Sk, then
+// allele m1 ane previous m2 (corresponding to j = 0) will also eligible
+// in Sk, so r2xAt[k] is the available r2-value for previous pair
+									if (m1Rej[k] == 0 && m2Rej[k] == 0) {
+										r2AtPairX[k] += r2xAt[k];
+									}
+								}
+							} else //  of "(j == *nInd2 && j == 1)"
+								pSum = roundf((dBur + 2*f1*f2)*2*(*nSamp));
+						}	// end of "if (BC_JACK)"
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+					} else {    // of "if (i == *nInd1)", i.e., i < *nInd1.
+					// If *nInd1 = nEff1, then case "else" always happens.
+						if (j == *nInd2) {  // can happen if nInd2 < nEff2
+							dBur = - rowSum;
+							if (j == 1) {
+								rBur = -rBur; // prev. rBur is for (i, 0)
+// for Jackknife on samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+// At each k, either the allele pair corresponding to (i, j=1) is rejected
+// or r^2 at this allele pair is the same as for previous pair (i, j=0).
+// If pair at (i, j=1) is eligible, then so is pair at (i, j=0).
+								if (BC_JACK) {
+									gotr2x = 1;
+									for (k = 0; k < nfish; k++) {
+// Note: In this "j=1" case, when allele m1, m2 are eligible in Sk, then
+// allele m1 ane previous m2 (corresponding to j = 0) will also eligible
+// in Sk, so r2xAt[k] is the available r2-value for previous pair
+										if (m1Rej[k] == 0 && m2Rej[k] == 0) {
+											r2AtPairX[k] += r2xAt[k];
+										}
+									}
+								}
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+							} else { // j = nInd2 > 1: need to find rBur
+								xy = varp1 * varp2[j];
+								rBur = dBur/sqrt(xy);
+								rBur2 = rBur * rBur;
+								if (rBur2 > 1.0) rBur2 = 1.0;
+// for Jackknife on samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+								pSum = roundf((dBur + 2*f1*f2)*2*(*nSamp));
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+							}
+						} else {	// of "if (j == *nInd2)"
+        // Burrows coeff. need to be calculated at pair (i, j), for any j.
+        // (countm1, countm2 were determined)
+							Burrows_Delta (f1, f2, varp1, varp2[j], *nSamp, nfish,
+								&dBur, &rBur, &rBur2, &pSum, countm1, countm2);
+							rowSum += dBur; // sum of dBur across j, for this i
+						}
+						colSum[j] += dBur;  // colSum[j] is sum of entries of
+                                // dBur-matrix at column j, up to row i
+						rRow[j] = rBur; // rRow, r2Row are reassigned at each i;
+						r2Row[j] = rBur2;// only values for the last i are kept!
+					}   // end of "if (i == *nInd1) ... else ..."
+// for Jackknife on samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+// After the condition set for i (= nInd1 or not), except for the case
+// j = *nInd2 = 1 where r^2 in each Sk takes previous r^2-value (at j=0),
+// the rest (unconditional on i, and for j not in the case mentioned) need
+// value pSum. This pSum was assigned in case i = *nInd1. In case i /= *nInd1,
+// it was set at j = *nInd2 /= 1 through assignment, and at j /= *nInd2
+// through the call Burrows_Delta.
+// The exceptional case, where r^2 in each Sk takes previous r^2-value,
+// is signaled by gotr2x = 1 (otherwise, it is still 0).
+					if (BC_JACK) {
+						if (gotr2x == 0) {
+// From Burrows disequilibrium at (m1, m2) under whole sample set S, which is
+// dBur = pSum - 2(f1*f2), we can derive Burrows disequilibrium at (m1,m2)
+// under sample set Sk. The calculations are based on "pSum". This pSum is
+// obtained through the call Burrows_Delta where dBur was calculated, or
+// straight from dBur if dBur was deduced from previous values.
+							for (k = 0; k < nfish; k++) {
+								if (m1Rej[k] == 0 && m2Rej[k] == 0) {
+                    // rBur2x will be r^2 for Sk
+									if (BC_MISS && noDatFish[k] > 0) { // missing data at k
+										r2xAt[k] = rBur2;
+										r2AtPairX [k] += r2xAt[k];
+									} else {
+										rSet = r2Default (*nSamp, frac, f1xAt[k],
+											*(homop1+i), countm1[k], f2xAt[k],
+											*(homop2+j), countm2[k],
+											&var1, &var2, epsilon);
+										if (rSet != 0) {
+											pSumx = pSum - countm1[k]*countm2[k];
+											dBurx = frac2*pSumx -
+													2*f1xAt[k]*f2xAt[k];
+											if (*nSamp > 2.5) // i.e. at least 3
+							// adjust Burrows disequilib. by unbiased factor
+												dBurx *= (*nSamp-1)/(*nSamp-2);
+											r2xAt[k] = (dBurx*dBurx)/(var1*var2);
+											if (r2xAt[k] > 1.0) r2xAt[k] = 1.0;
+											r2AtPairX [k] += r2xAt[k];   // r^2 for Sk
+										} else {    // if rset=0, r^2 = 0
+											r2xAt[k] = 0;
+										}
+									}
+
+								}   // end of "if (m1Rej[k]==0 && m2Rej[k]==0)"
+							}   // end of "for (k = 0; k < nfish; k++)"
+						}   // end of "if (gotr2x == 0)"
+
+					}   // end of "if (BC_JACK)"
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+				}   // end of "if (varp2[j] < epsilon) ...  else ..."
+				r2Mean += rBur2;
+				if (BC_OUT && rSkip == 0) rMean += rBur;  // rMean = 0 if rSkip > 0
+				if (BC_OUT && dSkip == 0) dBurMean += dBur;
+// write to auxiliary file here
+				if (BC_OUT && writeBur == 1 && BurAlePair == 1)
+				{
+					if (sepBurOut == 0) fprintf (outBurr,
+							"%9d%8d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
+						currPop, p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
+					else fprintf (outBurr,
+							"%3d%6d%8d%6d  %7.3f%7.3f%11.6f%12.6f%12.6f\n",
+							p1+1, p2+1, m1, m2, f1, f2, dBur, rBur, rBur2);
+				}
+			}   // end of "for (j = 0; j < nEff2; j++)"
+		// This is the end of "else": varp1 is not 0; so r2, dBur can be
+		// nonzero when j runs in the "for" loop
+		}   // end of "if (varp1 < epsilon) ... else ..."
+	}    // end of "for (i = 0; i < nEff1; i++)"
+
+// for Jackknife on Samples:
+// sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj ----- sj -----
+	if (BC_JACK) { // wrap up information on Sk
+		x = 1.0 - epsilon;  // basically, if y <= 1 and y > x, then y = 1.
+		for (k = 0; k < nfish; k++) {
+			i = m1Acc[k] * m2Acc[k];
+			if (i > 0) {
+				r2AtPairX[k] /= i;   // mean of r^2 over all elig. alle pairs
+// temporarily add for checking with checkR2:
+// r2JackTot[k] += r2AtPairX[k];
+				r2Count[k]++;
+			}
+		// now for product of ind. alleles at each Sk:
+			if (BC_MISS && noDatFish[k] > 0) JweighPair[k] = (*nInd1)*(*nInd2);
+			else {
+				m1 = m1Acc[k];  // number of eligible alleles at locus p1
+				m2 = m2Acc[k];  // number of eligible alleles at locus p2
+			// if Sum(eligible alleles) = 1, #(ind. alleles) is one less
+				if (f1xSum[k] > x) m1--;
+				if (f2xSum[k] > x) m2--;
+				JweighPair[k] = m1*m2;
+			}
+		}
+	}
+// Now, r2AtPairX[k] is the average of r^2 taken over all allele pairs for
+// sample set Sk at locus pair (p1, p2); so it represents r^2 at this pair.
+// ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej ----- ej -----
+	*rB = r2Mean/(*nMpairs); // Burrows coeff. averaging over all allele
+                            // pairs for this locus pair (p1, p2).
+	rMean = rMean/(*nMpairs);
+	dBurMean = dBurMean/(*nMpairs);
+	// write to auxiliary file here (added BurrPause in Sept 2011):
+	if (BC_OUT && writeBur == 1)
+	{
+		if (BurAlePair == 1) {
+			if (sepBurOut == 0) {
+				fprintf (outBurr, "   ");
+				for (j=0; j<85; j++) fprintf (outBurr, "-");
+				fprintf (outBurr, "\n");
+				fprintf (outBurr, "   Number of Allele Pairs:%8d,"
+						"      Means:  %15.3e%12.3e%12.3e\n",
+						*nMpairs, dBurMean, rMean, *rB);
+// added, but can be removed (Aug 2016) ----------------------------------
+				float w1 = (*nInd1)*(*nInd2);
+				float w2 = (*nSamp)*(*nSamp);
+				if (weighsmp > 0)
+					fprintf (outBurr, "%47cIndp. = (%2d, %2d), Size =%5.0f,"
+							" Wt:%7.0f\n", ' ', *nInd1, *nInd2, *nSamp, w1*w2);
+				else
+					fprintf (outBurr, "%78cWt:%7.0f\n", ' ', w1);
+// -----------------------------------------------------------------------
+			}
+		} else {
+			if (moreCol == 0)
+				fprintf (outBurr, "%6d%7d%8.4f%8.4f %8d %14.5e %14.5e\n",
+				p1+1, p2+1, fminp1, fminp2, (int) *nSamp, *rB, (*rB)-(*expR2));
+			else fprintf (outBurr,
+				"%6d%7d%8.4f%8.4f%6d%5d%8d%7d%14.4e%14.4e%14.4e%14.4e\n",
+				p1+1, p2+1, fminp1, fminp2, *nInd1, *nInd2, *nMpairs,
+				(int) *nSamp, dBurMean, rMean, *rB, (*rB)-(*expR2));
+		}
+	};
+
+	free (colSum);
+	free (varp2);
+	free (rRow);
+	free (r2Row);
+// for jackknife:
+	free (f1xAt);
+	free (f2xAt);
+	free (r2xAt);
+	free (m1Acc);
+	free (m2Acc);
+	free (m1Rej);
+	free (m2Rej);
+	free (f1xSum);
+	free (f2xSum);
+}
+
+#undef BC_NAME
+#undef BC_JACK
+#undef BC_MISS
+#undef BC_OUT
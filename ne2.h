@@ -0,0 +1,54 @@
+// ne2.h
+// Oct 2026: interface of library libne2 ("make lib"), which is Ne2x.c
+// compiled with NE2LIB defined, so without main. Genotypes of populations
+// in memory are estimated by Ne2Estimate, with no files, and results come
+// back as records struct result, as those written by argument "d:".
+
+#ifndef NE2_H
+#define NE2_H
+
+#define NE2POPID	48		// chars kept for population names in results
+
+// a result of one method at one critical value for a population
+struct result
+{
+	int icount, popRead;
+	char popID[NE2POPID];
+	int samp;				// -1 if not for the method
+	char *method;			// "LD", "Het", "Coan", "Temporal-Pollak",
+							// "Temporal-NeiTajima", "Temporal-JordeRyman"
+	float cutoff;			// lowest allele frequency used
+	float estimate;
+	float paraLo, paraHi, jackLo, jackHi;	// CIs, NAN if not done
+	float hMean, r2, expR2;	// NAN if not for the method
+	double indAlle;			// -1 if not for the method
+	long jackDF;			// -1 if not for the method
+};
+
+// options of Ne2Estimate
+struct ne2opt
+{
+	char mLD, mHet, mNomura, mTemporal;	// 1 to run the method
+	int nCrit;				// number of critical values, up to 10
+	float *critVal;			// lowest allele frequencies, less than 0.5,
+							// decreasing, 0 for no restriction
+	char param, jacknife;	// 1 for parametric, jackknife CIs
+	char mating;			// LD method: 0 random mating, 1 monogamy
+	char tempk, tempc, temps;	// temporal methods to run (1): Pollak,
+							// Nei/Tajima, Jorde/Ryman
+	int census;				// temporal: census size for Plan I, 0 for Plan II
+	float *timeline;		// temporal: generation of each population
+};
+
+// Estimate nPop populations, population k has samp[k] individuals. Their
+// genotypes are in geno, population after population, an individual as
+// 2*nloci positive allele values (locus 1, then locus 2, ...), 0 if
+// missing. popID[k] is the name of population k (popID can be NULL).
+// For temporal method, populations are samples at generations timeline[k].
+// Up to maxRes results are put in res; return the number of results (more
+// than maxRes if res is too short), -1 if out of memory, -2 if options or
+// data are not valid.
+int Ne2Estimate (struct ne2opt *opt, int nloci, int nPop, int *samp,
+				int *geno, char **popID, struct result *res, int maxRes);
+
+#endif